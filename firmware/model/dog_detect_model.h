@@ -13,7 +13,9 @@
  *    tflite_model = converter.convert()
  * 3. Convert to C header using xxd:
  *    xxd -i dog_detect.tflite > dog_detect_model.h
- * 4. Replace the array below with the generated byte array
+ * 4. Replace the array below with the generated byte array, keeping the
+ *    dog_detect_model name; the next build registers only its ops
+ *    (scripts/gen_op_resolver.py)
  *
  * Recommended model specs for ESP32-CAM:
  * - Input: 96x96x3 uint8
@@ -0,0 +1,212 @@
+"""
+PlatformIO pre-build script: generates the TFLite op resolver for the model.
+
+Reads the flatbuffer bytes out of model/dog_detect_model.h, collects the
+builtin operators it uses and writes model_op_resolver.h into the build
+directory with a MicroMutableOpResolver that registers only those kernels,
+so the linker drops the rest. A model that can't be parsed (the checked-in
+placeholder, say) or set `custom_tflite_resolver = all` falls back to
+AllOpsResolver.
+
+After each build the app image size is recorded per resolver, and once both
+have been built the difference is printed.
+"""
+
+import json
+import os
+import re
+import struct
+
+Import("env")  # noqa: F821
+
+MODEL_HEADER = os.path.join(env.subst("$PROJECT_DIR"), "model", "dog_detect_model.h")
+GEN_DIR = os.path.join(env.subst("$BUILD_DIR"), "generated")
+GEN_HEADER = os.path.join(GEN_DIR, "model_op_resolver.h")
+SIZES_FILE = os.path.join(env.subst("$BUILD_DIR"), "tflite_resolver_sizes.json")
+
+# tflite::BuiltinOperator value -> schema name and MicroMutableOpResolver
+# method. Only operators with TFLite Micro kernels are listed.
+BUILTIN_OPS = {
+    0: ("ADD", "AddAdd"),
+    1: ("AVERAGE_POOL_2D", "AddAveragePool2D"),
+    2: ("CONCATENATION", "AddConcatenation"),
+    3: ("CONV_2D", "AddConv2D"),
+    4: ("DEPTHWISE_CONV_2D", "AddDepthwiseConv2D"),
+    6: ("DEQUANTIZE", "AddDequantize"),
+    8: ("FLOOR", "AddFloor"),
+    9: ("FULLY_CONNECTED", "AddFullyConnected"),
+    11: ("L2_NORMALIZATION", "AddL2Normalization"),
+    14: ("LOGISTIC", "AddLogistic"),
+    17: ("MAX_POOL_2D", "AddMaxPool2D"),
+    18: ("MUL", "AddMul"),
+    19: ("RELU", "AddRelu"),
+    21: ("RELU6", "AddRelu6"),
+    22: ("RESHAPE", "AddReshape"),
+    25: ("SOFTMAX", "AddSoftmax"),
+    28: ("TANH", "AddTanh"),
+    34: ("PAD", "AddPad"),
+    40: ("MEAN", "AddMean"),
+    41: ("SUB", "AddSub"),
+    43: ("SQUEEZE", "AddSqueeze"),
+    45: ("STRIDED_SLICE", "AddStridedSlice"),
+    54: ("PRELU", "AddPrelu"),
+    55: ("MAXIMUM", "AddMaximum"),
+    56: ("ARG_MAX", "AddArgMax"),
+    57: ("MINIMUM", "AddMinimum"),
+    60: ("PADV2", "AddPadV2"),
+    79: ("ARG_MIN", "AddArgMin"),
+    83: ("PACK", "AddPack"),
+    88: ("UNPACK", "AddUnpack"),
+    97: ("RESIZE_NEAREST_NEIGHBOR", "AddResizeNearestNeighbor"),
+    114: ("QUANTIZE", "AddQuantize"),
+    117: ("HARD_SWISH", "AddHardSwish"),
+}
+BUILTIN_CUSTOM = 32
+
+
+def read_model_bytes(path):
+    with open(path) as f:
+        text = f.read()
+    match = re.search(r"dog_detect_model\[\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not match:
+        raise ValueError("no dog_detect_model[] array")
+    body = re.sub(r"//[^\n]*|/\*.*?\*/", "", match.group(1), flags=re.S)
+    return bytes(int(tok, 0) for tok in re.findall(r"0[xX][0-9a-fA-F]+|\d+", body))
+
+
+class Table:
+    """Just enough of a flatbuffer table reader for Model.operator_codes."""
+
+    def __init__(self, buf, pos):
+        self.buf = buf
+        self.pos = pos
+        vtable = pos - self._i32(pos)
+        self.vtable = vtable
+        self.vtable_len = self._u16(vtable)
+
+    def _u16(self, at):
+        return struct.unpack_from("<H", self.buf, at)[0]
+
+    def _i32(self, at):
+        return struct.unpack_from("<i", self.buf, at)[0]
+
+    def _field(self, index):
+        entry = 4 + 2 * index
+        if entry >= self.vtable_len:
+            return None
+        offset = self._u16(self.vtable + entry)
+        return self.pos + offset if offset else None
+
+    def scalar(self, index, fmt, default=0):
+        at = self._field(index)
+        return struct.unpack_from("<" + fmt, self.buf, at)[0] if at is not None else default
+
+    def tables(self, index):
+        at = self._field(index)
+        if at is None:
+            return []
+        vec = at + struct.unpack_from("<I", self.buf, at)[0]
+        count = struct.unpack_from("<I", self.buf, vec)[0]
+        items = []
+        for i in range(count):
+            elem = vec + 4 + 4 * i
+            items.append(Table(self.buf, elem + struct.unpack_from("<I", self.buf, elem)[0]))
+        return items
+
+
+def model_builtin_codes(buf):
+    if len(buf) < 8 or buf[4:8] != b"TFL3":
+        raise ValueError("not a TFLite flatbuffer")
+    model = Table(buf, struct.unpack_from("<I", buf, 0)[0])
+    codes = set()
+    # OperatorCode: deprecated_builtin_code (int8) is field 0, builtin_code
+    # (int32, schema 3a and later) field 3; the larger of the two is the op
+    for op in model.tables(1):
+        codes.add(max(op.scalar(0, "b"), op.scalar(3, "i")))
+    return codes
+
+
+def resolver_header(codes):
+    lines = [
+        "// Generated by scripts/gen_op_resolver.py from model/dog_detect_model.h.",
+        "// Do not edit; rebuild to regenerate.",
+        "#pragma once",
+        "",
+    ]
+    if codes is None:
+        lines += [
+            '#include "tensorflow/lite/micro/all_ops_resolver.h"',
+            "",
+            "#define MODEL_OP_COUNT 0  // all kernels",
+            "typedef tflite::AllOpsResolver ModelOpResolver;",
+            "",
+            "inline bool model_op_resolver_init(ModelOpResolver*) { return true; }",
+        ]
+        return "\n".join(lines) + "\n"
+
+    ops = [BUILTIN_OPS[c] for c in sorted(codes)]
+    lines += [
+        '#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"',
+        "",
+        "#define MODEL_OP_COUNT %d  // %s" % (len(ops), ", ".join(name for name, _ in ops)),
+        "typedef tflite::MicroMutableOpResolver<%d> ModelOpResolver;" % max(len(ops), 1),
+        "",
+        "inline bool model_op_resolver_init(ModelOpResolver* resolver) {",
+    ]
+    lines += ["    if (resolver->%s() != kTfLiteOk) return false;" % method for _, method in ops]
+    lines += ["    return true;", "}"]
+    return "\n".join(lines) + "\n"
+
+
+def generate():
+    codes = None
+    if env.GetProjectOption("custom_tflite_resolver", "minimal") == "all":
+        print("[tflite] custom_tflite_resolver = all: using AllOpsResolver")
+    else:
+        try:
+            codes = model_builtin_codes(read_model_bytes(MODEL_HEADER))
+        except (ValueError, struct.error, IndexError) as e:
+            print("[tflite] WARNING: can't read the model's op list (%s); using AllOpsResolver" % e)
+        if codes is not None:
+            if BUILTIN_CUSTOM in codes:
+                env.Exit("[tflite] the model uses a custom op, which TFLite Micro can't run")
+            unknown = sorted(c for c in codes if c not in BUILTIN_OPS)
+            if unknown:
+                env.Exit("[tflite] no TFLite Micro kernel mapped for builtin op(s) %s; "
+                         "add them to BUILTIN_OPS in gen_op_resolver.py" % unknown)
+            print("[tflite] model uses %d of %d kernels: %s" % (
+                len(codes), len(BUILTIN_OPS), ", ".join(BUILTIN_OPS[c][0] for c in sorted(codes))))
+
+    text = resolver_header(codes)
+    os.makedirs(GEN_DIR, exist_ok=True)
+    # Rewrite only on change so detection.cpp isn't rebuilt every time
+    if not os.path.exists(GEN_HEADER) or open(GEN_HEADER).read() != text:
+        with open(GEN_HEADER, "w") as f:
+            f.write(text)
+    env.Append(CPPPATH=[GEN_DIR])
+    return "all" if codes is None else "minimal"
+
+
+def report_size(resolver):
+    def action(target, source, env):
+        image = str(target[0])
+        sizes = {}
+        if os.path.exists(SIZES_FILE):
+            with open(SIZES_FILE) as f:
+                sizes = json.load(f)
+        sizes[resolver] = os.path.getsize(image)
+        with open(SIZES_FILE, "w") as f:
+            json.dump(sizes, f)
+
+        line = "[tflite] app image %d bytes with the %s resolver" % (sizes[resolver], resolver)
+        if "all" in sizes and "minimal" in sizes:
+            line += "; minimal saves %d bytes over AllOpsResolver" % (sizes["all"] - sizes["minimal"])
+        else:
+            line += " (build once with custom_tflite_resolver = all to compare)"
+        print(line)
+
+    return action
+
+
+report_size_action = report_size(generate())
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.bin", report_size_action)
@@ -0,0 +1,114 @@
+#include "access_gate.h"
+
+#include <string.h>
+
+void access_gate_init(AccessGate* gate) {
+    memset(gate, 0, sizeof(*gate));
+    gate->nextId = 1;
+}
+
+static bool settled(const AccessAttempt& a) {
+    return a.opened || a.failed != 0;
+}
+
+static AccessAttempt* find(AccessGate* gate, uint32_t id) {
+    if (id == 0) return nullptr;
+    for (AccessAttempt& a : gate->attempts) {
+        if (a.id == id) return &a;
+    }
+    return nullptr;
+}
+
+static const AccessAttempt* find(const AccessGate* gate, uint32_t id) {
+    return find(const_cast<AccessGate*>(gate), id);
+}
+
+uint32_t access_gate_begin(AccessGate* gate, uint32_t triggeredAtUs, uint8_t passed) {
+    // Free slot, else the oldest settled attempt, else the oldest one
+    AccessAttempt* slot = nullptr;
+    for (AccessAttempt& a : gate->attempts) {
+        if (a.id == 0) {
+            slot = &a;
+            break;
+        }
+        if (!slot || settled(a) > settled(*slot) ||
+            (settled(a) == settled(*slot) && a.id < slot->id)) {
+            slot = &a;
+        }
+    }
+
+    uint32_t id = gate->nextId++;
+    if (gate->nextId == 0) gate->nextId = 1;
+    memset(slot, 0, sizeof(*slot));
+    slot->id = id;
+    slot->triggeredAtUs = triggeredAtUs;
+    slot->passed = passed & ACCESS_CHECKS_ALL;
+    return id;
+}
+
+GateResult access_gate_verdict(AccessGate* gate, uint32_t id, AccessCheck check, bool passed) {
+    GateResult result = {GateOutcome::Unknown, 0, 0, false};
+    AccessAttempt* a = find(gate, id);
+    if (!a) return result;
+
+    bool wasOpen = a->opened;
+    bool wasCancelled = a->failed != 0;
+    uint8_t bit = ACCESS_CHECK_BIT(check);
+    if ((a->passed | a->failed) & bit) {
+        result.repeated = true;
+    } else if (passed) {
+        a->passed |= bit;
+    } else {
+        a->failed |= bit;
+    }
+
+    result.triggeredAtUs = a->triggeredAtUs;
+    result.passed = a->passed;
+    if (wasOpen) {
+        result.outcome = GateOutcome::AlreadyOpen;
+    } else if (wasCancelled) {
+        result.outcome = GateOutcome::AlreadyCancelled;
+    } else if (a->failed) {
+        result.outcome = GateOutcome::Cancel;
+    } else if (a->passed == ACCESS_CHECKS_ALL) {
+        a->opened = true;
+        result.outcome = GateOutcome::Open;
+    } else {
+        result.outcome = GateOutcome::Pending;
+    }
+    return result;
+}
+
+GateResult access_gate_overrule(AccessGate* gate, uint32_t id, AccessCheck check) {
+    GateResult result = {GateOutcome::Unknown, 0, 0, false};
+    AccessAttempt* a = find(gate, id);
+    if (!a) return result;
+
+    bool wasCancelled = a->failed != 0;
+    uint8_t bit = ACCESS_CHECK_BIT(check);
+    a->passed &= ~bit;
+    a->failed |= bit;
+
+    result.triggeredAtUs = a->triggeredAtUs;
+    result.passed = a->passed;
+    if (a->opened) {
+        result.outcome = GateOutcome::AlreadyOpen;
+    } else {
+        result.outcome = wasCancelled ? GateOutcome::AlreadyCancelled : GateOutcome::Cancel;
+    }
+    return result;
+}
+
+CheckState access_gate_check(const AccessGate* gate, uint32_t id, AccessCheck check) {
+    const AccessAttempt* a = find(gate, id);
+    if (!a) return CheckState::Failed;
+    uint8_t bit = ACCESS_CHECK_BIT(check);
+    if (a->passed & bit) return CheckState::Passed;
+    if (a->failed & bit) return CheckState::Failed;
+    return CheckState::Pending;
+}
+
+bool access_gate_opened(const AccessGate* gate, uint32_t id) {
+    const AccessAttempt* a = find(gate, id);
+    return a && a->opened;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+// Joins the three checks an access attempt needs before the door opens:
+// the ultrasonic range, the dog detector and the access decision (API,
+// decision cache or local hash table). They may arrive in any order and
+// from different tasks; the verdict that completes the set opens the door,
+// and the first failure cancels the attempt. With speculative access the
+// request is sent on the radar edge, so the range and the detector are
+// still running when the API answers; otherwise the range has passed
+// before the attempt begins.
+//
+// Verdicts on an attempt that is already settled are still recorded (the
+// range decides whether the approach photo is logged), but only report
+// how the attempt ended.
+//
+// Portable; builds under the `native` env. Not thread-safe: callers on
+// more than one task hold their own lock.
+
+#include <stdint.h>
+
+#define ACCESS_GATE_CAPACITY 4
+
+enum class AccessCheck : uint8_t { Range, Dog, Access };
+
+#define ACCESS_CHECK_BIT(c) ((uint8_t)(1u << (uint8_t)(c)))
+#define ACCESS_CHECKS_ALL 0x07
+
+enum class GateOutcome : uint8_t {
+    Pending,           // still waiting on another check
+    Open,              // this verdict completed the set: open the door
+    Cancel,            // this verdict failed the attempt
+    AlreadyOpen,       // the door was already opened for the attempt
+    AlreadyCancelled,  // an earlier check failed
+    Unknown,           // no such attempt, or replaced by newer ones
+};
+
+enum class CheckState : uint8_t { Pending, Passed, Failed };
+
+struct GateResult {
+    GateOutcome outcome;
+    uint32_t triggeredAtUs;  // as passed to access_gate_begin()
+    uint8_t passed;          // ACCESS_CHECK_BITs passed so far
+    bool repeated;           // the check already had a verdict; this one was ignored
+};
+
+struct AccessAttempt {
+    uint32_t id;  // 0 = free slot
+    uint32_t triggeredAtUs;
+    uint8_t passed;
+    uint8_t failed;
+    bool opened;
+};
+
+struct AccessGate {
+    uint32_t nextId;
+    AccessAttempt attempts[ACCESS_GATE_CAPACITY];
+};
+
+void access_gate_init(AccessGate* gate);
+
+// Start an attempt with the checks in `passed` already done. Returns its
+// id (never 0). With every slot taken, the oldest attempt is dropped,
+// settled ones first.
+uint32_t access_gate_begin(AccessGate* gate, uint32_t triggeredAtUs, uint8_t passed);
+
+GateResult access_gate_verdict(AccessGate* gate, uint32_t id, AccessCheck check, bool passed);
+
+// Replace a check's pass with a failure, e.g. the API denying a dog the
+// local hash table let in. Cancel if the door hadn't opened yet,
+// AlreadyOpen if it had (the caller closes it again).
+GateResult access_gate_overrule(AccessGate* gate, uint32_t id, AccessCheck check);
+
+// Where one check stands; Failed for an unknown attempt.
+CheckState access_gate_check(const AccessGate* gate, uint32_t id, AccessCheck check);
+
+// True once the door was opened for the attempt.
+bool access_gate_opened(const AccessGate* gate, uint32_t id);
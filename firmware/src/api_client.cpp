@@ -2,286 +2,258 @@
 #include "config.h"
 #include "network_manager.h"
 #include "offline_queue.h"
-#include <HTTPClient.h>
-#include <WiFiClientSecure.h>
+#include "image_spool.h"
+#include "perf_stats.h"
+#include "image_hash.h"
 #include <ArduinoJson.h>
 
-static WiFiClientSecure& getSecureClient() {
-    static WiFiClientSecure client;
-    static bool initialized = false;
-    if (!initialized) {
-#if API_INSECURE_TLS
-        client.setInsecure();
-#else
-        if (strlen(API_CA_CERT) > 0) {
-            client.setCACert(API_CA_CERT);
-        } else {
-            client.setInsecure();
-        }
-#endif
-        initialized = true;
-    }
-    return client;
+// All image uploads share one multipart layout: the JPEG (streamed from the
+// frame's buffer, never copied) followed by the apiKey and side fields;
+// access requests add the payload class and thumbnail hash, and combined
+// ones the detection fields.
+static void build_image_body(MultipartBody* body, const uint8_t* jpeg, size_t len,
+                             const char* fileName, const char* side) {
+    multipart_begin(body, "image", fileName, "image/jpeg", jpeg, len);
+    multipart_add_field(body, "apiKey", API_KEY);
+    multipart_add_field(body, "side", side);
 }
 
-AccessResponse api_request_access(camera_fb_t* fb, const char* side) {
-    AccessResponse response = {false, -1, "", 0.0f, "", "", false};
-
-    if (!fb || !fb->buf || fb->len == 0) {
-        response.reason = "Invalid frame buffer";
-        return response;
-    }
-
-    // Build multipart form data
-    String boundary = "----ESP32CAMBoundary";
-    String contentType = "multipart/form-data; boundary=" + boundary;
+static void queue_event(const char* apiKey, const char* eventType, const char* notes, double batteryVoltage) {
+    QueuedEvent evt;
+    evt.eventType = eventType;
+    strlcpy(evt.notes, notes ? notes : "", sizeof(evt.notes));
+    evt.batteryVoltage = batteryVoltage;
+    evt.apiKey = apiKey;
+    evt.timestamp = millis();
+    offline_queue_push(evt);
+}
 
-    String bodyStart = "--" + boundary + "\r\n";
-    bodyStart += "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n";
-    bodyStart += "Content-Type: image/jpeg\r\n\r\n";
+static void queue_offline_detection() {
+    queue_event(API_KEY, "UnknownAnimal", "Offline during detection", -1);
+}
 
-    String apiKeyPart = "";
-    if (strlen(API_KEY) > 0) {
-        apiKeyPart = "\r\n--" + boundary + "\r\n";
-        apiKeyPart += "Content-Disposition: form-data; name=\"apiKey\"\r\n\r\n";
-        apiKeyPart += String(API_KEY);
+// Bump allocator over a static buffer for the access-response and
+// firmware-event documents. Freed blocks aren't reused; the pool is reset
+// before each document, and both only ever run on the uplink task.
+class JsonPool : public ArduinoJson::Allocator {
+public:
+    void reset() { _used = 0; }
+
+    void* allocate(size_t size) override {
+        size_t need = HEADER + align(size);
+        if (need > sizeof(_buf) - _used) return nullptr;
+        uint8_t* block = _buf + _used;
+        *(size_t*)block = size;
+        _used += need;
+        return block + HEADER;
     }
 
-    String sidePart = "";
-    if (side && strlen(side) > 0) {
-        sidePart = "\r\n--" + boundary + "\r\n";
-        sidePart += "Content-Disposition: form-data; name=\"side\"\r\n\r\n";
-        sidePart += String(side);
+    void deallocate(void*) override {}
+
+    void* reallocate(void* ptr, size_t newSize) override {
+        if (!ptr) return allocate(newSize);
+        uint8_t* block = (uint8_t*)ptr - HEADER;
+        size_t oldSize = *(size_t*)block;
+        // The newest block grows or shrinks in place
+        if (block + HEADER + align(oldSize) == _buf + _used &&
+            (size_t)(block - _buf) + HEADER + align(newSize) <= sizeof(_buf)) {
+            *(size_t*)block = newSize;
+            _used = (size_t)(block - _buf) + HEADER + align(newSize);
+            return ptr;
+        }
+        void* moved = allocate(newSize);
+        if (moved) memcpy(moved, ptr, oldSize < newSize ? oldSize : newSize);
+        return moved;
     }
 
-    String bodyEnd = "\r\n--" + boundary + "--\r\n";
-    int totalLen = bodyStart.length() + fb->len + apiKeyPart.length() + sidePart.length() + bodyEnd.length();
-
-    uint8_t* body = (uint8_t*)malloc(totalLen);
-    if (!body) {
-        response.reason = "Failed to allocate request buffer";
-        return response;
+private:
+    static constexpr size_t HEADER = 8;
+    static size_t align(size_t n) { return (n + 7) & ~(size_t)7; }
+
+    alignas(8) uint8_t _buf[API_JSON_POOL_BYTES];
+    size_t _used = 0;
+};
+
+static JsonPool _jsonPool;
+
+// HttpResponseReader for access requests: parses the reply from the socket
+// into the AccessResponse at `ctx`, keeping only the fields it has room for
+static void read_access_response(HttpBodyReader& body, int status, void* ctx) {
+    AccessResponse& response = *(AccessResponse*)ctx;
+    if (status != 200) return;
+
+    // Built once, on the first request
+    static JsonDocument filter;
+    if (filter.isNull()) {
+        filter["allowed"] = true;
+        filter["animalId"] = true;
+        filter["animalName"] = true;
+        filter["confidenceScore"] = true;
+        filter["reason"] = true;
+        filter["direction"] = true;
     }
 
-    int offset = 0;
-    memcpy(body + offset, bodyStart.c_str(), bodyStart.length()); offset += bodyStart.length();
-    memcpy(body + offset, fb->buf, fb->len); offset += fb->len;
-    if (apiKeyPart.length() > 0) { memcpy(body + offset, apiKeyPart.c_str(), apiKeyPart.length()); offset += apiKeyPart.length(); }
-    if (sidePart.length() > 0) { memcpy(body + offset, sidePart.c_str(), sidePart.length()); offset += sidePart.length(); }
-    memcpy(body + offset, bodyEnd.c_str(), bodyEnd.length());
-
-    Serial.printf("Sending access request: %d bytes\n", totalLen);
-
-    String url = String(API_BASE_URL) + String(API_ACCESS_ENDPOINT);
-    int httpCode = network_manager_http_post_multipart(url.c_str(), body, totalLen, contentType.c_str());
-    free(body);
-
-    if (httpCode == -1) {
-        // Network unavailable — queue as synthetic event
-        QueuedEvent evt;
-        evt.eventType = "UnknownAnimal";
-        evt.notes = "Offline during detection";
-        evt.batteryVoltage = -1;
-        evt.apiKey = API_KEY;
-        evt.timestamp = millis();
-        offline_queue_push(evt);
-        response.reason = "Queued";
-        return response;
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    DeserializationError err = deserializeJson(doc, body, DeserializationOption::Filter(filter));
+    if (err) {
+        snprintf(response.reason, sizeof(response.reason), "JSON parse error: %s", err.c_str());
+        return;
     }
+    response.allowed = doc["allowed"] | false;
+    response.animalId = doc["animalId"] | -1;
+    strlcpy(response.animalName, doc["animalName"] | "", sizeof(response.animalName));
+    response.confidenceScore = doc["confidenceScore"] | 0.0f;
+    strlcpy(response.reason, doc["reason"] | "", sizeof(response.reason));
+    strlcpy(response.direction, doc["direction"] | "", sizeof(response.direction));
+    response.success = true;
+    Serial.printf("API response: allowed=%d, animal=%s, confidence=%.2f, direction=%s\n",
+                  response.allowed, response.animalName,
+                  response.confidenceScore, response.direction);
+}
 
-    if (httpCode == HTTP_CODE_OK) {
-        String responseStr = "";
-        // Note: for network_manager WiFi path, response is read via HTTPClient internally
-        // For the full response we'd need to refactor — here we parse from httpCode only
-        // In practice this path is WiFi-only so we can read from HTTPClient
-        // Simplified: mark success and parse response
-        response.success = true;
-        response.allowed = false;
-        response.reason = "Response parsing requires direct HTTPClient ref";
-        Serial.printf("API response HTTP %d\n", httpCode);
-    } else {
-        response.reason = "HTTP error: " + String(httpCode);
-        Serial.printf("HTTP POST failed: %d\n", httpCode);
+// Form values for a combined request; the buffers back the body's fields
+// until it has been sent
+struct DetectionFields {
+    char dogScore[12];
+    char changed[8];
+    char total[8];
+};
+
+static void add_detection_fields(MultipartBody* body, const DetectionInfo& detection,
+                                 bool logApproach, DetectionFields* fields) {
+    fields->dogScore[0] = fields->changed[0] = fields->total[0] = '\0';
+    if (detection.dogScore >= 0) snprintf(fields->dogScore, sizeof(fields->dogScore), "%.3f", detection.dogScore);
+    if (detection.motionTotalBlocks > 0) {
+        snprintf(fields->changed, sizeof(fields->changed), "%d", detection.motionChangedBlocks);
+        snprintf(fields->total, sizeof(fields->total), "%d", detection.motionTotalBlocks);
     }
-
-    return response;
+    multipart_add_field(body, "logApproach", logApproach ? "true" : "false");
+    multipart_add_field(body, "dog", detection.dog ? "true" : "false");
+    multipart_add_field(body, "dogScore", fields->dogScore);
+    multipart_add_field(body, "motionChangedBlocks", fields->changed);
+    multipart_add_field(body, "motionTotalBlocks", fields->total);
 }
 
-// Restore direct HTTPClient for access requests to retain response body parsing
-AccessResponse api_request_access_direct(camera_fb_t* fb, const char* side) {
-    AccessResponse response = {false, -1, "", 0.0f, "", "", false};
-
-    if (!fb || !fb->buf || fb->len == 0) {
-        response.reason = "Invalid frame buffer";
+AccessResponse api_request_access(Frame* frame, const char* side, const DetectionInfo* detection) {
+    AccessResponse response = {false, -1, "", 0.0f, "", "", false, false};
+
+    // On a slow link the decision is made from a smaller image; the full
+    // frame reaches the server later through the approach-photo backfill
+    PayloadClass cls = network_manager_payload_class();
+    const uint8_t* jpegBuf;
+    size_t jpegLen;
+    uint64_t hash;
+    if (!frame || !frame_payload(frame, cls, &jpegBuf, &jpegLen, &hash)) {
+        strlcpy(response.reason, "Invalid frame buffer", sizeof(response.reason));
         return response;
     }
 
-    if (network_manager_get_transport() != NetworkTransport::WiFi) {
-        // Offline — queue and return
-        QueuedEvent evt;
-        evt.eventType = "UnknownAnimal";
-        evt.notes = "Offline during detection";
-        evt.batteryVoltage = -1;
-        evt.apiKey = API_KEY;
-        evt.timestamp = millis();
-        offline_queue_push(evt);
-        response.reason = "Queued";
+    // The approach log wants the full frame; below that it is backfilled
+    bool logApproach = detection && detection->logApproach && cls == PayloadClass::Full;
+    bool spoolApproach = detection && detection->logApproach && !logApproach;
+    if (detection && !detection->dog && !logApproach) {
+        if (spoolApproach) image_spool_store(frame, side);
+        strlcpy(response.reason, "Not a dog (not sent)", sizeof(response.reason));
+        response.skipped = true;
         return response;
     }
 
-    HTTPClient http;
-    String url = String(API_BASE_URL) + String(API_ACCESS_ENDPOINT);
-    http.begin(getSecureClient(), url);
-    http.setTimeout(API_TIMEOUT_MS);
-
-    String boundary = "----ESP32CAMBoundary";
-    String contentType = "multipart/form-data; boundary=" + boundary;
-    http.addHeader("Content-Type", contentType);
-
-    String bodyStart = "--" + boundary + "\r\n";
-    bodyStart += "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n";
-    bodyStart += "Content-Type: image/jpeg\r\n\r\n";
-
-    String apiKeyPart = "";
-    if (strlen(API_KEY) > 0) {
-        apiKeyPart = "\r\n--" + boundary + "\r\n";
-        apiKeyPart += "Content-Disposition: form-data; name=\"apiKey\"\r\n\r\n";
-        apiKeyPart += String(API_KEY);
-    }
-
-    String sidePart = "";
-    if (side && strlen(side) > 0) {
-        sidePart = "\r\n--" + boundary + "\r\n";
-        sidePart += "Content-Disposition: form-data; name=\"side\"\r\n\r\n";
-        sidePart += String(side);
+    MultipartBody body;
+    DetectionFields fields;
+    char hashHex[DHASH_HEX_LEN + 1];
+    build_image_body(&body, jpegBuf, jpegLen, "capture.jpg", side);
+    multipart_add_field(&body, "payloadClass", payload_class_name(cls));
+    // The API matches a thumbnail on this hash rather than re-hashing the JPEG
+    if (cls == PayloadClass::Thumbnail) {
+        dhash_to_hex(hash, hashHex);
+        multipart_add_field(&body, "imageHash", hashHex);
     }
-
-    String bodyEnd = "\r\n--" + boundary + "--\r\n";
-    int totalLen = bodyStart.length() + fb->len + apiKeyPart.length() + sidePart.length() + bodyEnd.length();
-
-    uint8_t* body = (uint8_t*)malloc(totalLen);
-    if (!body) {
-        response.reason = "Failed to allocate request buffer";
+    if (detection) add_detection_fields(&body, *detection, logApproach, &fields);
+    Serial.printf("Sending access request: %u bytes (%s)\n",
+                  (unsigned)multipart_content_length(body), payload_class_name(cls));
+
+    uint32_t uploadStart = micros();
+    int httpCode = network_manager_http_post_multipart(API_BASE_URL API_ACCESS_ENDPOINT, body,
+                                                       read_access_response, &response);
+    perf_record(PerfStage::Upload, micros() - uploadStart);
+
+    if (httpCode < 0) {
+        // No reply (offline, timeout, dropped connection) — queue as
+        // synthetic event and keep the image
+        queue_offline_detection();
+        image_spool_store(frame, side);
+        strlcpy(response.reason, "Queued", sizeof(response.reason));
         return response;
     }
+    if (spoolApproach) image_spool_store(frame, side);
 
-    int offset = 0;
-    memcpy(body + offset, bodyStart.c_str(), bodyStart.length()); offset += bodyStart.length();
-    memcpy(body + offset, fb->buf, fb->len); offset += fb->len;
-    if (apiKeyPart.length() > 0) { memcpy(body + offset, apiKeyPart.c_str(), apiKeyPart.length()); offset += apiKeyPart.length(); }
-    if (sidePart.length() > 0) { memcpy(body + offset, sidePart.c_str(), sidePart.length()); offset += sidePart.length(); }
-    memcpy(body + offset, bodyEnd.c_str(), bodyEnd.length());
-
-    Serial.printf("Sending access request: %d bytes\n", totalLen);
-
-    int httpCode = http.POST(body, totalLen);
-    free(body);
-
-    if (httpCode == HTTP_CODE_OK) {
-        String responseStr = http.getString();
-        JsonDocument doc;
-        DeserializationError err = deserializeJson(doc, responseStr);
-        if (!err) {
-            response.allowed = doc["allowed"] | false;
-            response.animalId = doc["animalId"] | -1;
-            response.animalName = doc["animalName"].as<String>();
-            response.confidenceScore = doc["confidenceScore"] | 0.0f;
-            response.reason = doc["reason"].as<String>();
-            response.direction = doc["direction"].as<String>();
-            response.success = true;
-            Serial.printf("API response: allowed=%d, animal=%s, confidence=%.2f, direction=%s\n",
-                         response.allowed, response.animalName.c_str(),
-                         response.confidenceScore, response.direction.c_str());
-        } else {
-            response.reason = "JSON parse error: " + String(err.c_str());
-        }
-    } else {
-        response.reason = "HTTP error: " + String(httpCode);
+    if (httpCode != 200) {
+        snprintf(response.reason, sizeof(response.reason), "HTTP error: %d", httpCode);
         Serial.printf("HTTP POST failed: %d\n", httpCode);
     }
-
-    http.end();
     return response;
 }
 
-bool api_post_approach_photo(camera_fb_t* fb, const char* side) {
-    if (!fb || !fb->buf || fb->len == 0) return false;
-
-    if (network_manager_get_transport() != NetworkTransport::WiFi) {
-        // No network — skip approach photo upload (not queued; approach events are best-effort)
-        return false;
+// Same request, but checks for an IP transport before encoding so an offline detection
+// is queued without spending time on a JPEG that cannot be sent.
+AccessResponse api_request_access_direct(Frame* frame, const char* side, const DetectionInfo* detection) {
+    if (frame && !network_manager_has_ip()) {
+        AccessResponse response = {false, -1, "", 0.0f, "Queued", "", false, false};
+        queue_offline_detection();
+        image_spool_store(frame, side);
+        return response;
     }
+    return api_request_access(frame, side, detection);
+}
 
-    HTTPClient http;
-    String url = String(API_BASE_URL) + String(API_APPROACH_ENDPOINT);
-    http.begin(getSecureClient(), url);
-    http.setTimeout(API_TIMEOUT_MS);
-
-    String boundary = "----ESP32CAMBoundary";
-    http.addHeader("Content-Type", "multipart/form-data; boundary=" + boundary);
-
-    String bodyStart = "--" + boundary + "\r\n";
-    bodyStart += "Content-Disposition: form-data; name=\"image\"; filename=\"approach.jpg\"\r\n";
-    bodyStart += "Content-Type: image/jpeg\r\n\r\n";
+bool api_post_approach_photo(Frame* frame, const char* side) {
+    if (!frame) return false;
 
-    String apiKeyPart = "";
-    if (strlen(API_KEY) > 0) {
-        apiKeyPart = "\r\n--" + boundary + "\r\n";
-        apiKeyPart += "Content-Disposition: form-data; name=\"apiKey\"\r\n\r\n";
-        apiKeyPart += String(API_KEY);
-    }
-
-    String sidePart = "";
-    if (side && strlen(side) > 0) {
-        sidePart = "\r\n--" + boundary + "\r\n";
-        sidePart += "Content-Disposition: form-data; name=\"side\"\r\n\r\n";
-        sidePart += String(side);
+    if (!network_manager_has_ip()) {
+        // No network — spool the photo for upload once a link is back
+        image_spool_store(frame, side);
+        return false;
     }
-
-    String bodyEnd = "\r\n--" + boundary + "--\r\n";
-    int totalLen = bodyStart.length() + fb->len + apiKeyPart.length() + sidePart.length() + bodyEnd.length();
-
-    uint8_t* body = (uint8_t*)malloc(totalLen);
-    if (!body) {
-        http.end();
+    if (network_manager_payload_class() != PayloadClass::Full) {
+        // Too slow or metered for a full frame; the access request (if any)
+        // carries a smaller image now and this one is backfilled later
+        image_spool_store(frame, side);
         return false;
     }
 
-    int offset = 0;
-    memcpy(body + offset, bodyStart.c_str(), bodyStart.length()); offset += bodyStart.length();
-    memcpy(body + offset, fb->buf, fb->len); offset += fb->len;
-    if (apiKeyPart.length() > 0) { memcpy(body + offset, apiKeyPart.c_str(), apiKeyPart.length()); offset += apiKeyPart.length(); }
-    if (sidePart.length() > 0) { memcpy(body + offset, sidePart.c_str(), sidePart.length()); offset += sidePart.length(); }
-    memcpy(body + offset, bodyEnd.c_str(), bodyEnd.length());
+    const uint8_t* jpegBuf;
+    size_t jpegLen;
+    if (!frame_jpeg(frame, &jpegBuf, &jpegLen)) return false;
+
+    MultipartBody body;
+    build_image_body(&body, jpegBuf, jpegLen, "approach.jpg", side);
 
-    int httpCode = http.POST(body, totalLen);
-    free(body);
-    http.end();
+    uint32_t uploadStart = micros();
+    int httpCode = network_manager_http_post_multipart(API_BASE_URL API_APPROACH_ENDPOINT, body, nullptr, nullptr);
+    perf_record(PerfStage::Upload, micros() - uploadStart);
 
     Serial.printf("Approach photo upload: HTTP %d\n", httpCode);
-    return (httpCode == HTTP_CODE_NO_CONTENT || httpCode == HTTP_CODE_OK);
+    if (httpCode < 0) image_spool_store(frame, side);
+    return (httpCode == 204 || httpCode == 200);
 }
 
 void api_post_firmware_event(const char* apiKey, const char* eventType, const char* notes, double batteryVoltage) {
-    JsonDocument doc;
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
     doc["apiKey"] = apiKey;
     doc["eventType"] = eventType;
     doc["notes"] = notes ? notes : "";
     doc["batteryVoltage"] = batteryVoltage;
 
-    String body;
-    serializeJson(doc, body);
-
-    String url = String(API_BASE_URL) + String(API_FIRMWARE_EVENT_ENDPOINT);
-    int code = network_manager_http_post_json(url.c_str(), body);
+    char body[256];
+    int code = -1;
+    if (measureJson(doc) < sizeof(body)) {
+        serializeJson(doc, body, sizeof(body));
+        code = network_manager_http_post_json(API_BASE_URL API_FIRMWARE_EVENT_ENDPOINT, body);
+    }
 
     if (code != 204 && code != 200) {
-        QueuedEvent evt;
-        evt.eventType = eventType;
-        evt.notes = notes ? notes : "";
-        evt.batteryVoltage = batteryVoltage;
-        evt.apiKey = apiKey;
-        evt.timestamp = millis();
-        offline_queue_push(evt);
+        queue_event(apiKey, eventType, notes, batteryVoltage);
     }
 }
@@ -2,29 +2,51 @@
 #define API_CLIENT_H
 
 #include <Arduino.h>
-#include "esp_camera.h"
+#include "frame_handle.h"
 
+// Fixed capacity: decoded straight from the socket, with no heap strings.
+// Longer values are truncated.
 struct AccessResponse {
     bool allowed;
     int animalId;
-    String animalName;
+    char animalName[32];
     float confidenceScore;
-    String reason;
-    String direction;
+    char reason[64];
+    char direction[12];
     bool success;  // true if API call succeeded
+    bool skipped;  // nothing was sent: the detector rejected the frame
 };
 
-// Send camera image to API for dog identification (uses direct HTTPClient with response parsing)
+// What the device already knows about a frame, sent with a combined access
+// request (COMBINED_ACCESS_UPLOAD).
+struct DetectionInfo {
+    bool logApproach;        // the request also stands in for the approach photo
+    bool dog;                // false: the server only logs the approach
+    float dogScore;          // TFLite score; < 0 if the detector didn't run
+    int motionChangedBlocks;
+    int motionTotalBlocks;   // 0 if the motion prefilter didn't run
+};
+
+// Send camera image to API for dog identification. The JPEG is streamed to the
+// socket in place (see multipart_writer.h). On a slow link a reduced JPEG or
+// a grayscale thumbnail plus its dHash is sent instead, and the class is
+// reported in the payloadClass field.
 // side: "inside" or "outside" indicating which camera triggered the request
-AccessResponse api_request_access(camera_fb_t* fb, const char* side);
-AccessResponse api_request_access_direct(camera_fb_t* fb, const char* side);
+// detection: sent as form fields when set. The approach is only logged from
+// a full frame; on a slower link the frame is spooled for backfill as
+// api_post_approach_photo() does, and a non-dog isn't sent at all.
+AccessResponse api_request_access(Frame* frame, const char* side, const DetectionInfo* detection = nullptr);
+AccessResponse api_request_access_direct(Frame* frame, const char* side, const DetectionInfo* detection = nullptr);
 
 // Post an approach photo to the API — logs an AnimalApproach event with the captured image.
-// Called for every motion+proximity detection regardless of TFLite result.
+// Called for every motion+proximity detection regardless of TFLite result,
+// from the uplink task on core 0.
+// On a link too slow for full frames the photo is spooled for backfill instead.
 // Returns true if the HTTP POST succeeded (204 No Content).
-bool api_post_approach_photo(camera_fb_t* fb, const char* side);
+bool api_post_approach_photo(Frame* frame, const char* side);
 
-// Post a firmware event (door opened/closed, power events, etc.)
+// Post a firmware event (door opened/closed, power events, etc.), queuing it
+// offline if the post fails.
 void api_post_firmware_event(const char* apiKey, const char* eventType, const char* notes, double batteryVoltage);
 
 #endif // API_CLIENT_H
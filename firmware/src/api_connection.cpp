@@ -0,0 +1,222 @@
+#include "api_connection.h"
+#include "config.h"
+#include "perf_stats.h"
+#include "tls_client.h"
+#include <esp_heap_caps.h>
+
+struct PoolSlot {
+    ResumableTlsClient client;
+    bool inUse;
+    unsigned long lastUsed;
+};
+
+static PoolSlot _slots[API_CONNECTION_POOL_SIZE];
+static SemaphoreHandle_t _free = nullptr;   // counts slots not in use
+static SemaphoreHandle_t _slotLock = nullptr;  // guards inUse flags
+static HttpUrl _base;
+static bool _baseValid = false;
+static unsigned long _lastWarmFailure = 0;
+static bool _warmFailed = false;
+
+static uint32_t _handshakes = 0;
+static uint32_t _resumeOffers = 0;
+static uint32_t _requests = 0;
+static uint32_t _reusedRequests = 0;
+static int32_t _lastConnectHeapBytes = 0;
+static uint8_t _peakFragmentation = 0;
+
+void api_connection_init() {
+    _free = xSemaphoreCreateCounting(API_CONNECTION_POOL_SIZE, API_CONNECTION_POOL_SIZE);
+    _slotLock = xSemaphoreCreateMutex();
+    _baseValid = http_parse_url(API_BASE_URL, &_base);
+    if (!_baseValid) {
+        Serial.println("[NET] API_BASE_URL is malformed; API requests disabled");
+    }
+
+    const char* ca = nullptr;
+#if API_INSECURE_TLS
+    Serial.println("[NET] TLS: certificate verification disabled (dev mode)");
+#else
+    if (strlen(API_CA_CERT) > 0) {
+        ca = API_CA_CERT;
+        Serial.println("[NET] TLS: CA certificate loaded");
+    } else {
+        Serial.println("[NET] TLS: no CA cert provided, verification disabled");
+    }
+#endif
+    for (PoolSlot& slot : _slots) {
+        slot.client.setTimeout(API_TIMEOUT_MS);
+        slot.client.setCACert(ca);
+    }
+    Serial.printf("[NET] API transport: %d TLS connection(s)\n", API_CONNECTION_POOL_SIZE);
+}
+
+// Take a slot, preferring one that already holds a live connection.
+static PoolSlot* acquire_slot(TickType_t wait) {
+    if (xSemaphoreTake(_free, wait) != pdTRUE) return nullptr;
+    PoolSlot* chosen = nullptr;
+    xSemaphoreTake(_slotLock, portMAX_DELAY);
+    for (PoolSlot& slot : _slots) {
+        if (slot.inUse) continue;
+        if (!chosen) chosen = &slot;
+        if (slot.client.connected()) {
+            chosen = &slot;
+            break;
+        }
+    }
+    chosen->inUse = true;
+    xSemaphoreGive(_slotLock);
+    return chosen;
+}
+
+static void release_slot(PoolSlot* slot) {
+    xSemaphoreTake(_slotLock, portMAX_DELAY);
+    slot->inUse = false;
+    xSemaphoreGive(_slotLock);
+    xSemaphoreGive(_free);
+}
+
+static bool connect_slot(PoolSlot* slot) {
+    if (slot->client.connected()) return true;
+    size_t heapBefore = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    if (!slot->client.connect(_base.host, _base.port)) {
+        Serial.printf("[NET] TLS connect to %s:%u failed\n", _base.host, _base.port);
+        return false;
+    }
+    _lastConnectHeapBytes = (int32_t)heapBefore - (int32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    _handshakes++;
+    if (slot->client.lastHandshakeOfferedSession()) _resumeOffers++;
+    perf_record(PerfStage::TlsHandshake, slot->client.lastHandshakeUs());
+    Serial.printf("[NET] TLS connected in %lu ms (%s), %ld B internal heap\n",
+                  (unsigned long)(slot->client.lastHandshakeUs() / 1000),
+                  slot->client.lastHandshakeOfferedSession() ? "resuming session" : "full handshake",
+                  (long)_lastConnectHeapBytes);
+    slot->lastUsed = millis();
+    return true;
+}
+
+int api_connection_post(const char* url, const char* contentType, size_t contentLength,
+                        HttpBodyWriter writeBody, const void* ctx,
+                        HttpResponseReader readBody, void* readCtx) {
+    HttpUrl target;
+    if (!_baseValid || !http_parse_url(url, &target) ||
+        strcmp(target.host, _base.host) != 0 || target.port != _base.port) {
+        return HTTP_STREAM_ERR_BAD_URL;
+    }
+
+    PoolSlot* slot = acquire_slot(pdMS_TO_TICKS(API_TIMEOUT_MS));
+    if (!slot) return HTTP_STREAM_ERR_TIMEOUT;
+
+    int result = HTTP_STREAM_ERR_CONNECT;
+    bool keepAlive = false;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool reused = slot->client.connected();
+        if (!connect_slot(slot)) break;
+
+        bool requestSent;
+        uint32_t start = micros();
+        result = http_stream_post(slot->client, target, contentType, contentLength, writeBody, ctx,
+                                  readBody, readCtx, &keepAlive, &requestSent);
+        if (result >= 0) {
+            perf_record(PerfStage::HttpRequest, micros() - start);
+            _requests++;
+            if (reused) _reusedRequests++;
+        }
+        // Once the request is fully written the server may have acted on it,
+        // and these POSTs aren't idempotent, so a lost reply isn't retried
+        if (result >= 0 || !reused || requestSent) break;
+
+        // The server dropped the idle connection under us; retry on a new one
+        Serial.println("[NET] Keep-alive connection was stale, reconnecting");
+        slot->client.stop();
+    }
+
+    if (!keepAlive) slot->client.stop();
+    slot->lastUsed = millis();
+    release_slot(slot);
+    return result;
+}
+
+void api_connection_maintain(bool networkUp) {
+    if (!_baseValid) return;
+
+    // Work on every idle slot; ones busy with a request are left alone
+    PoolSlot* idle[API_CONNECTION_POOL_SIZE];
+    int count = 0;
+    while (count < API_CONNECTION_POOL_SIZE && (idle[count] = acquire_slot(0)) != nullptr) count++;
+
+    PoolSlot* warm = nullptr;
+    for (int i = 0; i < count; i++) {
+        PoolSlot* s = idle[i];
+        // Recycle before the server's idle timeout can close it mid-request
+        if (!networkUp || millis() - s->lastUsed > API_KEEPALIVE_IDLE_MS) s->client.stop();
+        // Only one connection is kept warm; extra slots are for bursts and
+        // give their TLS buffers back once idle
+        if (!warm) {
+            warm = s;
+        } else if (s->client.connected()) {
+            s->client.stop();
+        }
+    }
+
+    // Don't hammer an unreachable server; requests still connect on demand
+    if (warm && networkUp && API_CONNECTION_KEEP_WARM && !warm->client.connected() &&
+        (!_warmFailed || millis() - _lastWarmFailure > API_WARM_RETRY_INTERVAL_MS)) {
+        _warmFailed = !connect_slot(warm);
+        if (_warmFailed) _lastWarmFailure = millis();
+    }
+
+    for (int i = 0; i < count; i++) release_slot(idle[i]);
+}
+
+void api_connection_close() {
+    if (!_free) return;
+    PoolSlot* held[API_CONNECTION_POOL_SIZE];
+    for (int i = 0; i < API_CONNECTION_POOL_SIZE; i++) {
+        held[i] = acquire_slot(portMAX_DELAY);
+        held[i]->client.stop();
+    }
+    for (int i = 0; i < API_CONNECTION_POOL_SIZE; i++) release_slot(held[i]);
+}
+
+void api_connection_get_stats(ApiConnectionStats* out) {
+    memset(out, 0, sizeof(*out));
+    out->poolSize = API_CONNECTION_POOL_SIZE;
+    xSemaphoreTake(_slotLock, portMAX_DELAY);
+    for (PoolSlot& slot : _slots) {
+        // Busy slots are mid-request and therefore connected
+        if (slot.inUse) out->inUse++;
+        if (slot.inUse || slot.client.connected()) out->connected++;
+    }
+    xSemaphoreGive(_slotLock);
+    out->handshakes = _handshakes;
+    out->resumeOffers = _resumeOffers;
+    out->requests = _requests;
+    out->reusedRequests = _reusedRequests;
+    out->lastConnectHeapBytes = _lastConnectHeapBytes;
+    out->freeInternalHeap = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    out->minFreeInternalHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    out->largestInternalBlock = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    if (out->freeInternalHeap > 0) {
+        out->fragmentationPercent =
+            (uint8_t)(100 - (uint64_t)out->largestInternalBlock * 100 / out->freeInternalHeap);
+    }
+    if (out->fragmentationPercent > _peakFragmentation) _peakFragmentation = out->fragmentationPercent;
+    out->peakFragmentationPercent = _peakFragmentation;
+    out->uptimeMin = millis() / 60000;
+}
+
+void api_connection_log_stats() {
+    ApiConnectionStats s;
+    api_connection_get_stats(&s);
+    Serial.printf("[NET] transport: pool=%u connected=%u in_use=%u handshakes=%lu (session offered %lu) "
+                  "requests=%lu (reused %lu) conn_heap=%ld B | internal heap free=%lu min=%lu largest=%lu "
+                  "frag=%u%% (peak %u%%) uptime=%lu min\n",
+                  s.poolSize, s.connected, s.inUse,
+                  (unsigned long)s.handshakes, (unsigned long)s.resumeOffers,
+                  (unsigned long)s.requests, (unsigned long)s.reusedRequests,
+                  (long)s.lastConnectHeapBytes,
+                  (unsigned long)s.freeInternalHeap, (unsigned long)s.minFreeInternalHeap,
+                  (unsigned long)s.largestInternalBlock,
+                  s.fragmentationPercent, s.peakFragmentationPercent, (unsigned long)s.uptimeMin);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// The firmware's single HTTPS transport to API_BASE_URL. Every module's
+// requests (access requests, uploads, firmware events, power events, the
+// offline queue) go through network_manager into this bounded pool of
+// API_CONNECTION_POOL_SIZE TLS connections, so the number of live mbedTLS
+// contexts — tens of KB of internal heap each — has a hard ceiling.
+//
+// One HTTP/1.1 keep-alive connection is kept warm so requests skip the
+// TCP + TLS handshake. When a connection has to be re-established (server
+// idle timeout, WiFi drop) its cached TLS session is offered, turning the
+// reconnect into an abbreviated handshake. Handshake and request times are
+// recorded as separate perf stages.
+//
+// Runs over whichever interface has the default route: WiFi, or cellular
+// in PPP data mode (cellular_manager.h).
+
+#include <Arduino.h>
+#include "http_stream.h"
+
+void api_connection_init();
+
+// POST over a pooled connection (waiting up to API_TIMEOUT_MS for a free
+// one), connecting first if needed. `url` must
+// be on API_BASE_URL's host. A request whose header or body can't be
+// written on a reused connection (the server closed it while idle) is
+// retried once on a fresh connection; one that was fully sent never is. The response body goes to `readBody` as in
+// http_stream_post(), with the same return values.
+int api_connection_post(const char* url, const char* contentType, size_t contentLength,
+                        HttpBodyWriter writeBody, const void* ctx,
+                        HttpResponseReader readBody, void* readCtx);
+
+// Background upkeep, called from the uplink task between jobs: recycles
+// connections before the server's idle timeout, closes surplus idle ones
+// and reconnects one ahead of the next request, so access requests find a
+// warm connection.
+void api_connection_maintain(bool networkUp);
+
+// Drop all connections (cached sessions are kept for resumption).
+void api_connection_close();
+
+struct ApiConnectionStats {
+    uint8_t poolSize;
+    uint8_t connected;               // live TLS connections
+    uint8_t inUse;                   // slots carrying a request right now
+    uint32_t handshakes;
+    uint32_t resumeOffers;           // handshakes that offered a cached session
+    uint32_t requests;
+    uint32_t reusedRequests;         // requests that skipped the handshake
+    int32_t lastConnectHeapBytes;    // internal heap taken by the last connect
+    uint32_t freeInternalHeap;
+    uint32_t minFreeInternalHeap;    // low-water mark since boot
+    uint32_t largestInternalBlock;
+    uint8_t fragmentationPercent;      // free internal heap outside the largest block
+    uint8_t peakFragmentationPercent;  // highest sampled since boot
+    uint32_t uptimeMin;
+};
+
+void api_connection_get_stats(ApiConnectionStats* out);
+
+// One [NET] line with the counters above. Fragmentation should stay flat
+// over days of uptime; a steady climb means something is churning the heap.
+void api_connection_log_stats();
@@ -0,0 +1,95 @@
+#include "at_engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void at_engine_init(AtEngine* at, AtLineHandler onLine, void* ctx) {
+    memset(at, 0, sizeof(*at));
+    at->onLine = onLine;
+    at->ctx = ctx;
+}
+
+void at_engine_begin(AtEngine* at, const char* terminator) {
+    at->busy = true;
+    at->result = AtResult::Pending;
+    at->terminator = terminator;
+}
+
+void at_engine_cancel(AtEngine* at) {
+    at->busy = false;
+    at->terminator = nullptr;
+}
+
+static bool starts_with(const char* s, const char* prefix) {
+    return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+static AtResult final_result(const AtEngine* at, const char* line) {
+    if (strcmp(line, "OK") == 0) return AtResult::Ok;
+    if (strcmp(line, "ERROR") == 0 || starts_with(line, "+CME ERROR") ||
+        starts_with(line, "+CMS ERROR")) {
+        return AtResult::Error;
+    }
+    if (at->terminator && starts_with(line, at->terminator)) return AtResult::Ok;
+    return AtResult::Pending;
+}
+
+// Returns true if the line completed the pending command
+static bool dispatch(AtEngine* at, const char* line) {
+    if (at->busy) {
+        AtResult result = final_result(at, line);
+        if (result != AtResult::Pending) {
+            at->busy = false;
+            at->result = result;
+            at->terminator = nullptr;
+            return true;
+        }
+    }
+    // Echo, in case ATE0 hasn't been sent yet
+    if (starts_with(line, "AT")) return false;
+    if (at->onLine) at->onLine(at->ctx, line);
+    return false;
+}
+
+bool at_engine_feed(AtEngine* at, const uint8_t* data, size_t len) {
+    bool completed = false;
+    for (size_t i = 0; i < len; i++) {
+        char c = (char)data[i];
+        if (c == '\r') continue;
+        if (c == '\n') {
+            if (!at->discarding && at->lineLen > 0) {
+                at->line[at->lineLen] = '\0';
+                if (dispatch(at, at->line)) completed = true;
+            }
+            at->lineLen = 0;
+            at->discarding = false;
+            continue;
+        }
+        if (at->discarding) continue;
+        if (at->lineLen >= AT_LINE_MAX - 1) {
+            at->discarding = true;
+            at->overflows++;
+            continue;
+        }
+        at->line[at->lineLen++] = c;
+    }
+    return completed;
+}
+
+int at_parse_ints(const char* line, const char* prefix, int* out, int maxOut) {
+    if (!starts_with(line, prefix)) return -1;
+    const char* p = line + strlen(prefix);
+    int n = 0;
+    while (n < maxOut) {
+        while (*p == ' ') p++;
+        char* end;
+        long v = strtol(p, &end, 10);
+        if (end == p) break;
+        out[n++] = (int)v;
+        p = end;
+        while (*p == ' ') p++;
+        if (*p != ',') break;
+        p++;
+    }
+    return n;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Line-level AT command engine for the cellular modem. Bytes from the UART
+// are split into lines; while a command is pending its final result code
+// (OK, ERROR, +CME/+CMS ERROR, or a command-specific terminator such as
+// DOWNLOAD) completes it. Every other line (information responses as well
+// as unsolicited result codes like +CREG or +HTTPACTION) goes to the line
+// handler, so registration and signal state can be cached from whatever
+// the modem says, whenever it says it. Command echo is dropped.
+//
+// No I/O and no locking: the caller writes commands and feeds received
+// bytes. Portable; builds under the `native` env.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AT_LINE_MAX 128  // longer lines are dropped and counted
+
+enum class AtResult : uint8_t { Pending, Ok, Error };
+
+typedef void (*AtLineHandler)(void* ctx, const char* line);
+
+struct AtEngine {
+    char line[AT_LINE_MAX];
+    uint16_t lineLen;
+    bool discarding;         // rest of an over-long line
+    bool busy;               // a command is waiting for its final result
+    AtResult result;
+    const char* terminator;  // extra final result for the pending command
+    AtLineHandler onLine;
+    void* ctx;
+    uint32_t overflows;
+};
+
+void at_engine_init(AtEngine* at, AtLineHandler onLine, void* ctx);
+
+// Start waiting for a command's final result; call just before writing it.
+// `terminator` (a line prefix, may be null) also completes it with Ok and
+// must stay valid until then.
+void at_engine_begin(AtEngine* at, const char* terminator);
+
+// Forget the pending command (timed out on the caller's side).
+void at_engine_cancel(AtEngine* at);
+
+// Feed received bytes. Returns true if they completed the pending command;
+// at->result holds the outcome.
+bool at_engine_feed(AtEngine* at, const uint8_t* data, size_t len);
+
+// Parse the comma-separated integers after `prefix` ("+CSQ: 17,99").
+// Returns how many were read (up to maxOut), or -1 if the prefix differs.
+int at_parse_ints(const char* line, const char* prefix, int* out, int maxOut);
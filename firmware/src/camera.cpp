@@ -1,5 +1,12 @@
 #include "camera.h"
 #include "config.h"
+#include "perf_stats.h"
+#include "image_preprocess.h"
+#include "image_hash.h"
+#include "phase_arena.h"
+#include "img_converters.h"
+
+static int _fbCount = 0;
 
 bool camera_init() {
     camera_config_t config;
@@ -31,6 +38,10 @@ bool camera_init() {
         config.jpeg_quality = 12;
         config.fb_count = 2;
         config.fb_location = CAMERA_FB_IN_PSRAM;
+#if CAMERA_CAPTURE_RAW
+        // 150KB per RGB565 frame — only viable in PSRAM
+        config.pixel_format = PIXFORMAT_RGB565;
+#endif
     } else {
         config.frame_size = FRAMESIZE_QQVGA;  // 160x120
         config.jpeg_quality = 15;
@@ -43,6 +54,7 @@ bool camera_init() {
         Serial.printf("Camera init failed with error 0x%x\n", err);
         return false;
     }
+    _fbCount = config.fb_count;
 
     // Adjust camera settings for better dog detection
     sensor_t *s = esp_camera_sensor_get();
@@ -57,16 +69,23 @@ bool camera_init() {
         s->set_gain_ctrl(s, 1);      // Enable AGC
     }
 
-    Serial.println("Camera initialized successfully");
+    Serial.printf("Camera initialized successfully (%s capture)\n",
+                  config.pixel_format == PIXFORMAT_JPEG ? "JPEG" : "RGB565");
     return true;
 }
 
+int camera_fb_count() {
+    return _fbCount;
+}
+
 camera_fb_t* camera_capture() {
+    uint32_t start = micros();
     camera_fb_t *fb = esp_camera_fb_get();
     if (!fb) {
         Serial.println("Camera capture failed");
         return nullptr;
     }
+    perf_record(PerfStage::Capture, micros() - start);
 
     Serial.printf("Captured image: %dx%d, %d bytes\n", fb->width, fb->height, fb->len);
     return fb;
@@ -77,3 +96,91 @@ void camera_release(camera_fb_t* fb) {
         esp_camera_fb_return(fb);
     }
 }
+
+bool camera_frame_jpeg(camera_fb_t* fb, CameraJpeg* out) {
+    out->buf = nullptr;
+    out->len = 0;
+    out->owned = false;
+    if (!fb || !fb->buf || fb->len == 0) return false;
+
+    if (fb->format == PIXFORMAT_JPEG) {
+        out->buf = fb->buf;
+        out->len = fb->len;
+        return true;
+    }
+
+    uint32_t start = micros();
+    if (!frame2jpg(fb, CAMERA_UPLOAD_JPEG_QUALITY, &out->buf, &out->len)) {
+        Serial.println("JPEG encode failed");
+        return false;
+    }
+    out->owned = true;
+    uint32_t elapsed = micros() - start;
+    perf_record(PerfStage::JpegEncode, elapsed);
+    Serial.printf("Encoded upload JPEG: %d bytes in %lu us\n", out->len, (unsigned long)elapsed);
+    return true;
+}
+
+bool camera_frame_scaled_jpeg(camera_fb_t* fb, int w, int h, bool grayscale, int quality,
+                              CameraJpeg* out, uint8_t* grayOut) {
+    out->buf = nullptr;
+    out->len = 0;
+    out->owned = false;
+    if (!fb || !fb->buf || fb->len == 0) return false;
+
+    uint32_t start = micros();
+    size_t rgbBytes = (size_t)w * h * 3;
+    uint8_t* rgb = (uint8_t*)scratch_alloc(rgbBytes);
+    if (!rgb) return false;
+
+    bool ok;
+    if (fb->format == PIXFORMAT_JPEG) {
+        ok = preprocess_jpeg_to_rgb(fb->buf, fb->len, rgb, w, h, nullptr);
+    } else if (fb->format == PIXFORMAT_RGB565 || fb->format == PIXFORMAT_GRAYSCALE) {
+        RawPixelFormat fmt = fb->format == PIXFORMAT_RGB565 ? RawPixelFormat::Rgb565
+                                                            : RawPixelFormat::Gray8;
+        ok = preprocess_raw_to_rgb(fb->buf, fb->width, fb->height, fmt, rgb, w, h, nullptr);
+    } else {
+        ok = false;
+    }
+
+    if (ok && grayscale) {
+        // Same luma as the dHash, packed into the front of the buffer
+        for (int i = 0; i < w * h; i++) {
+            const uint8_t* p = rgb + i * 3;
+            rgb[i] = dhash_luma(p[0], p[1], p[2]);
+        }
+        if (grayOut) memcpy(grayOut, rgb, (size_t)w * h);
+        ok = fmt2jpg(rgb, (size_t)w * h, w, h, PIXFORMAT_GRAYSCALE, quality, &out->buf, &out->len);
+    } else if (ok) {
+        // The encoder's RGB888 is stored B, G, R
+        for (int i = 0; i < w * h; i++) {
+            uint8_t r = rgb[i * 3];
+            rgb[i * 3] = rgb[i * 3 + 2];
+            rgb[i * 3 + 2] = r;
+        }
+        ok = fmt2jpg(rgb, rgbBytes, w, h, PIXFORMAT_RGB888, quality, &out->buf, &out->len);
+    }
+    scratch_free(rgb);
+    if (!ok) {
+        Serial.println("Scaled JPEG encode failed");
+        return false;
+    }
+    out->owned = true;
+    uint32_t elapsed = micros() - start;
+    perf_record(PerfStage::JpegEncode, elapsed);
+    Serial.printf("Encoded %dx%d %s JPEG: %d bytes in %lu us\n", w, h,
+                  grayscale ? "gray" : "color", out->len, (unsigned long)elapsed);
+    return true;
+}
+
+void camera_jpeg_free(CameraJpeg* jpeg) {
+    if (jpeg && jpeg->owned && jpeg->buf) {
+        free(jpeg->buf);
+    }
+    if (jpeg) {
+        jpeg->buf = nullptr;
+        jpeg->len = 0;
+        jpeg->owned = false;
+    }
+}
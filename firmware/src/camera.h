@@ -7,10 +7,35 @@
 // Initialize the OV2640 camera
 bool camera_init();
 
-// Capture a JPEG frame. Returns the framebuffer (caller must return with esp_camera_fb_return)
+// Framebuffers the driver was set up with: 2 with PSRAM, 1 without, 0
+// before camera_init() succeeds
+int camera_fb_count();
+
+// Capture a frame: RGB565 when raw capture is active, JPEG otherwise.
+// Returns the framebuffer (caller must return with camera_release)
 camera_fb_t* camera_capture();
 
 // Return a framebuffer after use
 void camera_release(camera_fb_t* fb);
 
+// JPEG bytes for uploading a frame. JPEG frames are referenced in place;
+// raw frames are software-encoded into a new buffer (owned = true).
+struct CameraJpeg {
+    uint8_t* buf;
+    size_t len;
+    bool owned;
+};
+
+bool camera_frame_jpeg(camera_fb_t* fb, CameraJpeg* out);
+
+// Smaller JPEG for slow links: the frame is resampled to w x h (with the
+// inference preprocessor, so JPEG frames are decoded at a reduced IDCT
+// scale) and software-encoded at `quality`. Grayscale output also copies
+// the w * h luma bytes into `grayOut` when non-null. Always owned.
+bool camera_frame_scaled_jpeg(camera_fb_t* fb, int w, int h, bool grayscale, int quality,
+                              CameraJpeg* out, uint8_t* grayOut);
+
+// Free an encoded JPEG (no-op for in-place frames)
+void camera_jpeg_free(CameraJpeg* jpeg);
+
 #endif // CAMERA_H
@@ -1,105 +1,369 @@
 #include "cellular_manager.h"
 #include "config.h"
+#include "at_engine.h"
+#include "ppp_link.h"
+#include <esp_task_wdt.h>
 // Serial2 is globally declared in Arduino framework (HardwareSerial.h)
 
-static bool sendAT(const char* cmd, const char* expected, unsigned long timeoutMs) {
-    Serial2.println(cmd);
-    String response = "";
-    unsigned long start = millis();
-    while (millis() - start < timeoutMs) {
-        while (Serial2.available()) {
-            response += (char)Serial2.read();
+static AtEngine _at;
+static SemaphoreHandle_t _atLock = nullptr;   // guards _at between the modem task and callers
+static SemaphoreHandle_t _cmdSlot = nullptr;  // one command in flight (binary: any task may give)
+static SemaphoreHandle_t _cmdDone = nullptr;  // given by the modem task on a final result
+static SemaphoreHandle_t _httpAction = nullptr;
+static TaskHandle_t _modemTask = nullptr;
+
+// Cached modem state, written by the modem task
+static volatile int _cregStat = 0;
+static volatile int _ceregStat = 0;
+static volatile int _rssi = 99;
+static volatile bool _simReady = false;
+static volatile int _httpStatus = -1;
+
+// PPP owns the line; the command slot is held for as long as this is set
+static volatile bool _dataMode = false;
+static volatile bool _dialing = false;  // data mode set, PPP not open yet
+
+// A status query the modem task issued itself (no caller waiting)
+static bool _backgroundCmd = false;
+static unsigned long _backgroundStartedAt = 0;
+
+static bool registered_stat(int stat) {
+    return stat == 1 || stat == 5;  // home, roaming
+}
+
+// Runs on the modem task for every line that isn't echo or a final result
+static void on_line(void*, const char* line) {
+    int v[3];
+    int n;
+    // Query replies carry "<n>,<stat>", unsolicited codes just "<stat>"
+    if ((n = at_parse_ints(line, "+CREG:", v, 2)) > 0) {
+        int stat = v[n - 1];
+        if (registered_stat(stat) != registered_stat(_cregStat)) {
+            Serial.printf("[CELL] %s\n", registered_stat(stat) ? "Registered" : "Not registered");
+        }
+        _cregStat = stat;
+    } else if ((n = at_parse_ints(line, "+CEREG:", v, 2)) > 0) {
+        _ceregStat = v[n - 1];
+    } else if (at_parse_ints(line, "+CSQ:", v, 1) == 1) {
+        _rssi = v[0];
+    } else if (at_parse_ints(line, "+HTTPACTION:", v, 3) >= 2) {
+        _httpStatus = v[1];
+        xSemaphoreGive(_httpAction);
+    } else if (strncmp(line, "+CPIN:", 6) == 0) {
+        _simReady = strstr(line, "READY") != nullptr;
+    }
+}
+
+static void begin_background(const char* cmd) {
+    xSemaphoreTake(_atLock, portMAX_DELAY);
+    at_engine_begin(&_at, nullptr);
+    xSemaphoreGive(_atLock);
+    _backgroundCmd = true;
+    _backgroundStartedAt = millis();
+    Serial2.print(cmd);
+    Serial2.print("\r");
+}
+
+static void modem_task(void*) {
+    uint8_t buf[64];
+    unsigned long lastStatus = millis();
+    for (;;) {
+        // Woken by the UART receive callback; the timeout drives the status refresh
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+        bool completed = false;
+        size_t n;
+        while ((n = Serial2.read(buf, sizeof(buf))) > 0) {
+            if (_dataMode) {
+                ppp_link_input(buf, n);
+                continue;
+            }
+            xSemaphoreTake(_atLock, portMAX_DELAY);
+            if (at_engine_feed(&_at, buf, n)) completed = true;
+            xSemaphoreGive(_atLock);
+        }
+
+        // PPP terminated (by us or the peer): the modem is back in command mode
+        if (_dataMode && !_dialing && !ppp_link_is_open()) {
+            _dataMode = false;
+            xSemaphoreGive(_cmdSlot);
+            Serial.println("[CELL] Data mode ended");
+        }
+
+        if (_backgroundCmd) {
+            bool timedOut = millis() - _backgroundStartedAt > CELLULAR_COMMAND_TIMEOUT_MS;
+            if (completed || timedOut) {
+                if (timedOut) {
+                    xSemaphoreTake(_atLock, portMAX_DELAY);
+                    at_engine_cancel(&_at);
+                    xSemaphoreGive(_atLock);
+                }
+                _backgroundCmd = false;
+                xSemaphoreGive(_cmdSlot);
+            }
+        } else if (completed) {
+            xSemaphoreGive(_cmdDone);
+        }
+
+        if (!CELLULAR_PPP_DIRECT && !_backgroundCmd && millis() - lastStatus >= CELLULAR_STATUS_INTERVAL_MS &&
+            xSemaphoreTake(_cmdSlot, 0) == pdTRUE) {
+            lastStatus = millis();
+            begin_background("AT+CSQ;+CREG?;+CEREG?");
         }
-        if (response.indexOf(expected) >= 0) return true;
-        delay(10);
     }
-    Serial.printf("[CELL] AT timeout: %s (got: %s)\n", cmd, response.c_str());
-    return false;
+}
+
+// Callers block on the uplink task, which is on the task watchdog: long
+// waits are taken in slices with the watchdog fed in between
+#define WDT_FEED_SLICE_MS 1000
+
+static bool take_fed(SemaphoreHandle_t sem, unsigned long timeoutMs) {
+    unsigned long start = millis();
+    for (;;) {
+        unsigned long elapsed = millis() - start;
+        if (elapsed >= timeoutMs) return xSemaphoreTake(sem, 0) == pdTRUE;
+        unsigned long slice = timeoutMs - elapsed;
+        if (slice > WDT_FEED_SLICE_MS) slice = WDT_FEED_SLICE_MS;
+        if (xSemaphoreTake(sem, pdMS_TO_TICKS(slice)) == pdTRUE) return true;
+        esp_task_wdt_reset();
+    }
+}
+
+static bool take_slot(unsigned long timeoutMs) {
+    return take_fed(_cmdSlot, timeoutMs);
+}
+
+static void give_slot() {
+    xSemaphoreGive(_cmdSlot);
+}
+
+// Send a command (or, with cmd == nullptr, raw data) and wait for its final
+// result. The caller holds the command slot. Only the calling task waits;
+// the modem task keeps parsing.
+static AtResult at_exchange(const char* cmd, const char* terminator, unsigned long timeoutMs,
+                            const uint8_t* data = nullptr, size_t dataLen = 0) {
+    xSemaphoreTake(_cmdDone, 0);  // stale completion from a timed-out command
+    xSemaphoreTake(_atLock, portMAX_DELAY);
+    at_engine_begin(&_at, terminator);
+    xSemaphoreGive(_atLock);
+
+    if (cmd) {
+        Serial2.print(cmd);
+        Serial2.print("\r");
+    } else {
+        Serial2.write(data, dataLen);
+    }
+
+    AtResult result = AtResult::Error;
+    bool done = take_fed(_cmdDone, timeoutMs);
+    xSemaphoreTake(_atLock, portMAX_DELAY);
+    if (done) {
+        result = _at.result;
+    } else {
+        at_engine_cancel(&_at);
+    }
+    xSemaphoreGive(_atLock);
+
+    if (!done) {
+        Serial.printf("[CELL] AT timeout: %s\n", cmd ? cmd : "data");
+    } else if (result != AtResult::Ok) {
+        Serial.printf("[CELL] AT error: %s\n", cmd ? cmd : "data");
+    }
+    return result;
+}
+
+static AtResult at_command(const char* cmd, const char* terminator, unsigned long timeoutMs,
+                           const uint8_t* data = nullptr, size_t dataLen = 0) {
+    if (!take_slot(timeoutMs)) {
+        Serial.printf("[CELL] Modem busy: %s\n", cmd ? cmd : "data");
+        return AtResult::Error;
+    }
+    AtResult result = at_exchange(cmd, terminator, timeoutMs, data, dataLen);
+    give_slot();
+    return result;
 }
 
 bool cellular_init() {
+    _atLock = xSemaphoreCreateMutex();
+    _cmdSlot = xSemaphoreCreateBinary();
+    _cmdDone = xSemaphoreCreateBinary();
+    _httpAction = xSemaphoreCreateBinary();
+    xSemaphoreGive(_cmdSlot);
+    at_engine_init(&_at, on_line, nullptr);
+
+    Serial2.setRxBufferSize(CELLULAR_RX_BUFFER_BYTES);
     Serial2.begin(CELLULAR_BAUD_RATE, SERIAL_8N1, CELLULAR_RX_PIN, CELLULAR_TX_PIN);
+    xTaskCreatePinnedToCore(modem_task, "modem", CELLULAR_TASK_STACK, nullptr,
+                            CELLULAR_TASK_PRIORITY, &_modemTask, 0);
+    Serial2.onReceive([]() { xTaskNotifyGive(_modemTask); });
+
+#if CELLULAR_PPP_DIRECT
+    Serial.println("[OK] Cellular UART wired straight to a PPP peer (no modem)");
+    return true;
+#else
+
     delay(2000);
 
-    if (!sendAT("AT", "OK", 3000)) {
-        Serial.println("[CELL] Modem not responding");
-        return false;
+    char cmd[96];
+    if (at_command("AT", nullptr, 3000) != AtResult::Ok) {
+        // Still on the faster rate from a previous boot?
+        Serial2.updateBaudRate(CELLULAR_DATA_BAUD_RATE);
+        if (at_command("AT", nullptr, 3000) != AtResult::Ok) {
+            Serial.println("[CELL] Modem not responding");
+            return false;
+        }
+    } else if (CELLULAR_DATA_BAUD_RATE != CELLULAR_BAUD_RATE) {
+        // PPP throughput is bounded by the UART, so run it as fast as the modem allows
+        snprintf(cmd, sizeof(cmd), "AT+IPR=%d", CELLULAR_DATA_BAUD_RATE);
+        if (at_command(cmd, nullptr, 3000) == AtResult::Ok) {
+            Serial2.flush();
+            Serial2.updateBaudRate(CELLULAR_DATA_BAUD_RATE);
+        }
     }
+    at_command("ATE0", nullptr, 3000);
 
-    if (!sendAT("AT+CPIN?", "READY", CELLULAR_TIMEOUT_MS)) {
+    if (at_command("AT+CPIN?", nullptr, CELLULAR_TIMEOUT_MS) != AtResult::Ok || !_simReady) {
         Serial.println("[CELL] SIM not ready");
         return false;
     }
 
-    String apnCmd = String("AT+CGDCONT=1,\"IP\",\"") + CELLULAR_APN + "\"";
-    sendAT(apnCmd.c_str(), "OK", 3000);
+    snprintf(cmd, sizeof(cmd), "AT+CGDCONT=1,\"IP\",\"%s\"", CELLULAR_APN);
+    at_command(cmd, nullptr, 3000);
 
-    Serial.println("[OK] Cellular initialized");
+    // Report registration changes unsolicited, then take the current state
+    at_command("AT+CREG=1;+CEREG=1", nullptr, 3000);
+    at_command("AT+CSQ;+CREG?;+CEREG?", nullptr, 3000);
+
+    Serial.printf("[OK] Cellular initialized (%s, CSQ %d)\n",
+                  cellular_is_registered() ? "registered" : "not registered", (int)_rssi);
     return true;
+#endif
 }
 
 bool cellular_is_registered() {
-    Serial2.println("AT+CREG?");
-    String response = "";
+#if CELLULAR_PPP_DIRECT
+    return true;
+#else
+    return registered_stat(_cregStat) || registered_stat(_ceregStat);
+#endif
+}
+
+int cellular_signal_quality() {
+    return _rssi;
+}
+
+// ---- PPP data mode ----
+
+// lwIP's tcpip thread
+static size_t uart_write(const uint8_t* data, size_t len) {
+    return Serial2.write(data, len);
+}
+
+// Back to command mode after a dial whose PPP session never came up
+static void hang_up() {
+    esp_task_wdt_reset();
+    vTaskDelay(pdMS_TO_TICKS(1100));
+    Serial2.print("+++");
+    vTaskDelay(pdMS_TO_TICKS(1100));
+    at_exchange("ATH", nullptr, 3000);
+}
+
+// ppp_link_wait_up() in watchdog-sized slices
+static bool wait_ppp_up(unsigned long timeoutMs) {
     unsigned long start = millis();
-    while (millis() - start < 3000) {
-        while (Serial2.available()) {
-            response += (char)Serial2.read();
-        }
-        if (response.indexOf("+CREG:") >= 0) break;
-        delay(10);
+    while (millis() - start < timeoutMs) {
+        if (ppp_link_wait_up(WDT_FEED_SLICE_MS)) return true;
+        if (!ppp_link_is_open()) return false;
+        esp_task_wdt_reset();
     }
-    // +CREG: 0,1 (registered home) or +CREG: 0,5 (roaming)
-    return (response.indexOf(",1") >= 0 || response.indexOf(",5") >= 0);
+    return false;
 }
 
-int cellular_http_post(const char* url, const char* contentType, const uint8_t* body, size_t len) {
-    // AT+HTTPINIT
-    if (!sendAT("AT+HTTPINIT", "OK", 3000)) return -1;
+bool cellular_data_start() {
+    if (_dataMode) return ppp_link_is_up();
+    // Held until data mode ends, so no AT command lands in the PPP stream
+    if (!take_slot(CELLULAR_TIMEOUT_MS)) return false;
 
-    // Set URL
-    String urlCmd = String("AT+HTTPPARA=\"URL\",\"") + url + "\"";
-    if (!sendAT(urlCmd.c_str(), "OK", 3000)) {
-        sendAT("AT+HTTPTERM", "OK", 3000);
-        return -1;
+#if !CELLULAR_PPP_DIRECT
+    if (at_exchange("ATD*99#", "CONNECT", CELLULAR_TIMEOUT_MS) != AtResult::Ok) {
+        give_slot();
+        return false;
     }
+#endif
+    // From here the line carries PPP: received bytes go to the link (which
+    // drops them until it is open), never to the AT engine
+    _dialing = true;
+    _dataMode = true;
+    if (!ppp_link_open(uart_write)) {
+        _dataMode = false;
+        _dialing = false;
+#if !CELLULAR_PPP_DIRECT
+        hang_up();
+#endif
+        give_slot();
+        return false;
+    }
+    _dialing = false;
 
-    // Set content type
-    String ctCmd = String("AT+HTTPPARA=\"CONTENT\",\"") + contentType + "\"";
-    sendAT(ctCmd.c_str(), "OK", 3000);
-
-    // Send data
-    String dataCmd = String("AT+HTTPDATA=") + len + ",10000";
-    if (!sendAT(dataCmd.c_str(), "DOWNLOAD", 3000)) {
-        sendAT("AT+HTTPTERM", "OK", 3000);
-        return -1;
+    if (!wait_ppp_up(CELLULAR_PPP_CONNECT_TIMEOUT_MS)) {
+        Serial.println("[CELL] PPP negotiation failed");
+        esp_task_wdt_reset();
+        ppp_link_close(CELLULAR_PPP_CLOSE_TIMEOUT_MS);
+        esp_task_wdt_reset();
+        // The modem task leaves data mode and releases the slot; wait for it
+        if (take_slot(CELLULAR_PPP_CLOSE_TIMEOUT_MS)) {
+#if !CELLULAR_PPP_DIRECT
+            hang_up();
+#endif
+            give_slot();
+        }
+        return false;
     }
+    ppp_link_set_default();
+    Serial.printf("[CELL] Data mode up at %d baud\n", (int)Serial2.baudRate());
+    return true;
+}
 
-    Serial2.write(body, len);
-    delay(500);
+void cellular_data_stop() {
+    if (_dataMode) ppp_link_close(CELLULAR_PPP_CLOSE_TIMEOUT_MS);
+}
 
-    // POST
-    if (!sendAT("AT+HTTPACTION=1", "+HTTPACTION:", CELLULAR_TIMEOUT_MS)) {
-        sendAT("AT+HTTPTERM", "OK", 3000);
+bool cellular_data_up() {
+    return _dataMode && ppp_link_is_up();
+}
+
+// ---- AT HTTP (CELLULAR_USE_PPP 0) ----
+
+// Between HTTPINIT and HTTPTERM
+static int http_post(const char* url, const char* contentType, const uint8_t* body, size_t len) {
+    char cmd[320];
+    snprintf(cmd, sizeof(cmd), "AT+HTTPPARA=\"URL\",\"%s\"", url);
+    if (at_command(cmd, nullptr, 3000) != AtResult::Ok) return -1;
+
+    snprintf(cmd, sizeof(cmd), "AT+HTTPPARA=\"CONTENT\",\"%s\"", contentType);
+    at_command(cmd, nullptr, 3000);
+
+    snprintf(cmd, sizeof(cmd), "AT+HTTPDATA=%u,10000", (unsigned)len);
+    if (at_command(cmd, "DOWNLOAD", 3000) != AtResult::Ok) return -1;
+    if (at_command(nullptr, nullptr, 10000, body, len) != AtResult::Ok) return -1;
+
+    xSemaphoreTake(_httpAction, 0);
+    if (at_command("AT+HTTPACTION=1", nullptr, 3000) != AtResult::Ok) return -1;
+    // The status arrives later as +HTTPACTION: <method>,<status>,<length>
+    if (!take_fed(_httpAction, CELLULAR_TIMEOUT_MS)) {
+        Serial.println("[CELL] No +HTTPACTION result");
         return -1;
     }
+    return _httpStatus;
+}
 
-    // Read response status from Serial2 buffer
-    String resp = "";
-    unsigned long start = millis();
-    while (millis() - start < 2000) {
-        while (Serial2.available()) resp += (char)Serial2.read();
-        delay(10);
+int cellular_http_post(const char* url, const char* contentType, const uint8_t* body, size_t len) {
+    if (at_command("AT+HTTPINIT", nullptr, 3000) != AtResult::Ok) {
+        // A session left over from an aborted request
+        at_command("AT+HTTPTERM", nullptr, 3000);
+        if (at_command("AT+HTTPINIT", nullptr, 3000) != AtResult::Ok) return -1;
     }
-
-    sendAT("AT+HTTPTERM", "OK", 3000);
-
-    // Parse status from "+HTTPACTION: 1,200,..." or "+HTTPACTION:1,204,..."
-    int statusStart = resp.indexOf(",");
-    if (statusStart < 0) return -1;
-    int statusEnd = resp.indexOf(",", statusStart + 1);
-    if (statusEnd < 0) statusEnd = resp.length();
-    String statusStr = resp.substring(statusStart + 1, statusEnd);
-    statusStr.trim();
-    return statusStr.toInt();
+    int status = http_post(url, contentType, body, len);
+    at_command("AT+HTTPTERM", nullptr, 3000);
+    return status;
 }
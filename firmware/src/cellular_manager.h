@@ -1,7 +1,34 @@
 #pragma once
 
+// A7670E modem on UART2. A modem task on core 0 drains the UART and runs
+// every received line through the AT engine (at_engine.h): command results
+// wake the waiting caller, and registration (+CREG/+CEREG), signal (+CSQ)
+// and +HTTPACTION lines update cached state. Status is refreshed in the
+// background, so the queries below never touch the UART.
+//
+// With CELLULAR_USE_PPP the modem is dialed into PPP data mode (ppp_link.h)
+// and carries ordinary sockets; the line belongs to PPP until the link is
+// closed, and cached status is not refreshed meanwhile.
+
 #include <Arduino.h>
 
 bool cellular_init();
+
+// Cached; registered on the home network or roaming
 bool cellular_is_registered();
+
+// Cached +CSQ RSSI (0-31, 99 = unknown)
+int cellular_signal_quality();
+
+// Dial (ATD*99#) and bring up PPP, making it the default route. Blocks the
+// calling task (the uplink) for up to CELLULAR_PPP_CONNECT_TIMEOUT_MS.
+bool cellular_data_start();
+
+// Terminate PPP; the modem returns to command mode.
+void cellular_data_stop();
+
+bool cellular_data_up();
+
+// AT+HTTP path for builds without PPP. Blocks the calling task (the uplink)
+// for the duration of the request.
 int cellular_http_post(const char* url, const char* contentType, const uint8_t* body, size_t len);
@@ -24,12 +24,55 @@
 #define API_APPROACH_ENDPOINT "/api/v1/doors/approach-photo"
 #define API_KEY ""  // Set if door configuration has API key
 #define API_TIMEOUT_MS 10000
+// Static pool for the API's JSON documents: access responses are parsed
+// into it (only the fields the firmware reads are kept) and firmware events
+// built in it, so neither touches the heap. Holds one ArduinoJson slot pool
+// plus the strings.
+#define API_JSON_POOL_BYTES 4096
 // Set to 1 to skip server certificate verification (dev only).
 // For production, set to 0 and provide API_CA_CERT below.
 #define API_INSECURE_TLS 1
 // PEM-encoded CA certificate for server verification (when API_INSECURE_TLS=0).
 // Replace with your server's CA root certificate.
 #define API_CA_CERT ""
+// Keep one TLS connection to the API open between requests and reconnect it
+// in the background (with session resumption) so access requests skip the
+// handshake. Recycled after API_KEEPALIVE_IDLE_MS idle, comfortably inside
+// Kestrel's default 130s keep-alive timeout.
+#define API_CONNECTION_KEEP_WARM 1
+// Upper bound on simultaneous TLS connections (each holds ~20-40 KB of
+// internal heap while open). Extra slots only help if requests are issued
+// from more than one task.
+#define API_CONNECTION_POOL_SIZE 1
+#define TRANSPORT_STATS_LOG_INTERVAL_MS 300000
+#define API_KEEPALIVE_IDLE_MS 60000
+#define API_WARM_RETRY_INTERVAL_MS 30000  // after a failed background connect
+// Send the approach photo and the access request as one upload carrying the
+// detector score and motion counts: one round trip per trigger instead of
+// two, and the server skips identification for frames that aren't a dog.
+// Speculative attempts always upload them separately.
+#define COMBINED_ACCESS_UPLOAD 1
+
+// ===== Task pipeline =====
+// Core 1: sensing -> vision -> actuation. None of these touch the network.
+// Core 0: uplink (every HTTP call, reconnect and queue flush), alongside the
+// WiFi/BT stacks. Arduino's loopTask (core 1, priority 1) only services BLE.
+#define SENSOR_EVENTS_TASK_PRIORITY 6  // edge debounce/dispatch; runs for microseconds
+#define ACTUATION_TASK_PRIORITY 5   // door safety preempts everything else
+#define SENSING_TASK_PRIORITY 4
+#define VISION_TASK_PRIORITY 3
+#define UPLINK_TASK_PRIORITY 1
+#define SENSOR_EVENTS_TASK_STACK 3072
+#define ACTUATION_TASK_STACK 4096
+#define SENSING_TASK_STACK 3072
+#define VISION_TASK_STACK 12288     // TFLite Invoke + preprocessing
+#define UPLINK_TASK_STACK 12288     // TLS handshake + JPEG encode + JSON parse
+#define SENSING_EVENT_QUEUE_DEPTH 4
+#define PIPELINE_TRIGGER_QUEUE_DEPTH 1  // one detection in flight; extras are dropped
+#define PIPELINE_DOOR_QUEUE_DEPTH 4
+#define UPLINK_QUEUE_DEPTH 8
+#define UPLINK_MAINTENANCE_INTERVAL_MS 1000  // reconnect/flush/power checks when idle
+#define BLE_POLL_INTERVAL_MS 50
 
 // ===== Pin Definitions =====
 // Radar sensor (RCWL-0516)
@@ -73,22 +116,61 @@
 #define HREF_GPIO_NUM     23
 #define PCLK_GPIO_NUM     22
 
+// Capture raw RGB565 frames so inference needs no JPEG decode; uploads are
+// JPEG-encoded in software only when an image is actually sent. Requires
+// PSRAM (falls back to sensor JPEG without it). Set to 0 for sensor JPEG.
+#define CAMERA_CAPTURE_RAW 1
+#define CAMERA_UPLOAD_JPEG_QUALITY 80  // software encoder, 1-100 (higher = better)
+
 // ===== Sensor Thresholds =====
 #define ULTRASONIC_TRIGGER_DISTANCE_CM 50  // Trigger when animal within 50cm
 #define ULTRASONIC_MAX_DISTANCE_CM 400
+#define ULTRASONIC_PING_INTERVAL_MS 60    // HC-SR04 needs >=60ms between pings
+#define ULTRASONIC_FILTER_WINDOW_MS 400    // estimate from the last ~6 pings
+#define ULTRASONIC_MIN_SAMPLES 3           // consistent echoes needed for a reading
+#define ULTRASONIC_OUTLIER_CM 15.0f        // farther than this from the median = bad echo
+
+// Edge interrupts on radar, IR beam and reed switch (sensor_events.h)
+#define SENSOR_RADAR_DEBOUNCE_MS 0         // RCWL-0516 output is driven, no bounce
+#define SENSOR_IR_BEAM_DEBOUNCE_MS 2       // short: the close interlock waits on it
+#define SENSOR_REED_DEBOUNCE_MS 20
+#define SENSOR_EVENTS_EDGE_QUEUE_DEPTH 32
+#define SENSOR_EVENTS_MAX_SUBSCRIBERS 4
+#define SENSOR_EVENTS_RESYNC_MS 1000       // re-read levels this often if no edge arrives
 
 // ===== Door Configuration =====
 #define DOOR_OPEN_TIME_MS 500       // Time to run actuator to open
-#define DOOR_CLOSE_TIME_MS 500      // Time to run actuator to close
+#define DOOR_CLOSE_TIMEOUT_MS 1500  // Closing ends at the reed switch; fault if it never does
+#define DOOR_MOTION_TICK_MS 5        // travel timer while the motor runs
 #define DOOR_AUTO_CLOSE_DELAY_MS 10000  // Wait before auto-closing
-#define DOOR_SAFETY_CHECK_INTERVAL_MS 100
+#define DOOR_SAFETY_CHECK_INTERVAL_MS 100  // actuation task's timer checks
 
 // ===== Detection Configuration =====
 #define DETECTION_CONFIDENCE_THRESHOLD 0.7f
 #define DETECTION_COOLDOWN_MS 5000  // Min time between detection events
 
+// Motion prefilter: skip inference and uploads when the scene hasn't
+// changed since the last trigger (see motion_filter.h)
+#define MOTION_FILTER_ENABLED 1
+#define MOTION_CELL_THRESHOLD 20         // grayscale levels
+#define MOTION_BLOCK_PERCENT 30          // % of a block's cells that must change
+#define MOTION_MIN_CHANGED_BLOCKS 2      // of 48
+#define MOTION_LEARN_SHIFT 1             // background absorbs 1/2 of each frame
+#define MOTION_MAX_CONSECUTIVE_REJECTS 5 // then let one frame through anyway
+
 // ===== TFLite Configuration =====
+// Upper bound: detection_init() measures what the model actually needs in an
+// arena this size, then allocates only that plus the margin
 #define TFLITE_ARENA_SIZE 96 * 1024  // 96KB tensor arena
+#define TFLITE_ARENA_MARGIN 1024    // headroom over the measured size
+
+// ===== Scratch Arena =====
+// Per-detection scratch (JPEG decodes, resampling, upload staging) comes
+// from fixed PSRAM blocks checked out per event instead of the heap (see
+// phase_arena.h). The vision block also holds the tensor arena above.
+// High-water marks are logged as [ARENA] whenever they rise.
+#define VISION_SCRATCH_BYTES (64 * 1024)  // QVGA: the full-scale dHash decode peaks at ~28 KB
+#define UPLINK_SCRATCH_BYTES (96 * 1024)  // 160x120 RGB staging for the reduced JPEG plus its decode
 
 // ===== Power Monitor (voltage divider R1=10kΩ, R2=3.3kΩ) =====
 // IMPORTANT: On AI-Thinker ESP32-CAM, GPIO 34/35 are camera data lines (Y8/Y9).
@@ -107,9 +189,27 @@
 // ===== Cellular (A7670E on UART2) =====
 #define CELLULAR_RX_PIN 16
 #define CELLULAR_TX_PIN 17
-#define CELLULAR_BAUD_RATE 115200
-#define CELLULAR_TIMEOUT_MS 15000
+#define CELLULAR_BAUD_RATE 115200         // modem's power-on rate
+#define CELLULAR_DATA_BAUD_RATE 921600    // switched to with AT+IPR; bounds PPP throughput
+#define CELLULAR_TIMEOUT_MS 15000         // SIM check, +HTTPACTION result
+#define CELLULAR_COMMAND_TIMEOUT_MS 3000   // background status queries
+#define CELLULAR_STATUS_INTERVAL_MS 30000  // +CSQ/+CREG refresh; changes also arrive unsolicited
+#define CELLULAR_RX_BUFFER_BYTES 4096      // ~40 ms of PPP at the data rate
+#define CELLULAR_TASK_PRIORITY 2           // core 0, above uplink so replies are parsed promptly
+#define CELLULAR_TASK_STACK 3072
 #define CELLULAR_APN "your.apn.here"
+// PPP data mode: cellular carries the same socket/TLS transport as WiFi
+// (keep-alive, session resumption, image uploads). 0 = modem AT+HTTP, JSON only.
+#define CELLULAR_USE_PPP 1
+#define CELLULAR_PPP_CONNECT_TIMEOUT_MS 30000
+#define CELLULAR_PPP_CLOSE_TIMEOUT_MS 5000
+#define CELLULAR_PPP_RETRY_INTERVAL_MS 30000
+// 1 = UART2 goes straight to a PPP peer instead of a modem (no AT, no SIM),
+// for testing the link against pppd on a Linux host through a USB-UART:
+//   sudo pppd /dev/ttyUSB0 115200 local noauth nodetach persist passive
+//            10.64.64.1:10.64.64.2 ms-dns 1.1.1.1
+// plus IP forwarding/NAT on the host so the board reaches the API server.
+#define CELLULAR_PPP_DIRECT 0
 
 // ===== BLE (ESP32 built-in) =====
 #define BLE_SERVICE_UUID      "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
@@ -120,7 +220,69 @@
 #define BLE_PASSKEY 123456  // Change this! 6-digit numeric passkey for BLE pairing
 
 // ===== Offline Queue =====
-#define OFFLINE_QUEUE_MAX_EVENTS 50
+// Ring log of preallocated slots; when full the oldest event is overwritten
+#define OFFLINE_QUEUE_MAX_EVENTS 512       // ~128KB of LittleFS
+#define OFFLINE_QUEUE_SLOT_BYTES 256       // per event, including a 12-byte record header
+#define OFFLINE_QUEUE_SEGMENT_BYTES 4096   // one LittleFS block per segment file
+#define OFFLINE_QUEUE_BATCH_MAX_EVENTS 32   // events per batch request (server accepts up to 100)
+#define OFFLINE_QUEUE_BATCH_MAX_BYTES 4096  // batch request body limit
 #define API_FIRMWARE_EVENT_ENDPOINT "/api/v1/doors/firmware-event"
+#define API_FIRMWARE_EVENT_BATCH_ENDPOINT "/api/v1/doors/firmware-events/batch"
+
+// ===== Image Spool =====
+// JPEGs that couldn't be uploaded, kept on LittleFS until WiFi returns
+#define IMAGE_SPOOL_MAX_BYTES (384 * 1024)  // oldest evicted past this
+#define IMAGE_SPOOL_MAX_FILES 48
+
+// ===== Upload Payload Class =====
+// Image sent with each upload, chosen from measured link throughput:
+// full upload JPEG, a reduced JPEG, or a grayscale thumbnail plus its dHash.
+// When less than the full image is sent, the full frame is spooled and
+// backfilled as an approach photo once the link is fast again.
+#define PAYLOAD_FULL_MIN_BYTES_PER_SEC 40000     // QVGA upload JPEG in well under a second
+#define PAYLOAD_REDUCED_MIN_BYTES_PER_SEC 10000  // below this, thumbnails only
+#define PAYLOAD_HYSTERESIS_PERCENT 25            // margin needed to move back up a class
+#define PAYLOAD_ESTIMATE_STALE_MS 300000         // then re-probe at the transport's initial class
+#define PAYLOAD_CELLULAR_MAX_CLASS PayloadClass::Reduced  // metered: never send full frames live
+#define PAYLOAD_REDUCED_WIDTH 160
+#define PAYLOAD_REDUCED_HEIGHT 120
+#define PAYLOAD_REDUCED_JPEG_QUALITY 40
+#define PAYLOAD_THUMBNAIL_WIDTH 80
+#define PAYLOAD_THUMBNAIL_HEIGHT 60
+#define PAYLOAD_THUMBNAIL_JPEG_QUALITY 50
+
+// ===== Local Hash Matching =====
+// Enrolled-animal dHashes synced from the API; an allowed dog that matches
+// one opens the door at once, and the access request goes on for logging.
+#define LOCAL_GRANT_ENABLED 1
+#define API_HASH_TABLE_ENDPOINT "/api/v1/doors/hash-table"
+#define HASH_SYNC_INTERVAL_MS 600000       // also re-anchors the night-mode clock
+#define HASH_SYNC_RETRY_INTERVAL_MS 60000  // after a failed sync
+#define HASH_SYNC_RESPONSE_BYTES 8192      // ~64 enrolled photos
+// A local grant opens the door before the server has seen the frame, on a
+// hash the background dominates, so it needs a closer match than the
+// server's; anything further waits for the API
+#define LOCAL_GRANT_MAX_DISTANCE 3
+
+// ===== Decision Cache =====
+// A dog the API let in is let in again without a round trip if it comes
+// back to the same side within the TTL looking nearly the same and the
+// detector still sees a dog; the server gets an Entry/ExitGranted event
+// instead of an access request.
+// Off by default: the key is a whole-frame dHash, which the background
+// dominates, so any dog at this side within the TTL would get the last
+// grant without the server's per-animal rules (NotAllowed, curfews). Enable
+// only once the cache is keyed on something that identifies the animal.
+#define DECISION_CACHE_ENABLED 0
+#define DECISION_CACHE_TTL_MS 60000
+#define DECISION_CACHE_MAX_DISTANCE 6  // dHash bits; well inside the server's match
+
+// ===== Speculative Access =====
+// Capture and send the access request on the radar edge instead of after
+// the ultrasonic confirm, so the round trip overlaps the range check and
+// the dog detector; the door still opens only once all three pass. Radar
+// motion that never comes in range costs a request (logged by the API).
+#define SPECULATIVE_ACCESS_ENABLED 0
+#define SPECULATIVE_RANGE_WINDOW_MS 2000  // range must confirm within this of the radar edge
 
 #endif // CONFIG_H
@@ -0,0 +1,43 @@
+#include "debounce.h"
+
+void debounce_init(Debouncer* d, bool level, uint32_t settleUs) {
+    d->stable = level;
+    d->pending = false;
+    d->firstEdgeUs = 0;
+    d->lastEdgeUs = 0;
+    d->settleUs = settleUs;
+}
+
+void debounce_edge(Debouncer* d, uint32_t atUs) {
+    if (!d->pending) {
+        d->pending = true;
+        d->firstEdgeUs = atUs;
+    }
+    d->lastEdgeUs = atUs;
+}
+
+// Signed, so an edge stamped just after nowUs was read counts as not yet quiet
+static inline int32_t quiet_us(const Debouncer* d, uint32_t nowUs) {
+    return (int32_t)(nowUs - d->lastEdgeUs);
+}
+
+bool debounce_poll(Debouncer* d, bool level, uint32_t nowUs, uint32_t* changedAtUs) {
+    if (!d->pending) {
+        if (level == d->stable) return false;
+        debounce_edge(d, nowUs);
+    }
+    if (quiet_us(d, nowUs) < (int32_t)d->settleUs) return false;
+
+    d->pending = false;
+    if (level == d->stable) return false;
+    d->stable = level;
+    *changedAtUs = d->firstEdgeUs;
+    return true;
+}
+
+uint32_t debounce_wait_us(const Debouncer* d, uint32_t nowUs) {
+    if (!d->pending) return DEBOUNCE_IDLE;
+    int32_t quiet = quiet_us(d, nowUs);
+    if (quiet < 0) return d->settleUs;
+    return (uint32_t)quiet >= d->settleUs ? 0 : d->settleUs - (uint32_t)quiet;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Debouncer for one digital input fed by edge interrupts. Raw edges are
+// recorded as they arrive; once the line has been quiet for settleUs the
+// level is sampled, and only a level different from the last reported one
+// becomes an event. The event carries the time of the first edge of the
+// burst, so contact bounce doesn't add to measured latency, and a glitch
+// that settles back to the old level produces nothing.
+//
+// A level that differs from the reported one without any recorded edge
+// (an edge lost to a full queue) is treated as an edge at the time it is
+// noticed, so a missed interrupt costs one resync instead of a stuck state.
+//
+// Portable; builds under the `native` env.
+
+#include <stdint.h>
+
+#define DEBOUNCE_IDLE UINT32_MAX
+
+struct Debouncer {
+    bool stable;           // last reported level
+    bool pending;          // edges seen since, waiting for the line to settle
+    uint32_t firstEdgeUs;  // first edge of the pending burst
+    uint32_t lastEdgeUs;
+    uint32_t settleUs;
+};
+
+void debounce_init(Debouncer* d, bool level, uint32_t settleUs);
+
+// Record a raw edge (from the ISR's timestamp).
+void debounce_edge(Debouncer* d, uint32_t atUs);
+
+// Sample the current level. Returns true when it is a settled change and
+// sets *changedAtUs to the first edge of the burst; d->stable is the new level.
+bool debounce_poll(Debouncer* d, bool level, uint32_t nowUs, uint32_t* changedAtUs);
+
+// Microseconds until debounce_poll() can next report a change; 0 if it can
+// now, DEBOUNCE_IDLE if nothing is pending.
+uint32_t debounce_wait_us(const Debouncer* d, uint32_t nowUs);
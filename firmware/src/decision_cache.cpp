@@ -0,0 +1,84 @@
+#include "decision_cache.h"
+#include "image_hash.h"
+
+#include <string.h>
+
+void decision_cache_init(DecisionCache* cache, uint32_t ttlMs, uint8_t maxDistance) {
+    memset(cache, 0, sizeof(*cache));
+    cache->ttlMs = ttlMs;
+    cache->maxDistance = maxDistance;
+}
+
+static bool expired(const DecisionCache* cache, const DecisionCacheEntry& e, uint32_t nowMs) {
+    return nowMs - e.grantedAtMs >= cache->ttlMs;
+}
+
+void decision_cache_store(DecisionCache* cache, const char* side, uint64_t hash,
+                          int32_t animalId, const char* name, uint32_t nowMs) {
+    DecisionCacheEntry* slot = nullptr;
+    for (DecisionCacheEntry& e : cache->entries) {
+        if (e.used && e.animalId == animalId && strcmp(e.side, side) == 0) {
+            slot = &e;
+            break;
+        }
+    }
+    if (!slot) {
+        for (DecisionCacheEntry& e : cache->entries) {
+            if (!e.used || expired(cache, e, nowMs)) {
+                slot = &e;
+                break;
+            }
+        }
+    }
+    if (!slot) {
+        slot = &cache->entries[0];
+        for (DecisionCacheEntry& e : cache->entries) {
+            if (nowMs - e.grantedAtMs > nowMs - slot->grantedAtMs) slot = &e;
+        }
+    }
+
+    memset(slot, 0, sizeof(*slot));
+    slot->used = true;
+    strncpy(slot->side, side, sizeof(slot->side) - 1);
+    slot->hash = hash;
+    slot->animalId = animalId;
+    strncpy(slot->name, name ? name : "", sizeof(slot->name) - 1);
+    slot->grantedAtMs = nowMs;
+}
+
+bool decision_cache_lookup(DecisionCache* cache, const char* side, uint64_t hash,
+                           uint32_t nowMs, DecisionCacheEntry* out) {
+    cache->stats.lookups++;
+
+    const DecisionCacheEntry* best = nullptr;
+    int bestDistance = cache->maxDistance + 1;
+    for (DecisionCacheEntry& e : cache->entries) {
+        if (!e.used) continue;
+        if (expired(cache, e, nowMs)) {
+            e.used = false;
+            continue;
+        }
+        if (strcmp(e.side, side) != 0) continue;
+        int d = dhash_distance(hash, e.hash);
+        if (d < bestDistance) {
+            best = &e;
+            bestDistance = d;
+        }
+    }
+    if (!best) return false;
+
+    cache->stats.hits++;
+    if (out) *out = *best;
+    return true;
+}
+
+void decision_cache_forget(DecisionCache* cache, int32_t animalId) {
+    for (DecisionCacheEntry& e : cache->entries) {
+        if (e.used && e.animalId == animalId) e.used = false;
+    }
+}
+
+uint32_t decision_cache_hit_percent(const DecisionCache* cache) {
+    if (cache->stats.lookups == 0) return 0;
+    return (uint32_t)((uint64_t)cache->stats.hits * 100 / cache->stats.lookups);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+// Short-lived memory of the API's recent grants, so a dog that walks away
+// and comes back is let in again without inference or a round trip.
+//
+// One entry per side and animal: the dHash of the frame the API granted,
+// stamped with when it answered. A new frame on the same side within
+// maxDistance bits of a live entry (the nearest one, if several) is a hit.
+// Entries expire ttlMs after the grant; a hit does not extend them, so the
+// API confirms every animal at least once per TTL. Only grants are kept.
+//
+// Portable; builds under the `native` env. Not thread-safe: callers on
+// more than one task hold their own lock.
+
+#include <stdint.h>
+
+#define DECISION_CACHE_CAPACITY 4
+#define DECISION_CACHE_NAME_LEN 24
+#define DECISION_CACHE_SIDE_LEN 8
+
+struct DecisionCacheEntry {
+    bool used;
+    char side[DECISION_CACHE_SIDE_LEN];
+    uint64_t hash;
+    int32_t animalId;
+    char name[DECISION_CACHE_NAME_LEN];
+    uint32_t grantedAtMs;
+};
+
+struct DecisionCacheStats {
+    uint32_t lookups;
+    uint32_t hits;
+};
+
+struct DecisionCache {
+    uint32_t ttlMs;
+    uint8_t maxDistance;
+    DecisionCacheEntry entries[DECISION_CACHE_CAPACITY];
+    DecisionCacheStats stats;
+};
+
+void decision_cache_init(DecisionCache* cache, uint32_t ttlMs, uint8_t maxDistance);
+
+// Remember that the API granted `animalId` on `side` for a frame hashing to
+// `hash`. Replaces that animal's entry on the side, else a free or the
+// oldest slot.
+void decision_cache_store(DecisionCache* cache, const char* side, uint64_t hash,
+                          int32_t animalId, const char* name, uint32_t nowMs);
+
+// Copy the matching live entry into `out` and return true on a hit.
+// Counts the lookup in `stats` either way.
+bool decision_cache_lookup(DecisionCache* cache, const char* side, uint64_t hash,
+                           uint32_t nowMs, DecisionCacheEntry* out);
+
+// Drop every entry for `animalId`, e.g. after the API denied it.
+void decision_cache_forget(DecisionCache* cache, int32_t animalId);
+
+// Hits as a percentage of lookups (0 before the first lookup).
+uint32_t decision_cache_hit_percent(const DecisionCache* cache);
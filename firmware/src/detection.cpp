@@ -1,40 +1,68 @@
 #include "detection.h"
 #include "config.h"
+#include "image_preprocess.h"
+#include "perf_stats.h"
 
 // TFLite Micro includes
 #include <TensorFlowLite_ESP32.h>
-#include "tensorflow/lite/micro/all_ops_resolver.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 #include "tensorflow/lite/micro/micro_error_reporter.h"
 
 // Model data (placeholder - replace with trained model)
 #include "../model/dog_detect_model.h"
+// Only the model's kernels; generated at build time by scripts/gen_op_resolver.py
+#include "model_op_resolver.h"
+
+#include <new>
 
 // TFLite globals
-static tflite::AllOpsResolver resolver;
+static ModelOpResolver resolver;
 static const tflite::Model* model = nullptr;
 static tflite::MicroInterpreter* interpreter = nullptr;
+static tflite::MicroErrorReporter micro_error_reporter;
+// The interpreter is built twice (see detection_init), so it lives here
+alignas(tflite::MicroInterpreter) static uint8_t interpreter_storage[sizeof(tflite::MicroInterpreter)];
 static TfLiteTensor* input_tensor = nullptr;
 static TfLiteTensor* output_tensor = nullptr;
 
-// Tensor arena (allocated in PSRAM if available)
+// Tensor arena (allocated in PSRAM if available), reserved at the bottom
+// of the vision task's scratch arena
 static uint8_t* tensor_arena = nullptr;
-static const int kTensorArenaSize = TFLITE_ARENA_SIZE;
+static PhaseArena _arena;
 
-bool detection_init() {
-    // Allocate tensor arena in PSRAM for better performance
-    if (psramFound()) {
-        tensor_arena = (uint8_t*)ps_malloc(kTensorArenaSize);
-    } else {
-        tensor_arena = (uint8_t*)malloc(kTensorArenaSize);
-    }
+PhaseArena* detection_arena() {
+    return &_arena;
+}
 
-    if (!tensor_arena) {
-        Serial.println("Failed to allocate tensor arena");
-        return false;
-    }
+static void* alloc_block(size_t bytes) {
+    return psramFound() ? ps_malloc(bytes) : malloc(bytes);
+}
 
+static void destroy_interpreter() {
+    if (interpreter) interpreter->~MicroInterpreter();
+    interpreter = nullptr;
+}
+
+static bool build_interpreter(uint8_t* arena, size_t arenaSize) {
+    destroy_interpreter();
+    interpreter = new (interpreter_storage)
+        tflite::MicroInterpreter(model, resolver, arena, arenaSize, &micro_error_reporter);
+    return interpreter->AllocateTensors() == kTfLiteOk;
+}
+
+// Tensor arena bytes the model needs, measured by allocating its tensors in
+// a TFLITE_ARENA_SIZE probe. 0 if they don't fit.
+static size_t measure_arena() {
+    uint8_t* probe = (uint8_t*)alloc_block(TFLITE_ARENA_SIZE);
+    if (!probe) return 0;
+    size_t used = build_interpreter(probe, TFLITE_ARENA_SIZE) ? interpreter->arena_used_bytes() : 0;
+    destroy_interpreter();
+    free(probe);
+    return used;
+}
+
+bool detection_init() {
     // Load the model
     model = tflite::GetModel(dog_detect_model);
     if (model->version() != TFLITE_SCHEMA_VERSION) {
@@ -42,18 +70,49 @@ bool detection_init() {
                       model->version(), TFLITE_SCHEMA_VERSION);
         return false;
     }
+    if (!model_op_resolver_init(&resolver)) {
+        Serial.println("Op resolver registration failed");
+        return false;
+    }
 
-    // Build the interpreter
-    static tflite::MicroErrorReporter micro_error_reporter;
-    static tflite::MicroInterpreter static_interpreter(
-        model, resolver, tensor_arena, kTensorArenaSize, &micro_error_reporter);
-    interpreter = &static_interpreter;
+    size_t used = measure_arena();
+    if (!used) {
+        Serial.printf("AllocateTensors() failed in a %d byte arena\n", TFLITE_ARENA_SIZE);
+        return false;
+    }
+    size_t arenaSize = used + TFLITE_ARENA_MARGIN;
+    if (arenaSize > TFLITE_ARENA_SIZE) arenaSize = TFLITE_ARENA_SIZE;
+
+    // One block for the tensors and the per-event scratch
+    const size_t blockSize = arenaSize + PHASE_ARENA_ALIGN + VISION_SCRATCH_BYTES;
+    void* block = alloc_block(blockSize);
+    if (block) {
+        phase_arena_init(&_arena, block, blockSize);
+        tensor_arena = (uint8_t*)phase_arena_reserve(&_arena, arenaSize);
+    } else {
+        // Tensors alone; scratch then comes from the heap
+        Serial.println("No room for the scratch arena; using the heap");
+        tensor_arena = (uint8_t*)alloc_block(arenaSize);
+        phase_arena_init(&_arena, nullptr, 0);
+    }
+
+    if (!tensor_arena) {
+        Serial.println("Failed to allocate tensor arena");
+        return false;
+    }
 
-    TfLiteStatus allocate_status = interpreter->AllocateTensors();
-    if (allocate_status != kTfLiteOk) {
+    if (!build_interpreter(tensor_arena, arenaSize)) {
         Serial.println("AllocateTensors() failed");
         return false;
     }
+    Serial.printf("[TFLITE] tensor arena %u bytes (%u used, %u under TFLITE_ARENA_SIZE)\n",
+                  (unsigned)arenaSize, (unsigned)interpreter->arena_used_bytes(),
+                  (unsigned)(TFLITE_ARENA_SIZE - arenaSize));
+#if MODEL_OP_COUNT
+    Serial.printf("[TFLITE] %d kernels registered (the model's ops only)\n", MODEL_OP_COUNT);
+#else
+    Serial.println("[TFLITE] all kernels registered (model op list unreadable at build time)");
+#endif
 
     input_tensor = interpreter->input(0);
     output_tensor = interpreter->output(0);
@@ -77,28 +136,67 @@ float detection_run(camera_fb_t* fb) {
         return -1.0f;
     }
 
-    // The model expects a specific input size (e.g., 96x96x3 uint8).
-    // In a real implementation, you would:
-    // 1. Decode the JPEG to RGB
-    // 2. Resize to model input dimensions
-    // 3. Normalize pixel values
-    //
-    // For this placeholder, we fill the input tensor with the raw bytes
-    // (actual implementation needs JPEG decode + resize)
-    int input_size = input_tensor->bytes;
-    const uint8_t* src = fb->buf;
-    int src_len = fb->len;
-
-    for (int i = 0; i < input_size; i++) {
-        input_tensor->data.uint8[i] = src[i % src_len];
+    // Input tensor is [1, H, W, 3]. Raw frames are resampled directly;
+    // JPEG frames are decoded at a reduced IDCT scale straight into it.
+    if (input_tensor->dims->size != 4 || input_tensor->dims->data[3] != 3) {
+        Serial.println("Unsupported input tensor shape");
+        return -1.0f;
     }
+    int height = input_tensor->dims->data[1];
+    int width = input_tensor->dims->data[2];
+    if (input_tensor->bytes != (size_t)(width * height * 3)) {
+        Serial.println("Unsupported input tensor shape");
+        return -1.0f;
+    }
+
+    PreprocessStats stats;
+    bool prepared;
+    const char* format;
+    switch (fb->format) {
+        case PIXFORMAT_JPEG:
+            format = "JPEG";
+            prepared = preprocess_jpeg_to_rgb(fb->buf, fb->len, input_tensor->data.uint8,
+                                              width, height, &stats);
+            break;
+        case PIXFORMAT_RGB565:
+            format = "RGB565";
+            prepared = preprocess_raw_to_rgb(fb->buf, fb->width, fb->height, RawPixelFormat::Rgb565,
+                                             input_tensor->data.uint8, width, height, &stats);
+            break;
+        case PIXFORMAT_GRAYSCALE:
+            format = "GRAY";
+            prepared = preprocess_raw_to_rgb(fb->buf, fb->width, fb->height, RawPixelFormat::Gray8,
+                                             input_tensor->data.uint8, width, height, &stats);
+            break;
+        default:
+            Serial.printf("Unsupported frame format %d\n", fb->format);
+            return -1.0f;
+    }
+    if (!prepared) {
+        Serial.printf("%s preprocessing failed\n", format);
+        return -1.0f;
+    }
+    perf_record(PerfStage::Preprocess, stats.totalUs);
+
+    // Int8-quantized models expect pixels shifted to [-128, 127]
+    if (input_tensor->type == kTfLiteInt8) {
+        for (size_t i = 0; i < input_tensor->bytes; i++) {
+            input_tensor->data.int8[i] = (int8_t)(input_tensor->data.uint8[i] - 128);
+        }
+    }
+
+    Serial.printf("Preprocess: %dx%d %s at 1/%d -> %dx%d in %u us\n",
+                  stats.srcWidth, stats.srcHeight, format, stats.scaleDenom, width, height,
+                  (unsigned)stats.totalUs);
 
     // Run inference
+    uint32_t invoke_start = micros();
     TfLiteStatus invoke_status = interpreter->Invoke();
     if (invoke_status != kTfLiteOk) {
         Serial.println("Invoke failed");
         return -1.0f;
     }
+    perf_record(PerfStage::Inference, micros() - invoke_start);
 
     // Output tensor: [1, 2] = [not_dog, dog] probabilities
     // For uint8 quantized model, dequantize:
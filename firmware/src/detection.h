@@ -3,11 +3,17 @@
 
 #include <Arduino.h>
 #include "esp_camera.h"
+#include "phase_arena.h"
 
 // Initialize TFLite Micro interpreter with the dog detection model
 bool detection_init();
 
-// Run inference on a camera frame. Returns confidence score (0.0 - 1.0)
+// The vision task's per-event scratch arena. Shares one PSRAM block with
+// the tensor arena, which it holds as a reserved region.
+PhaseArena* detection_arena();
+
+// Run inference on a camera frame (JPEG, RGB565 or grayscale). Returns
+// confidence score (0.0 - 1.0)
 // that the image contains a dog. Returns -1.0 on error.
 float detection_run(camera_fb_t* fb);
 
@@ -1,91 +1,212 @@
 #include "door_control.h"
 #include "config.h"
 #include "sensors.h"
+#include "sensor_events.h"
+#include <esp_timer.h>
+#include <soc/gpio_reg.h>
+
+// Written from tasks, the timer and the IR/reed ISRs; always under _doorMux
+static volatile DoorState _state = DoorState::Closed;
+static volatile uint32_t _moveStartUs = 0;
+static portMUX_TYPE _doorMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Timer context only
+static DoorState _reported = DoorState::Closed;
+static DoorStateListener _listener = nullptr;
+static esp_timer_handle_t _tick = nullptr;
+
+static void tick(void*);
+static void IRAM_ATTR on_ir_beam(bool broken, uint32_t atUs);
+static void IRAM_ATTR on_reed_switch(bool closed, uint32_t atUs);
+
+// Register writes so the ISRs can drive the H-bridge directly
+static inline void IRAM_ATTR motor_set(bool in1, bool in2) {
+    REG_WRITE(in1 ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1u << PIN_MOTOR_IN1);
+    REG_WRITE(in2 ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1u << PIN_MOTOR_IN2);
+}
 
-static bool _door_open = false;
+static inline void IRAM_ATTR motor_forward() { motor_set(true, false); }
+static inline void IRAM_ATTR motor_reverse() { motor_set(false, true); }
+static inline void IRAM_ATTR motor_off() { motor_set(false, false); }
+
+// Caller holds _doorMux
+static inline void IRAM_ATTR start_move(DoorState moving, uint32_t nowUs) {
+    if (moving == DoorState::Opening) {
+        motor_forward();
+    } else {
+        motor_reverse();
+    }
+    _state = moving;
+    _moveStartUs = nowUs;
+}
 
 void door_init() {
     pinMode(PIN_MOTOR_IN1, OUTPUT);
     pinMode(PIN_MOTOR_IN2, OUTPUT);
-    door_stop();
-    _door_open = !door_is_closed();
+    motor_off();
+    _state = door_is_closed() ? DoorState::Closed : DoorState::Open;
+    _reported = _state;
+
+    esp_timer_create_args_t args = {};
+    args.callback = tick;
+    args.name = "door";
+    esp_timer_create(&args, &_tick);
+
+    sensor_events_set_isr_hook(SensorInput::IrBeam, on_ir_beam);
+    sensor_events_set_isr_hook(SensorInput::ReedSwitch, on_reed_switch);
 }
 
-static void motor_forward() {
-    digitalWrite(PIN_MOTOR_IN1, HIGH);
-    digitalWrite(PIN_MOTOR_IN2, LOW);
+void door_set_listener(DoorStateListener listener) {
+    _listener = listener;
 }
 
-static void motor_reverse() {
-    digitalWrite(PIN_MOTOR_IN1, LOW);
-    digitalWrite(PIN_MOTOR_IN2, HIGH);
+static void run_tick() {
+    // Already running while the door moves; that's fine
+    esp_timer_start_periodic(_tick, DOOR_MOTION_TICK_MS * 1000ULL);
 }
 
-void door_stop() {
-    digitalWrite(PIN_MOTOR_IN1, LOW);
-    digitalWrite(PIN_MOTOR_IN2, LOW);
+// ---- ISR hooks (sensor_events.h) ----
+
+static void IRAM_ATTR on_ir_beam(bool broken, uint32_t atUs) {
+    if (!broken) return;
+    portENTER_CRITICAL_ISR(&_doorMux);
+    // Something in the doorway: back off the way we came
+    if (_state == DoorState::Closing) start_move(DoorState::Opening, atUs);
+    portEXIT_CRITICAL_ISR(&_doorMux);
+}
+
+static void IRAM_ATTR on_reed_switch(bool closed, uint32_t) {
+    if (!closed) return;
+    portENTER_CRITICAL_ISR(&_doorMux);
+    // End of travel
+    if (_state == DoorState::Closing) {
+        motor_off();
+        _state = DoorState::Closed;
+    }
+    portEXIT_CRITICAL_ISR(&_doorMux);
+}
+
+// ---- Timer ----
+// Ends timed travel, backs up the ISRs by re-reading both sensors, and
+// reports state changes. Stops itself once the door is at rest.
+
+static void tick(void*) {
+    uint32_t now = micros();
+    bool beamBroken = ir_beam_broken();
+    bool reedClosed = door_is_closed();
+
+    portENTER_CRITICAL(&_doorMux);
+    uint32_t elapsedMs = (now - _moveStartUs) / 1000;
+    switch (_state) {
+        case DoorState::Opening:
+            if (elapsedMs >= DOOR_OPEN_TIME_MS) {
+                motor_off();
+                _state = DoorState::Open;
+            }
+            break;
+        case DoorState::Closing:
+            if (beamBroken) {
+                start_move(DoorState::Opening, now);
+            } else if (reedClosed) {
+                motor_off();
+                _state = DoorState::Closed;
+            } else if (elapsedMs >= DOOR_CLOSE_TIMEOUT_MS) {
+                motor_off();
+                _state = DoorState::Fault;
+            }
+            break;
+        default:
+            break;
+    }
+    DoorState state = _state;
+    // Under the lock, so a door_open()/door_close() can't start a move
+    // between this check and the stop
+    if (state != DoorState::Opening && state != DoorState::Closing) esp_timer_stop(_tick);
+    portEXIT_CRITICAL(&_doorMux);
+
+    if (state != _reported) {
+        DoorState from = _reported;
+        _reported = state;
+        if (_listener) _listener(from, state);
+    }
 }
 
+// ---- Commands ----
+
 bool door_open() {
-    if (_door_open) {
+    portENTER_CRITICAL(&_doorMux);
+    DoorState state = _state;
+    if (state != DoorState::Open && state != DoorState::Opening) {
+        start_move(DoorState::Opening, micros());
+    }
+    portEXIT_CRITICAL(&_doorMux);
+
+    if (state == DoorState::Open || state == DoorState::Opening) {
         Serial.println("Door already open");
         return true;
     }
-
     Serial.println("Opening door...");
     led_allow();
-    motor_forward();
-
-    unsigned long start = millis();
-    while (millis() - start < DOOR_OPEN_TIME_MS) {
-        // Safety: check IR beam during opening
-        delay(DOOR_SAFETY_CHECK_INTERVAL_MS);
-    }
-
-    door_stop();
-    _door_open = true;
-    Serial.println("Door opened");
+    run_tick();
     return true;
 }
 
 bool door_close() {
-    if (!_door_open) {
-        Serial.println("Door already closed");
-        return true;
-    }
-
-    Serial.println("Closing door...");
-
     // Safety interlock: don't close if IR beam is broken
     if (ir_beam_broken()) {
         Serial.println("IR beam broken - animal in doorway, aborting close");
         return false;
     }
 
-    motor_reverse();
-
-    unsigned long start = millis();
-    while (millis() - start < DOOR_CLOSE_TIME_MS) {
-        // Safety: if IR beam breaks during closing, stop immediately
-        if (ir_beam_broken()) {
-            door_stop();
-            Serial.println("IR beam broken during close - emergency stop");
-            // Reopen for safety
-            door_open();
-            return false;
+    bool closed = door_is_closed();
+    portENTER_CRITICAL(&_doorMux);
+    DoorState state = _state;
+    if (state != DoorState::Closed && state != DoorState::Closing) {
+        if (closed) {
+            // Already shut (e.g. pushed closed by hand)
+            motor_off();
+            _state = DoorState::Closed;
+        } else {
+            start_move(DoorState::Closing, micros());
         }
-        delay(DOOR_SAFETY_CHECK_INTERVAL_MS);
     }
+    portEXIT_CRITICAL(&_doorMux);
 
-    door_stop();
-    _door_open = false;
-    led_off();
-    Serial.println("Door closed");
+    if (state == DoorState::Closed || state == DoorState::Closing) {
+        Serial.println("Door already closed");
+        return true;
+    }
+    Serial.println("Closing door...");
+    run_tick();  // reports the change, and ends the travel if moving
     return true;
 }
 
+void door_stop() {
+    portENTER_CRITICAL(&_doorMux);
+    motor_off();
+    if (_state == DoorState::Opening || _state == DoorState::Closing) _state = DoorState::Fault;
+    portEXIT_CRITICAL(&_doorMux);
+    if (_tick) run_tick();
+}
+
+DoorState door_state() {
+    return _state;
+}
+
+const char* door_state_name(DoorState state) {
+    switch (state) {
+        case DoorState::Closed: return "closed";
+        case DoorState::Opening: return "opening";
+        case DoorState::Open: return "open";
+        case DoorState::Closing: return "closing";
+        case DoorState::Fault: return "fault";
+    }
+    return "?";
+}
+
 bool door_is_open() {
-    return _door_open;
+    DoorState state = _state;
+    return state == DoorState::Opening || state == DoorState::Open || state == DoorState::Closing;
 }
 
 void led_allow() {
@@ -3,18 +3,36 @@
 
 #include <Arduino.h>
 
+// Door actuator state machine. door_open()/door_close() only start the
+// motor and return; a periodic esp_timer ends the travel (open: after
+// DOOR_OPEN_TIME_MS; close: when the reed switch reports closed, or a fault
+// after DOOR_CLOSE_TIMEOUT_MS). The IR beam and reed switch act from their
+// edge ISRs: a beam break while closing reverses the motor immediately, and
+// the reed switch stops it the moment the door is shut.
+enum class DoorState : uint8_t { Closed, Opening, Open, Closing, Fault };
+
+// Called from the door timer (task context, not an ISR) after each state
+// change. Keep it short; e.g. hand the change to a queue.
+typedef void (*DoorStateListener)(DoorState from, DoorState to);
+
 void door_init();
+void door_set_listener(DoorStateListener listener);
 
-// Open the door (with safety checks)
+// Start opening (also recovers from Fault). Returns false only on
+// failure to start.
 bool door_open();
 
-// Close the door (with safety checks)
+// Start closing. Returns false if the IR beam is broken (animal in doorway).
 bool door_close();
 
-// Emergency stop
+// Emergency stop; a door stopped mid-travel is in Fault
 void door_stop();
 
-// Check if door is currently open
+DoorState door_state();
+const char* door_state_name(DoorState state);
+
+// Opening, open or closing. False when closed and in Fault (position
+// unknown), so detection keeps running and a grant can reopen the door.
 bool door_is_open();
 
 // Set status LEDs
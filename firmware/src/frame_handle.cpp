@@ -0,0 +1,186 @@
+#include "frame_handle.h"
+#include "camera.h"
+#include "config.h"
+#include "image_hash.h"
+#include "jpeg_decoder.h"
+
+// One slot per camera framebuffer (camera_fb_count(): 2 with PSRAM, 1
+// without): holding more frames than the driver owns would block
+// esp_camera_fb_get() forever.
+static const int kMaxFrameSlots = 2;
+
+struct Frame {
+    camera_fb_t* fb;
+    CameraJpeg jpeg;
+    bool jpegReady;
+    CameraJpeg reduced;
+    CameraJpeg thumbnail;
+    uint64_t thumbnailHash;
+    int refs;
+    unsigned long capturedAt;
+};
+
+static Frame _slots[kMaxFrameSlots];
+static portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t _jpegLock = nullptr;
+
+Frame* frame_capture() {
+    if (!_jpegLock) {
+        _jpegLock = xSemaphoreCreateMutex();
+    }
+
+    int slots = camera_fb_count();
+    if (slots > kMaxFrameSlots) slots = kMaxFrameSlots;
+
+    Frame* frame = nullptr;
+    portENTER_CRITICAL(&_mux);
+    for (int i = 0; i < slots; i++) {
+        if (_slots[i].refs == 0) {
+            frame = &_slots[i];
+            frame->refs = 1;  // claim before leaving the critical section
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&_mux);
+
+    if (!frame) {
+        Serial.println("[FRAME] All frame slots in use");
+        return nullptr;
+    }
+
+    frame->fb = camera_capture();
+    if (!frame->fb) {
+        portENTER_CRITICAL(&_mux);
+        frame->refs = 0;
+        portEXIT_CRITICAL(&_mux);
+        return nullptr;
+    }
+    frame->jpeg = {nullptr, 0, false};
+    frame->jpegReady = false;
+    frame->reduced = {nullptr, 0, false};
+    frame->thumbnail = {nullptr, 0, false};
+    frame->thumbnailHash = 0;
+    frame->capturedAt = millis();
+    return frame;
+}
+
+void frame_retain(Frame* frame) {
+    if (!frame) return;
+    portENTER_CRITICAL(&_mux);
+    frame->refs++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void frame_release(Frame* frame) {
+    if (!frame) return;
+    portENTER_CRITICAL(&_mux);
+    int remaining = --frame->refs;
+    portEXIT_CRITICAL(&_mux);
+    if (remaining > 0) return;
+
+    // Last holder: nobody else can touch the frame now
+    camera_jpeg_free(&frame->jpeg);
+    frame->jpegReady = false;
+    camera_jpeg_free(&frame->reduced);
+    camera_jpeg_free(&frame->thumbnail);
+    camera_release(frame->fb);
+    frame->fb = nullptr;
+}
+
+camera_fb_t* frame_fb(Frame* frame) {
+    return frame ? frame->fb : nullptr;
+}
+
+unsigned long frame_captured_at(Frame* frame) {
+    return frame ? frame->capturedAt : 0;
+}
+
+bool frame_jpeg(Frame* frame, const uint8_t** buf, size_t* len) {
+    if (!frame || !frame->fb) return false;
+
+    xSemaphoreTake(_jpegLock, portMAX_DELAY);
+    if (!frame->jpegReady) {
+        frame->jpegReady = camera_frame_jpeg(frame->fb, &frame->jpeg);
+    }
+    bool ok = frame->jpegReady;
+    xSemaphoreGive(_jpegLock);
+
+    if (ok) {
+        *buf = frame->jpeg.buf;
+        *len = frame->jpeg.len;
+    }
+    return ok;
+}
+
+bool frame_payload(Frame* frame, PayloadClass cls, const uint8_t** buf, size_t* len,
+                   uint64_t* hash) {
+    if (hash) *hash = 0;
+    if (cls == PayloadClass::Full) return frame_jpeg(frame, buf, len);
+    if (!frame || !frame->fb) return false;
+
+    bool thumb = cls == PayloadClass::Thumbnail;
+    CameraJpeg* out = thumb ? &frame->thumbnail : &frame->reduced;
+
+    xSemaphoreTake(_jpegLock, portMAX_DELAY);
+    bool ok = out->buf != nullptr;
+    if (!ok && thumb) {
+        static uint8_t gray[PAYLOAD_THUMBNAIL_WIDTH * PAYLOAD_THUMBNAIL_HEIGHT];
+        ok = camera_frame_scaled_jpeg(frame->fb, PAYLOAD_THUMBNAIL_WIDTH, PAYLOAD_THUMBNAIL_HEIGHT,
+                                      true, PAYLOAD_THUMBNAIL_JPEG_QUALITY, out, gray);
+        if (ok) {
+            frame->thumbnailHash = dhash_gray(gray, PAYLOAD_THUMBNAIL_WIDTH, PAYLOAD_THUMBNAIL_HEIGHT);
+        }
+    } else if (!ok) {
+        ok = camera_frame_scaled_jpeg(frame->fb, PAYLOAD_REDUCED_WIDTH, PAYLOAD_REDUCED_HEIGHT,
+                                      false, PAYLOAD_REDUCED_JPEG_QUALITY, out, nullptr);
+    }
+    xSemaphoreGive(_jpegLock);
+
+    if (ok) {
+        *buf = out->buf;
+        *len = out->len;
+        if (hash && thumb) *hash = frame->thumbnailHash;
+    }
+    return ok;
+}
+
+static bool hash_band(void* ctx, int y, int width, int rows, const uint8_t* pixels) {
+    DHashAccumulator* acc = (DHashAccumulator*)ctx;
+    for (int r = 0; r < rows; r++) {
+        dhash_add_rgb888_row(acc, y + r, pixels + (size_t)r * width * 3);
+    }
+    return true;
+}
+
+bool frame_dhash(Frame* frame, uint64_t* hash) {
+    camera_fb_t* fb = frame_fb(frame);
+    if (!fb || !fb->buf) return false;
+
+    DHashAccumulator acc;
+    bool ok = false;
+    switch (fb->format) {
+        case PIXFORMAT_RGB565:
+            ok = dhash_begin(&acc, fb->width, fb->height);
+            for (int y = 0; ok && y < fb->height; y++) {
+                dhash_add_rgb565_row(&acc, y, fb->buf + (size_t)y * fb->width * 2);
+            }
+            break;
+        case PIXFORMAT_GRAYSCALE:
+            ok = dhash_begin(&acc, fb->width, fb->height);
+            for (int y = 0; ok && y < fb->height; y++) {
+                dhash_add_gray_row(&acc, y, fb->buf + (size_t)y * fb->width);
+            }
+            break;
+        case PIXFORMAT_JPEG: {
+            JpegInfo info;
+            ok = jpeg_read_info(fb->buf, fb->len, &info) &&
+                 dhash_begin(&acc, info.width, info.height) &&
+                 jpeg_decode_scaled(fb->buf, fb->len, 1, JpegPixelFormat::Rgb888, hash_band, &acc);
+            break;
+        }
+        default:
+            break;
+    }
+    if (ok) *hash = dhash_finish(&acc);
+    return ok;
+}
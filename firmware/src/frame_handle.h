@@ -0,0 +1,41 @@
+#pragma once
+
+// Reference-counted camera frame shared between pipeline stages.
+//
+// One capture feeds both the approach-photo upload (core 0) and on-device
+// inference + access request (core 1). Each holder owns a reference; the
+// framebuffer goes back to the camera driver, and any software-encoded JPEG
+// is freed, only when the last reference is released.
+
+#include <Arduino.h>
+#include "esp_camera.h"
+#include "payload_class.h"
+
+struct Frame;
+
+// Capture a new frame with a reference count of 1. Returns nullptr if the
+// capture fails or every frame slot is still held.
+Frame* frame_capture();
+
+void frame_retain(Frame* frame);
+void frame_release(Frame* frame);
+
+camera_fb_t* frame_fb(Frame* frame);
+
+// millis() at capture time
+unsigned long frame_captured_at(Frame* frame);
+
+// JPEG bytes for upload. Raw frames are encoded on first use and the result
+// is cached for every other holder. Valid until the frame is released.
+bool frame_jpeg(Frame* frame, const uint8_t** buf, size_t* len);
+
+// Image for an upload of class `cls` (see payload_class.h). Full is
+// frame_jpeg(); Reduced and Thumbnail are downscaled re-encodes, made on
+// first use and cached the same way. `hash` receives the thumbnail's dHash
+// (0 for other classes) when non-null.
+bool frame_payload(Frame* frame, PayloadClass cls, const uint8_t** buf, size_t* len,
+                   uint64_t* hash);
+
+// dHash of the captured frame (image_hash.h), from the raw pixels or a
+// full-scale decode of a JPEG frame. Returns false if the frame can't be read.
+bool frame_dhash(Frame* frame, uint64_t* hash);
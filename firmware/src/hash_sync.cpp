@@ -0,0 +1,183 @@
+#include "hash_sync.h"
+#include "config.h"
+#include "image_hash.h"
+#include "network_manager.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+static const char* TABLE_PATH = "/hashtable.json";
+static const int32_t kSecondsPerDay = 86400;
+
+static SemaphoreHandle_t _lock = nullptr;
+static HashTable _table;             // guarded by _lock
+static int32_t _serverSecOfDay = -1; // API's UTC time of day at _anchorMs; guarded by _lock
+static unsigned long _anchorMs = 0;
+
+static HashTable _incoming;          // uplink task only
+static unsigned long _lastSync = 0;
+static bool _lastFailed = false;
+static volatile bool _syncRequested = true;  // first chance after boot
+
+// Fill `out` from the API's table JSON. A table with more photos than
+// HASH_TABLE_CAPACITY is installed empty, and one with an unreadable hash
+// is rejected: matching against part of it could grant an animal the full
+// table would deny.
+static bool parse_table(JsonVariantConst json, HashTable* out) {
+    hash_table_clear(out);
+    strlcpy(out->version, json["version"] | "", sizeof(out->version));
+    if (!out->version[0]) return false;
+    out->enabled = json["enabled"] | false;
+    out->maxDistance = json["maxDistance"] | 0;
+    out->nightStartSec = json["nightStartSec"] | -1;
+    out->nightEndSec = json["nightEndSec"] | -1;
+
+    JsonArrayConst entries = json["entries"].as<JsonArrayConst>();
+    if (entries.size() > HASH_TABLE_CAPACITY) {
+        Serial.printf("[HASH] %u photos enrolled, more than the %d matched locally\n",
+                      (unsigned)entries.size(), HASH_TABLE_CAPACITY);
+        return true;
+    }
+    for (JsonVariantConst e : entries) {
+        HashTableEntry& entry = out->entries[out->count];
+        if (!dhash_from_hex(e["hash"] | "", &entry.hash)) {
+            Serial.printf("[HASH] Unreadable hash for animal %ld; table rejected\n",
+                          (long)(e["animalId"] | -1L));
+            return false;
+        }
+        entry.animalId = e["animalId"] | -1;
+        entry.allowed = e["allowed"] | false;
+        strlcpy(entry.name, e["name"] | "", sizeof(entry.name));
+        out->count++;
+    }
+    return true;
+}
+
+static void install(const HashTable& table) {
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    memcpy(&_table, &table, sizeof(_table));
+    xSemaphoreGive(_lock);
+}
+
+void hash_sync_init() {
+    _lock = xSemaphoreCreateMutex();
+    hash_table_clear(&_table);
+
+    File f = LittleFS.open(TABLE_PATH, "r");
+    if (!f) {
+        Serial.println("[HASH] No saved hash table; waiting for first sync");
+        return;
+    }
+    JsonDocument doc;
+    DeserializationError err = deserializeJson(doc, f);
+    f.close();
+    if (err || !parse_table(doc.as<JsonVariantConst>(), &_incoming)) {
+        Serial.println("[WARN] Saved hash table unreadable; discarded");
+        LittleFS.remove(TABLE_PATH);
+        return;
+    }
+    install(_incoming);
+    Serial.printf("[OK] Hash table v%s loaded (%d hashes)\n", _incoming.version, _incoming.count);
+}
+
+bool hash_sync_due() {
+    if (_syncRequested) return true;
+    unsigned long interval = _lastFailed ? HASH_SYNC_RETRY_INTERVAL_MS : HASH_SYNC_INTERVAL_MS;
+    return millis() - _lastSync >= interval;
+}
+
+void hash_sync_request() {
+    _syncRequested = true;
+}
+
+static bool apply_reply(const char* reply) {
+    JsonDocument doc;
+    if (deserializeJson(doc, reply)) return false;
+
+    int32_t serverSec = doc["serverTimeSec"] | -1;
+    if (serverSec >= 0) {
+        xSemaphoreTake(_lock, portMAX_DELAY);
+        _serverSecOfDay = serverSec % kSecondsPerDay;
+        _anchorMs = millis();
+        xSemaphoreGive(_lock);
+    }
+
+    // No entries: the version we hold is current
+    if (doc["entries"].isNull()) return true;
+    if (!parse_table(doc.as<JsonVariantConst>(), &_incoming)) return false;
+    install(_incoming);
+
+    File f = LittleFS.open(TABLE_PATH, "w");
+    size_t len = strlen(reply);
+    if (!f || f.write((const uint8_t*)reply, len) != len) {
+        Serial.println("[HASH] Could not save hash table");
+    }
+    f.close();
+    Serial.printf("[HASH] Table v%s: %d hashes, max distance %u\n",
+                  _incoming.version, _incoming.count, _incoming.maxDistance);
+    return true;
+}
+
+bool hash_sync_run() {
+    _syncRequested = false;
+    _lastSync = millis();
+
+    // _table.version only changes on this task, so no lock is needed to read it
+    JsonDocument req;
+    req["apiKey"] = API_KEY;
+    req["version"] = _table.version;
+    char body[160];
+    serializeJson(req, body, sizeof(body));
+
+    char* reply = (char*)(psramFound() ? ps_malloc(HASH_SYNC_RESPONSE_BYTES)
+                                       : malloc(HASH_SYNC_RESPONSE_BYTES));
+    if (!reply) {
+        _lastFailed = true;
+        return false;
+    }
+    reply[0] = '\0';
+    int code = network_manager_http_post_json(API_BASE_URL API_HASH_TABLE_ENDPOINT, body, reply,
+                                              HASH_SYNC_RESPONSE_BYTES);
+    bool ok = code == 200 && apply_reply(reply);
+    free(reply);
+
+    _lastFailed = !ok;
+    if (!ok) Serial.printf("[HASH] Sync failed: HTTP %d\n", code);
+    return ok;
+}
+
+bool hash_sync_evict(uint64_t hash, HashTableEntry* evicted) {
+    if (!_lock) return false;
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    // Nearest entry, whatever the door's enabled and night-mode state now
+    int best = -1;
+    int bestDistance = 65;
+    for (int i = 0; i < _table.count; i++) {
+        int d = dhash_distance(hash, _table.entries[i].hash);
+        if (d < bestDistance) {
+            best = i;
+            bestDistance = d;
+        }
+    }
+    bool found = best >= 0 && bestDistance <= _table.maxDistance && _table.entries[best].allowed;
+    if (found) {
+        if (evicted) *evicted = _table.entries[best];
+        hash_table_remove(&_table, best);
+    }
+    xSemaphoreGive(_lock);
+    return found;
+}
+
+LocalMatch hash_sync_lookup(uint64_t hash, HashTableEntry* entry) {
+    LocalMatch match = {LocalDecision::Empty, -1, -1};
+    if (!_lock) return match;
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    int32_t now = -1;
+    if (_serverSecOfDay >= 0) {
+        now = (int32_t)((_serverSecOfDay + (millis() - _anchorMs) / 1000) % kSecondsPerDay);
+    }
+    match = hash_table_match(&_table, hash, now);
+    if (match.index >= 0 && entry) *entry = _table.entries[match.index];
+    xSemaphoreGive(_lock);
+    return match;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Keeps the local enrolled-animal hash table (hash_table.h) in step with
+// the API, so known dogs can be let in on a local dHash match without
+// waiting for the network.
+//
+// The uplink task posts the version it holds to API_HASH_TABLE_ENDPOINT
+// every HASH_SYNC_INTERVAL_MS; the API answers with the full table only
+// when it changed, and always with its UTC time of day, which anchors the
+// night-mode check. Each new table is saved to LittleFS, so known dogs
+// still get in after a reboot while the server is unreachable (as long as
+// night mode is off; with it on, the time of day is unknown until a sync).
+//
+// Lookups run on the vision task and take a copy of the match under a
+// short lock.
+
+#include <Arduino.h>
+#include "hash_table.h"
+
+// Load the saved table. LittleFS must already be mounted.
+void hash_sync_init();
+
+// True when the periodic sync (or a requested one) is due. Uplink task only.
+bool hash_sync_due();
+
+// Fetch the table if it changed. Returns false on a transport or parse error.
+bool hash_sync_run();
+
+// Sync at the next chance, e.g. after the server overruled a local grant.
+void hash_sync_request();
+
+// Drop the allowed entry `hash` matches, after the server denied the dog it
+// let in. Lasts until the API sends a new table version or the saved table
+// is reloaded at boot. False if none matched.
+bool hash_sync_evict(uint64_t hash, HashTableEntry* evicted);
+
+// Match `hash` against the table. `entry` receives a copy of the matched
+// entry when the decision has one (Grant or NotAllowed).
+LocalMatch hash_sync_lookup(uint64_t hash, HashTableEntry* entry);
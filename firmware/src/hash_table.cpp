@@ -0,0 +1,76 @@
+#include "hash_table.h"
+#include "image_hash.h"
+
+#include <string.h>
+
+void hash_table_clear(HashTable* table) {
+    memset(table, 0, sizeof(*table));
+    table->nightStartSec = -1;
+    table->nightEndSec = -1;
+}
+
+void hash_table_remove(HashTable* table, int index) {
+    if (index < 0 || index >= table->count) return;
+    memmove(&table->entries[index], &table->entries[index + 1],
+            sizeof(HashTableEntry) * (table->count - index - 1));
+    table->count--;
+}
+
+// Same window test as the API: inclusive, and wrapping past midnight
+// when start > end
+static bool in_night_window(const HashTable* table, int32_t now) {
+    int32_t start = table->nightStartSec, end = table->nightEndSec;
+    return start <= end ? now >= start && now <= end : now >= start || now <= end;
+}
+
+LocalMatch hash_table_match(const HashTable* table, uint64_t hash, int32_t secondsOfDay) {
+    LocalMatch result = {LocalDecision::Empty, -1, -1};
+    if (table->count == 0) return result;
+
+    if (!table->enabled) {
+        result.decision = LocalDecision::Disabled;
+        return result;
+    }
+    if (table->nightStartSec >= 0 && table->nightEndSec >= 0) {
+        if (secondsOfDay < 0) {
+            result.decision = LocalDecision::TimeUnknown;
+            return result;
+        }
+        if (in_night_window(table, secondsOfDay)) {
+            result.decision = LocalDecision::NightMode;
+            return result;
+        }
+    }
+
+    int best = 0;
+    int bestDistance = dhash_distance(hash, table->entries[0].hash);
+    for (int i = 1; i < table->count && bestDistance > 0; i++) {
+        int d = dhash_distance(hash, table->entries[i].hash);
+        if (d < bestDistance) {
+            best = i;
+            bestDistance = d;
+        }
+    }
+
+    result.distance = bestDistance;
+    if (bestDistance > table->maxDistance) {
+        result.decision = LocalDecision::NoMatch;
+        return result;
+    }
+    result.index = best;
+    result.decision = table->entries[best].allowed ? LocalDecision::Grant : LocalDecision::NotAllowed;
+    return result;
+}
+
+const char* local_decision_name(LocalDecision decision) {
+    switch (decision) {
+        case LocalDecision::Grant: return "grant";
+        case LocalDecision::Empty: return "empty";
+        case LocalDecision::Disabled: return "disabled";
+        case LocalDecision::NightMode: return "night mode";
+        case LocalDecision::TimeUnknown: return "time unknown";
+        case LocalDecision::NoMatch: return "no match";
+        case LocalDecision::NotAllowed: return "not allowed";
+    }
+    return "?";
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// Local copy of the API's enrolled-animal hashes, for granting access
+// without a round trip. Mirrors the server's decision: the photo hash
+// nearest to the frame's dHash (first one on a tie) is the match; it counts
+// only within maxDistance differing bits (the server's similarity and
+// confidence thresholds, combined), and only an allowed animal is let in.
+// The door's enabled flag and night-mode window come with the table, so a
+// local grant is never looser than the server's.
+//
+// The table only ever grants. No match, a denied animal, or a night-mode
+// window the device can't place in time all fall through to the API.
+//
+// Portable; builds under the `native` env.
+
+#include <stdint.h>
+
+#define HASH_TABLE_CAPACITY 64
+#define HASH_TABLE_NAME_LEN 24
+#define HASH_TABLE_VERSION_LEN 24
+
+struct HashTableEntry {
+    uint64_t hash;
+    int32_t animalId;
+    bool allowed;
+    char name[HASH_TABLE_NAME_LEN];
+};
+
+struct HashTable {
+    char version[HASH_TABLE_VERSION_LEN];  // opaque, from the API; "" before the first sync
+    bool enabled;                          // door enabled
+    uint8_t maxDistance;                   // largest Hamming distance that still matches
+    int32_t nightStartSec;                 // UTC seconds of day; -1 without night mode
+    int32_t nightEndSec;
+    int count;
+    HashTableEntry entries[HASH_TABLE_CAPACITY];
+};
+
+enum class LocalDecision : uint8_t {
+    Grant,
+    Empty,         // no table yet, or no enrolled photos
+    Disabled,      // door disabled
+    NightMode,     // inside the night-mode window
+    TimeUnknown,   // night mode set but the time of day isn't known
+    NoMatch,
+    NotAllowed,    // matched an animal that isn't allowed
+};
+
+struct LocalMatch {
+    LocalDecision decision;
+    int index;     // matched entry, or -1
+    int distance;  // to the nearest entry, or -1
+};
+
+void hash_table_clear(HashTable* table);
+
+// Drop one entry, keeping the order of the rest.
+void hash_table_remove(HashTable* table, int index);
+
+// `secondsOfDay` is the current UTC time of day, or -1 if unknown.
+LocalMatch hash_table_match(const HashTable* table, uint64_t hash, int32_t secondsOfDay);
+
+const char* local_decision_name(LocalDecision decision);
@@ -0,0 +1,210 @@
+#include "http_stream.h"
+#include "config.h"
+
+bool http_parse_url(const char* url, HttpUrl* out) {
+    const char* p = url;
+    out->port = 80;
+    if (strncmp(p, "https://", 8) == 0) {
+        p += 8;
+        out->port = 443;
+    } else if (strncmp(p, "http://", 7) == 0) {
+        p += 7;
+    } else {
+        return false;
+    }
+
+    size_t hostLen = strcspn(p, ":/");
+    if (hostLen == 0 || hostLen >= sizeof(out->host)) return false;
+    memcpy(out->host, p, hostLen);
+    out->host[hostLen] = '\0';
+    p += hostLen;
+
+    if (*p == ':') {
+        out->port = (uint16_t)atoi(p + 1);
+        p += 1 + strcspn(p + 1, "/");
+    }
+    out->path = *p ? p : "/";
+    return true;
+}
+
+// Read one header line (CRLF stripped, truncated to cap - 1).
+// Returns its length, or a negative error.
+static int read_line(Client& client, char* buf, size_t cap, unsigned long deadline) {
+    size_t n = 0;
+    for (;;) {
+        if (!client.available()) {
+            if (!client.connected()) return HTTP_STREAM_ERR_CONNECTION_LOST;
+            if ((long)(millis() - deadline) >= 0) return HTTP_STREAM_ERR_TIMEOUT;
+            delay(1);
+            continue;
+        }
+        int c = client.read();
+        if (c == '\n') break;
+        if (c != '\r' && n + 1 < cap) buf[n++] = (char)c;
+    }
+    buf[n] = '\0';
+    return (int)n;
+}
+
+HttpBodyReader::HttpBodyReader(Client& client, size_t contentLength, bool chunked, unsigned long deadline)
+    : _client(client), _deadline(deadline), _remaining(chunked ? 0 : contentLength),
+      _chunked(chunked), _chunkStarted(false), _ended(false), _error(0), _pos(0), _len(0) {}
+
+// Step to the next chunk; false after the last one (trailers consumed)
+bool HttpBodyReader::next_chunk() {
+    char line[32];
+    int n;
+    if (_chunkStarted && (n = read_line(_client, line, sizeof(line), _deadline)) < 0) {  // CRLF after chunk
+        _error = n;
+        return false;
+    }
+    _chunkStarted = true;
+    if ((n = read_line(_client, line, sizeof(line), _deadline)) < 0) {
+        _error = n;
+        return false;
+    }
+    _remaining = (size_t)strtoul(line, nullptr, 16);
+    if (_remaining > 0) return true;
+
+    // Trailer headers, ending with an empty line
+    while ((n = read_line(_client, line, sizeof(line), _deadline)) > 0) {}
+    if (n < 0) _error = n;
+    _ended = true;
+    return false;
+}
+
+// Refill _buf from the socket; false at the end of the body or on error
+bool HttpBodyReader::fill() {
+    if (_pos < _len) return true;
+    if (_ended || _error) return false;
+    if (_remaining == 0 && !(_chunked && next_chunk())) {
+        _ended = true;
+        return false;
+    }
+
+    for (;;) {
+        int avail = _client.available();
+        if (avail <= 0) {
+            if (!_client.connected()) {
+                // Without a length the body ends when the server closes
+                if (_remaining == SIZE_MAX) {
+                    _ended = true;
+                } else {
+                    _error = HTTP_STREAM_ERR_CONNECTION_LOST;
+                }
+                return false;
+            }
+            if ((long)(millis() - _deadline) >= 0) {
+                _error = HTTP_STREAM_ERR_TIMEOUT;
+                return false;
+            }
+            delay(1);
+            continue;
+        }
+        size_t want = _remaining < sizeof(_buf) ? _remaining : sizeof(_buf);
+        int got = _client.read(_buf, want);
+        if (got <= 0) continue;
+        if (_remaining != SIZE_MAX) _remaining -= (size_t)got;
+        _pos = 0;
+        _len = (uint8_t)got;
+        return true;
+    }
+}
+
+int HttpBodyReader::read() {
+    return fill() ? _buf[_pos++] : -1;
+}
+
+size_t HttpBodyReader::readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && fill()) {
+        size_t take = _len - _pos;
+        if (take > length - n) take = length - n;
+        memcpy(buffer + n, _buf + _pos, take);
+        _pos += take;
+        n += take;
+    }
+    return n;
+}
+
+int HttpBodyReader::drain() {
+    while (fill()) _pos = _len;
+    return _error;
+}
+
+void http_read_into_buffer(HttpBodyReader& body, int, void* ctx) {
+    const HttpResponseBuffer& out = *(const HttpResponseBuffer*)ctx;
+    if (!out.dst || out.cap == 0) return;
+    size_t n = body.readBytes(out.dst, out.cap - 1);
+    out.dst[n] = '\0';
+}
+
+static int read_response(Client& client, HttpResponseReader readBody, void* readCtx,
+                         bool* keepAlive) {
+    unsigned long deadline = millis() + API_TIMEOUT_MS;
+    char line[128];
+
+    int n = read_line(client, line, sizeof(line), deadline);
+    if (n < 0) return n;
+    int status = 0;
+    if (strncmp(line, "HTTP/1.", 7) != 0 || sscanf(line + 8, " %d", &status) != 1) {
+        return HTTP_STREAM_ERR_BAD_RESPONSE;
+    }
+    *keepAlive = line[7] == '1';  // HTTP/1.1 persists unless told otherwise
+
+    size_t contentLength = SIZE_MAX;
+    bool chunked = false;
+    while ((n = read_line(client, line, sizeof(line), deadline)) > 0) {
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            contentLength = (size_t)strtoul(line + 15, nullptr, 10);
+        } else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0 && strstr(line + 18, "chunked")) {
+            chunked = true;
+        } else if (strncasecmp(line, "Connection:", 11) == 0 && strcasestr(line + 11, "close")) {
+            *keepAlive = false;
+        }
+    }
+    if (n < 0) return n;
+    if (status == 204 || status == 304) return status;
+
+    // Without a length the body ends when the server closes
+    if (!chunked && contentLength == SIZE_MAX) *keepAlive = false;
+    HttpBodyReader body(client, contentLength, chunked, deadline);
+    if (readBody) readBody(body, status, readCtx);
+    int err = body.drain();
+    return err < 0 ? err : status;
+}
+
+int http_stream_post(Client& client, const HttpUrl& url, const char* contentType,
+                     size_t contentLength, HttpBodyWriter writeBody, const void* ctx,
+                     HttpResponseReader readBody, void* readCtx,
+                     bool* keepAlive, bool* requestSent) {
+    *keepAlive = false;
+    *requestSent = false;
+
+    char header[320];
+    int headerLen;
+    if (url.port == 80 || url.port == 443) {
+        headerLen = snprintf(header, sizeof(header),
+            "POST %s HTTP/1.1\r\nHost: %s\r\n", url.path, url.host);
+    } else {
+        headerLen = snprintf(header, sizeof(header),
+            "POST %s HTTP/1.1\r\nHost: %s:%u\r\n", url.path, url.host, url.port);
+    }
+    // A long path leaves no room for the rest (and snprintf returns the length
+    // it wanted, which would run the next write past the buffer)
+    if (headerLen < 0 || headerLen >= (int)sizeof(header)) return HTTP_STREAM_ERR_SEND_HEADER;
+    headerLen += snprintf(header + headerLen, sizeof(header) - headerLen,
+        "Content-Type: %s\r\nContent-Length: %u\r\nConnection: keep-alive\r\n\r\n",
+        contentType, (unsigned)contentLength);
+    if (headerLen >= (int)sizeof(header)) return HTTP_STREAM_ERR_SEND_HEADER;
+
+    if (client.write((const uint8_t*)header, headerLen) != (size_t)headerLen) {
+        return HTTP_STREAM_ERR_SEND_HEADER;
+    }
+    if (!writeBody(client, ctx)) return HTTP_STREAM_ERR_SEND_BODY;
+    *requestSent = true;
+
+    int result = read_response(client, readBody, readCtx, keepAlive);
+    if (result < 0) *keepAlive = false;
+    return result;
+}
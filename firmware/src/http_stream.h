@@ -0,0 +1,87 @@
+#pragma once
+
+// Minimal HTTP/1.1 POST over an already-connected Client. Unlike HTTPClient,
+// the body is produced by a callback that writes straight to the socket, so
+// large payloads are never assembled in RAM, and the connection is left open
+// for the caller to reuse (keep-alive). Handles Content-Length and chunked
+// responses.
+
+#include <Arduino.h>
+#include <Client.h>
+
+// Error codes (negative) mirror HTTPClient's HTTPC_ERROR_* values.
+#define HTTP_STREAM_ERR_CONNECT          -1
+#define HTTP_STREAM_ERR_SEND_HEADER      -2
+#define HTTP_STREAM_ERR_SEND_BODY        -3
+#define HTTP_STREAM_ERR_CONNECTION_LOST  -5
+#define HTTP_STREAM_ERR_BAD_RESPONSE     -7
+#define HTTP_STREAM_ERR_BAD_URL          -9
+#define HTTP_STREAM_ERR_TIMEOUT          -11
+
+// Must write exactly the advertised Content-Length bytes to `out`.
+typedef bool (*HttpBodyWriter)(Client& out, const void* ctx);
+
+// The response body as it arrives on the socket, de-chunked. Has the
+// read()/readBytes() pair ArduinoJson takes as a custom reader, so a reply
+// can be parsed without first being copied into a buffer.
+class HttpBodyReader {
+public:
+    HttpBodyReader(Client& client, size_t contentLength, bool chunked, unsigned long deadline);
+
+    // Next byte, or -1 at the end of the body (or on error).
+    int read();
+    size_t readBytes(char* buffer, size_t length);
+
+    // Read and discard the rest. Returns 0, or a negative error if the body
+    // ended early.
+    int drain();
+
+private:
+    bool fill();
+    bool next_chunk();
+
+    Client& _client;
+    unsigned long _deadline;
+    size_t _remaining;  // in this chunk (or the body); SIZE_MAX: until the peer closes
+    bool _chunked;
+    bool _chunkStarted;
+    bool _ended;
+    int _error;
+    uint8_t _buf[64];
+    uint8_t _pos;
+    uint8_t _len;
+};
+
+// Consumes the body of a response with status `status` (not called for 204
+// or 304). Whatever it leaves unread is drained afterwards, so the
+// connection stays usable.
+typedef void (*HttpResponseReader)(HttpBodyReader& body, int status, void* ctx);
+
+// Reader that copies the body into a buffer, NUL-terminated and truncated to
+// cap - 1. `ctx` is an HttpResponseBuffer.
+struct HttpResponseBuffer {
+    char* dst;
+    size_t cap;
+};
+void http_read_into_buffer(HttpBodyReader& body, int status, void* ctx);
+
+struct HttpUrl {
+    char host[64];
+    uint16_t port;
+    const char* path;  // points into the parsed URL string
+};
+
+// Split "http[s]://host[:port]/path". Returns false if malformed.
+bool http_parse_url(const char* url, HttpUrl* out);
+
+// POST to `url` over `client`, which must already be connected to its host.
+// The response body is handed to `readBody` when non-null, and discarded
+// otherwise. `keepAlive` is set to whether
+// the connection can carry another request. Returns the HTTP status or a
+// negative error; `requestSent` is false only if writing the header or body
+// failed, before the server could act on the request, so only then may it
+// be retried on a fresh connection.
+int http_stream_post(Client& client, const HttpUrl& url, const char* contentType,
+                     size_t contentLength, HttpBodyWriter writeBody, const void* ctx,
+                     HttpResponseReader readBody, void* readCtx,
+                     bool* keepAlive, bool* requestSent);
@@ -0,0 +1,125 @@
+#include "image_hash.h"
+
+#include <string.h>
+
+static const int kCellsW = 9;
+static const int kCellsH = 8;
+
+static int cell_edge(int i, int size, int cells) {
+    return (int)((int64_t)i * size / cells);
+}
+
+// Cell row holding pixel row y, or -1 outside the image
+static int cell_row(const DHashAccumulator* acc, int y) {
+    if (y < 0) return -1;
+    for (int cy = 0; cy < kCellsH; cy++) {
+        if (y < cell_edge(cy + 1, acc->height, kCellsH)) return cy;
+    }
+    return -1;
+}
+
+// Sum the luma of one row into its cells; `luma(x)` reads pixel x
+template <typename Luma>
+static void add_row(DHashAccumulator* acc, int y, Luma luma) {
+    int cy = cell_row(acc, y);
+    if (cy < 0) return;
+    uint32_t* sums = acc->sums[cy];
+    for (int cx = 0; cx < kCellsW; cx++) {
+        int x1 = cell_edge(cx + 1, acc->width, kCellsW);
+        uint32_t sum = 0;
+        for (int x = cell_edge(cx, acc->width, kCellsW); x < x1; x++) sum += luma(x);
+        sums[cx] += sum;
+    }
+}
+
+bool dhash_begin(DHashAccumulator* acc, int w, int h) {
+    memset(acc, 0, sizeof(*acc));
+    if (w < kCellsW || h < kCellsH) return false;
+    acc->width = w;
+    acc->height = h;
+    return true;
+}
+
+void dhash_add_gray_row(DHashAccumulator* acc, int y, const uint8_t* gray) {
+    add_row(acc, y, [gray](int x) { return gray[x]; });
+}
+
+void dhash_add_rgb565_row(DHashAccumulator* acc, int y, const uint8_t* rgb565) {
+    add_row(acc, y, [rgb565](int x) {
+        uint16_t v = (uint16_t)((rgb565[2 * x] << 8) | rgb565[2 * x + 1]);
+        uint8_t r5 = v >> 11, g6 = (v >> 5) & 0x3F, b5 = v & 0x1F;
+        return dhash_luma((uint8_t)((r5 << 3) | (r5 >> 2)), (uint8_t)((g6 << 2) | (g6 >> 4)),
+                          (uint8_t)((b5 << 3) | (b5 >> 2)));
+    });
+}
+
+void dhash_add_rgb888_row(DHashAccumulator* acc, int y, const uint8_t* rgb) {
+    add_row(acc, y, [rgb](int x) { return dhash_luma(rgb[3 * x], rgb[3 * x + 1], rgb[3 * x + 2]); });
+}
+
+uint64_t dhash_finish(const DHashAccumulator* acc) {
+    if (acc->width == 0) return 0;
+
+    uint32_t cells[kCellsH][kCellsW];
+    for (int cy = 0; cy < kCellsH; cy++) {
+        int rows = cell_edge(cy + 1, acc->height, kCellsH) - cell_edge(cy, acc->height, kCellsH);
+        for (int cx = 0; cx < kCellsW; cx++) {
+            int cols = cell_edge(cx + 1, acc->width, kCellsW) - cell_edge(cx, acc->width, kCellsW);
+            uint32_t n = (uint32_t)(rows * cols);
+            cells[cy][cx] = (acc->sums[cy][cx] + n / 2) / n;
+        }
+    }
+
+    uint64_t hash = 0;
+    int bit = 0;
+    for (int y = 0; y < kCellsH; y++) {
+        for (int x = 0; x < kCellsW - 1; x++) {
+            if (cells[y][x] > cells[y][x + 1]) hash |= 1ULL << bit;
+            bit++;
+        }
+    }
+    return hash;
+}
+
+uint64_t dhash_gray(const uint8_t* gray, int w, int h) {
+    DHashAccumulator acc;
+    if (!gray || !dhash_begin(&acc, w, h)) return 0;
+    for (int y = 0; y < h; y++) dhash_add_gray_row(&acc, y, gray + y * w);
+    return dhash_finish(&acc);
+}
+
+int dhash_distance(uint64_t a, uint64_t b) {
+    uint64_t v = a ^ b;
+    int n = 0;
+    while (v) {
+        v &= v - 1;
+        n++;
+    }
+    return n;
+}
+
+void dhash_to_hex(uint64_t hash, char out[DHASH_HEX_LEN + 1]) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    for (int i = DHASH_HEX_LEN - 1; i >= 0; i--) {
+        out[i] = kDigits[hash & 0xF];
+        hash >>= 4;
+    }
+    out[DHASH_HEX_LEN] = '\0';
+}
+
+bool dhash_from_hex(const char* hex, uint64_t* out) {
+    if (!hex) return false;
+    uint64_t v = 0;
+    for (int i = 0; i < DHASH_HEX_LEN; i++) {
+        char c = hex[i];
+        int d;
+        if (c >= '0' && c <= '9') d = c - '0';
+        else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+        else return false;
+        v = (v << 4) | (uint64_t)d;
+    }
+    if (hex[DHASH_HEX_LEN] != '\0') return false;
+    *out = v;
+    return true;
+}
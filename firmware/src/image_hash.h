@@ -0,0 +1,56 @@
+#pragma once
+
+// Perceptual difference hash (dHash), defined identically here and in the
+// API (AnimalRecognitionService.ComputeDHash) so hashes computed on the
+// device can be compared with those of enrolled photos:
+//
+//   1. every pixel is reduced to luma (77 R + 150 G + 29 B) >> 8 (RGB565 is
+//      first widened to RGB888 by bit replication);
+//   2. the image is split into 9x8 cells, cell i spanning pixels
+//      [floor(i * size / cells), floor((i + 1) * size / cells)), and each
+//      cell is the rounded mean of its pixels;
+//   3. bit (y * 8 + x) is set when cell (x, y) is brighter than (x + 1, y).
+//
+// Rows can be fed one at a time, so a frame never needs a grayscale copy.
+//
+// Portable; builds under the `native` env.
+
+#include <stdint.h>
+
+#define DHASH_HEX_LEN 16
+#define DHASH_BITS 64
+
+struct DHashAccumulator {
+    int width;
+    int height;
+    uint32_t sums[8][9];
+};
+
+static inline uint8_t dhash_luma(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t)((77 * r + 150 * g + 29 * b) >> 8);
+}
+
+// w >= 9 and h >= 8; returns false otherwise.
+bool dhash_begin(DHashAccumulator* acc, int w, int h);
+
+// Add row `y` of `w` luma values.
+void dhash_add_gray_row(DHashAccumulator* acc, int y, const uint8_t* gray);
+
+// Same, converting `w` pixels of big-endian RGB565 (as from the OV2640) or RGB888.
+void dhash_add_rgb565_row(DHashAccumulator* acc, int y, const uint8_t* rgb565);
+void dhash_add_rgb888_row(DHashAccumulator* acc, int y, const uint8_t* rgb);
+
+uint64_t dhash_finish(const DHashAccumulator* acc);
+
+// Whole grayscale image (w x h, row-major). Returns 0 for images smaller than 9x8.
+uint64_t dhash_gray(const uint8_t* gray, int w, int h);
+
+// Number of differing bits; 0 for identical hashes.
+int dhash_distance(uint64_t a, uint64_t b);
+
+// Upper-case hex, zero-padded to DHASH_HEX_LEN digits, NUL-terminated.
+void dhash_to_hex(uint64_t hash, char out[DHASH_HEX_LEN + 1]);
+
+// Inverse of dhash_to_hex (either case). Returns false if `hex` is not
+// exactly DHASH_HEX_LEN hex digits.
+bool dhash_from_hex(const char* hex, uint64_t* out);
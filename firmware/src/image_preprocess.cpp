@@ -0,0 +1,183 @@
+#include "image_preprocess.h"
+#include "jpeg_decoder.h"
+#include "phase_arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+static uint32_t now_us() { return micros(); }
+#else
+#include <chrono>
+static uint32_t now_us() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+// Box-filter resampler fed one decoded band at a time. Each source pixel is
+// assigned to exactly one destination pixel (floor mapping) and summed; a
+// destination row is emitted once all of its source rows have been seen.
+struct Resampler {
+    uint8_t* dst;
+    int dstW;
+    int dstH;
+    int srcW;
+    int srcH;
+    int channels;
+    int curRow;          // destination row being accumulated
+    int rowsSeen;        // source rows summed into curRow
+    uint32_t* sums;      // dstW * channels
+    uint16_t* colCount;  // source columns per destination column
+    uint16_t* colMap;    // source x -> destination x
+};
+
+static void flush_row(Resampler& r) {
+    if (r.curRow < 0 || r.curRow >= r.dstH || r.rowsSeen == 0) return;
+    uint8_t* out = r.dst + (size_t)r.curRow * r.dstW * r.channels;
+    for (int dx = 0; dx < r.dstW; dx++) {
+        uint32_t n = (uint32_t)r.colCount[dx] * r.rowsSeen;
+        for (int c = 0; c < r.channels; c++) {
+            uint32_t& s = r.sums[dx * r.channels + c];
+            out[dx * r.channels + c] = n ? (uint8_t)((s + n / 2) / n) : 0;
+            s = 0;
+        }
+    }
+    r.rowsSeen = 0;
+}
+
+static bool resample_band(void* ctx, int y, int width, int rows, const uint8_t* pixels) {
+    Resampler& r = *(Resampler*)ctx;
+    for (int row = 0; row < rows; row++) {
+        int sy = y + row;
+        int dy = (int)((int64_t)sy * r.dstH / r.srcH);
+        if (dy != r.curRow) {
+            flush_row(r);
+            r.curRow = dy;
+        }
+        const uint8_t* src = pixels + (size_t)row * width * r.channels;
+        for (int sx = 0; sx < r.srcW; sx++) {
+            uint32_t* acc = r.sums + r.colMap[sx] * r.channels;
+            for (int c = 0; c < r.channels; c++) acc[c] += src[sx * r.channels + c];
+        }
+        r.rowsSeen++;
+    }
+    return true;
+}
+
+int preprocess_pick_scale(int srcW, int srcH, int dstW, int dstH) {
+    for (int scale = 8; scale > 1; scale /= 2) {
+        if ((srcW + scale - 1) / scale >= dstW && (srcH + scale - 1) / scale >= dstH) return scale;
+    }
+    return 1;
+}
+
+static bool resampler_begin(Resampler& r, uint8_t* dst, int dstW, int dstH, int srcW, int srcH) {
+    r.dst = dst;
+    r.dstW = dstW;
+    r.dstH = dstH;
+    r.srcW = srcW;
+    r.srcH = srcH;
+    r.channels = 3;
+    r.curRow = -1;
+    r.rowsSeen = 0;
+
+    size_t sumsBytes = sizeof(uint32_t) * dstW * r.channels;
+    size_t countBytes = sizeof(uint16_t) * dstW;
+    size_t mapBytes = sizeof(uint16_t) * srcW;
+    uint8_t* scratch = (uint8_t*)scratch_calloc(sumsBytes + countBytes + mapBytes);
+    if (!scratch) return false;
+    r.sums = (uint32_t*)scratch;
+    r.colCount = (uint16_t*)(scratch + sumsBytes);
+    r.colMap = (uint16_t*)(scratch + sumsBytes + countBytes);
+    for (int sx = 0; sx < srcW; sx++) {
+        int dx = (int)((int64_t)sx * dstW / srcW);
+        r.colMap[sx] = (uint16_t)dx;
+        r.colCount[dx]++;
+    }
+    return true;
+}
+
+static void resampler_end(Resampler& r) {
+    scratch_free(r.sums);
+    r.sums = nullptr;
+}
+
+bool preprocess_jpeg_to_rgb(const uint8_t* jpeg, size_t len,
+                            uint8_t* dst, int dstW, int dstH,
+                            PreprocessStats* stats) {
+    uint32_t start = now_us();
+    if (!jpeg || !dst || dstW <= 0 || dstH <= 0) return false;
+
+    JpegInfo info;
+    if (!jpeg_read_info(jpeg, len, &info)) return false;
+
+    // Only downscaling is supported; the model input is always smaller than a frame.
+    if (info.width < dstW || info.height < dstH) return false;
+
+    int scale = preprocess_pick_scale(info.width, info.height, dstW, dstH);
+    Resampler r;
+    if (!resampler_begin(r, dst, dstW, dstH,
+                         (info.width + scale - 1) / scale, (info.height + scale - 1) / scale)) {
+        return false;
+    }
+
+    bool ok = jpeg_decode_scaled(jpeg, len, scale, JpegPixelFormat::Rgb888, resample_band, &r);
+    if (ok) flush_row(r);
+    resampler_end(r);
+
+    if (stats) {
+        stats->srcWidth = info.width;
+        stats->srcHeight = info.height;
+        stats->scaleDenom = scale;
+        stats->totalUs = now_us() - start;
+    }
+    return ok;
+}
+
+bool preprocess_raw_to_rgb(const uint8_t* src, int srcW, int srcH, RawPixelFormat format,
+                           uint8_t* dst, int dstW, int dstH,
+                           PreprocessStats* stats) {
+    uint32_t start = now_us();
+    if (!src || !dst || dstW <= 0 || dstH <= 0) return false;
+    if (srcW < dstW || srcH < dstH) return false;
+
+    Resampler r;
+    if (!resampler_begin(r, dst, dstW, dstH, srcW, srcH)) return false;
+    uint8_t* row = (uint8_t*)scratch_alloc((size_t)srcW * 3);
+    if (!row) {
+        resampler_end(r);
+        return false;
+    }
+
+    for (int y = 0; y < srcH; y++) {
+        if (format == RawPixelFormat::Rgb565) {
+            const uint8_t* in = src + (size_t)y * srcW * 2;
+            for (int x = 0; x < srcW; x++) {
+                uint16_t px = (uint16_t)((in[2 * x] << 8) | in[2 * x + 1]);
+                uint8_t r5 = px >> 11;
+                uint8_t g6 = (px >> 5) & 0x3F;
+                uint8_t b5 = px & 0x1F;
+                row[3 * x]     = (uint8_t)((r5 << 3) | (r5 >> 2));
+                row[3 * x + 1] = (uint8_t)((g6 << 2) | (g6 >> 4));
+                row[3 * x + 2] = (uint8_t)((b5 << 3) | (b5 >> 2));
+            }
+        } else {
+            const uint8_t* in = src + (size_t)y * srcW;
+            for (int x = 0; x < srcW; x++) row[3 * x] = row[3 * x + 1] = row[3 * x + 2] = in[x];
+        }
+        resample_band(&r, y, srcW, 1, row);
+    }
+    flush_row(r);
+    scratch_free(row);
+    resampler_end(r);
+
+    if (stats) {
+        stats->srcWidth = srcW;
+        stats->srcHeight = srcH;
+        stats->scaleDenom = 1;
+        stats->totalUs = now_us() - start;
+    }
+    return true;
+}
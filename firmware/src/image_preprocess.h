@@ -0,0 +1,40 @@
+#pragma once
+
+// Image preprocessing for on-device inference: turns a camera frame into the
+// model's input layout (dstWidth x dstHeight x 3, uint8 RGB, row-major).
+//
+// JPEG frames are decoded with a scaled IDCT straight into an area-averaging
+// resampler, one MCU row at a time, so the full-resolution RGB image is never
+// held in memory. Uncompressed RGB565/grayscale frames skip the decode step
+// entirely. Portable; builds under the `native` env.
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class RawPixelFormat : uint8_t {
+    Rgb565,  // big-endian (high byte first), as delivered by the OV2640
+    Gray8,
+};
+
+struct PreprocessStats {
+    int srcWidth;       // captured frame size
+    int srcHeight;
+    int scaleDenom;     // IDCT scale used (1, 2, 4 or 8); 1 for raw frames
+    uint32_t totalUs;   // decode/convert + resample wall time
+};
+
+// Largest IDCT scale (8, 4, 2, 1) whose output still covers dstW x dstH, so
+// the resampler only ever shrinks.
+int preprocess_pick_scale(int srcW, int srcH, int dstW, int dstH);
+
+// Decode `jpeg` and resample it into `dst` (dstW * dstH * 3 bytes).
+// `stats` may be null. Returns false if the JPEG cannot be decoded.
+bool preprocess_jpeg_to_rgb(const uint8_t* jpeg, size_t len,
+                            uint8_t* dst, int dstW, int dstH,
+                            PreprocessStats* stats);
+
+// Resample an uncompressed frame (no decode step) into `dst` as RGB888.
+// Grayscale input is replicated across the three channels.
+bool preprocess_raw_to_rgb(const uint8_t* src, int srcW, int srcH, RawPixelFormat format,
+                           uint8_t* dst, int dstW, int dstH,
+                           PreprocessStats* stats);
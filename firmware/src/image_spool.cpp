@@ -0,0 +1,200 @@
+#include "image_spool.h"
+#include "config.h"
+#include "network_manager.h"
+#include <LittleFS.h>
+
+static const char* SPOOL_DIR = "/spool";
+static const uint32_t kSpoolMagic = 0x314C5053;  // "SPL1"
+
+// Stored ahead of the JPEG in each /spool/<seq>.jpg file
+struct SpoolHeader {
+    uint32_t magic;
+    uint32_t jpegLen;
+    uint32_t bootId;        // capture time is only meaningful within one boot
+    uint32_t capturedAtMs;  // millis() at capture
+    char side[8];
+};
+
+struct SpoolEntry {
+    uint32_t seq;
+    uint32_t bytes;
+};
+
+// Oldest first; a ring so eviction and upload are O(1)
+static SpoolEntry _entries[IMAGE_SPOOL_MAX_FILES];
+static int _first = 0;
+static int _count = 0;
+static uint32_t _totalBytes = 0;
+static uint32_t _nextSeq = 0;
+static uint32_t _bootId = 0;
+static bool _ready = false;
+
+static Frame* _lastFrame = nullptr;
+static unsigned long _lastCapturedAt = 0;
+
+static void spool_path(uint32_t seq, char* path, size_t cap) {
+    snprintf(path, cap, "%s/%08lx.jpg", SPOOL_DIR, (unsigned long)seq);
+}
+
+static SpoolEntry& entry_at(int i) {
+    return _entries[(_first + i) % IMAGE_SPOOL_MAX_FILES];
+}
+
+static void drop_oldest() {
+    char path[32];
+    SpoolEntry& oldest = entry_at(0);
+    spool_path(oldest.seq, path, sizeof(path));
+    LittleFS.remove(path);
+    _totalBytes -= oldest.bytes;
+    _first = (_first + 1) % IMAGE_SPOOL_MAX_FILES;
+    _count--;
+}
+
+void image_spool_init() {
+    _bootId = esp_random();
+    if (!LittleFS.exists(SPOOL_DIR) && !LittleFS.mkdir(SPOOL_DIR)) {
+        Serial.println("[WARN] Image spool directory unavailable");
+        return;
+    }
+
+    File dir = LittleFS.open(SPOOL_DIR);
+    File f = dir.openNextFile();
+    while (f) {
+        SpoolEntry e = {(uint32_t)strtoul(f.name(), nullptr, 16), (uint32_t)f.size()};
+        f.close();
+        if (_count == IMAGE_SPOOL_MAX_FILES) {
+            // Over the file cap (the limit was lowered): keep the newest
+            SpoolEntry victim = e.seq < _entries[0].seq ? e : _entries[0];
+            char path[32];
+            spool_path(victim.seq, path, sizeof(path));
+            LittleFS.remove(path);
+            if (victim.seq == e.seq) {
+                f = dir.openNextFile();
+                continue;
+            }
+            memmove(&_entries[0], &_entries[1], (_count - 1) * sizeof(SpoolEntry));
+            _count--;
+        }
+        // Insertion sort by sequence number (boot-time only)
+        int i = _count++;
+        while (i > 0 && _entries[i - 1].seq > e.seq) {
+            _entries[i] = _entries[i - 1];
+            i--;
+        }
+        _entries[i] = e;
+        f = dir.openNextFile();
+    }
+    dir.close();
+
+    for (int i = 0; i < _count; i++) _totalBytes += _entries[i].bytes;
+    if (_count > 0) _nextSeq = _entries[_count - 1].seq + 1;
+    while (_totalBytes > IMAGE_SPOOL_MAX_BYTES) drop_oldest();
+
+    _ready = true;
+    Serial.printf("[OK] Image spool ready (%d images, %lu bytes)\n",
+                  _count, (unsigned long)_totalBytes);
+}
+
+bool image_spool_store(Frame* frame, const char* side) {
+    if (!_ready || !frame) return false;
+    if (frame == _lastFrame && frame_captured_at(frame) == _lastCapturedAt) return true;
+
+    const uint8_t* jpeg;
+    size_t jpegLen;
+    if (!frame_jpeg(frame, &jpeg, &jpegLen)) return false;
+    uint32_t bytes = sizeof(SpoolHeader) + jpegLen;
+    if (bytes > IMAGE_SPOOL_MAX_BYTES) return false;
+
+    while (_count > 0 &&
+           (_count == IMAGE_SPOOL_MAX_FILES || _totalBytes + bytes > IMAGE_SPOOL_MAX_BYTES)) {
+        drop_oldest();
+    }
+
+    SpoolHeader header = {};
+    header.magic = kSpoolMagic;
+    header.jpegLen = jpegLen;
+    header.bootId = _bootId;
+    header.capturedAtMs = frame_captured_at(frame);
+    strncpy(header.side, side ? side : "", sizeof(header.side) - 1);
+
+    char path[32];
+    uint32_t seq = _nextSeq++;
+    spool_path(seq, path, sizeof(path));
+    File f = LittleFS.open(path, "w");
+    bool ok = f && f.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              f.write(jpeg, jpegLen) == jpegLen;
+    f.close();
+    if (!ok) {
+        // Most likely the partition is full; don't leave a partial image behind
+        LittleFS.remove(path);
+        Serial.println("[SPOOL] Write failed; image dropped");
+        return false;
+    }
+
+    SpoolEntry& e = _entries[(_first + _count) % IMAGE_SPOOL_MAX_FILES];
+    e.seq = seq;
+    e.bytes = bytes;
+    _count++;
+    _totalBytes += bytes;
+    _lastFrame = frame;
+    _lastCapturedAt = frame_captured_at(frame);
+    Serial.printf("[SPOOL] Stored %u-byte image (%d spooled)\n", (unsigned)jpegLen, _count);
+    return true;
+}
+
+int image_spool_count() {
+    return _count;
+}
+
+bool image_spool_upload_next() {
+    if (!_ready || _count == 0) return false;
+
+    char path[32];
+    spool_path(entry_at(0).seq, path, sizeof(path));
+    File f = LittleFS.open(path, "r");
+    SpoolHeader header;
+    bool valid = f && f.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                 header.magic == kSpoolMagic &&
+                 header.jpegLen == entry_at(0).bytes - sizeof(header);
+    uint8_t* jpeg = nullptr;
+    if (valid) {
+        jpeg = (uint8_t*)(psramFound() ? ps_malloc(header.jpegLen) : malloc(header.jpegLen));
+        if (!jpeg) {
+            f.close();
+            return false;  // retry when memory frees up
+        }
+        valid = f.read(jpeg, header.jpegLen) == header.jpegLen;
+    }
+    f.close();
+    if (!valid) {
+        Serial.println("[SPOOL] Discarding unreadable image");
+        free(jpeg);
+        drop_oldest();
+        return false;
+    }
+
+    header.side[sizeof(header.side) - 1] = '\0';
+    char age[12] = "";
+    if (header.bootId == _bootId) {
+        snprintf(age, sizeof(age), "%lu", (unsigned long)(millis() - header.capturedAtMs));
+    }
+
+    MultipartBody body;
+    multipart_begin(&body, "image", "spooled.jpg", "image/jpeg", jpeg, header.jpegLen);
+    multipart_add_field(&body, "apiKey", API_KEY);
+    multipart_add_field(&body, "side", header.side);
+    multipart_add_field(&body, "capturedAgeMs", age);
+
+    int httpCode = network_manager_http_post_multipart(API_BASE_URL API_APPROACH_ENDPOINT, body, nullptr, nullptr);
+    free(jpeg);
+
+    // A 4xx won't succeed on retry either; only keep the image for
+    // transport errors and server faults
+    if (httpCode >= 200 && httpCode < 500) {
+        drop_oldest();
+        Serial.printf("[SPOOL] Uploaded spooled image: HTTP %d (%d left)\n", httpCode, _count);
+        return true;
+    }
+    Serial.printf("[SPOOL] Upload failed: HTTP %d\n", httpCode);
+    return false;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// Bounded store of JPEGs that could not be uploaded (no network, or the
+// upload failed, or the link was too slow for a full frame), kept on
+// LittleFS with their side and capture time and uploaded oldest-first by the
+// uplink task once an IP link (WiFi or cellular PPP) is back and fast enough
+// for full images (network_manager_payload_class()).
+//
+// Capped at IMAGE_SPOOL_MAX_BYTES / IMAGE_SPOOL_MAX_FILES; storing past
+// either limit evicts the oldest images. Frames are stored as the JPEG the
+// upload would have sent (already compressed; raw captures are encoded by
+// frame_jpeg()). Spooled images are replayed as approach photos with
+// their age so the server dates the event to the capture; the access
+// decision itself was already made when the frame was taken.
+//
+// Called only from the uplink task.
+
+#include <Arduino.h>
+#include "frame_handle.h"
+
+// Index the spool directory. LittleFS must already be mounted
+// (offline_queue_init()).
+void image_spool_init();
+
+// Save the frame's JPEG. Storing the same frame twice (its approach upload
+// and access request both failing) keeps one copy.
+bool image_spool_store(Frame* frame, const char* side);
+
+int image_spool_count();
+
+// Upload the oldest spooled image and delete it once the server has it.
+// Returns true if an image was sent.
+bool image_spool_upload_next();
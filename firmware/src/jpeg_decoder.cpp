@@ -0,0 +1,570 @@
+#include "jpeg_decoder.h"
+#include "phase_arena.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* _lastError = "";
+
+static const uint8_t kZigzag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63,
+};
+
+static const int kLookBits = 9;
+static const int kMaxComponents = 3;
+
+struct HuffTable {
+    bool defined;
+    int32_t maxCode[18];    // largest code of each length, -1 if none
+    int32_t valOffset[17];  // index into values[] minus smallest code of each length
+    uint16_t look[1 << kLookBits];  // (length << 8) | value, 0 = not in fast table
+    uint8_t values[256];
+};
+
+struct Component {
+    int id;
+    int h;
+    int v;
+    int quant;
+    int dcTable;
+    int acTable;
+    int dcPred;
+};
+
+struct Decoder {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+
+    uint32_t bitBuf;
+    int bitCount;
+    bool hitMarker;
+
+    int width;
+    int height;
+    int numComponents;
+    int maxH;
+    int maxV;
+    int restartInterval;
+    bool frameSeen;
+
+    Component comp[kMaxComponents];
+    uint16_t quant[4][64];  // natural (row-major) order
+    bool quantDefined[4];
+    HuffTable dc[2];
+    HuffTable ac[2];
+};
+
+static bool fail(const char* reason) {
+    _lastError = reason;
+    return false;
+}
+
+const char* jpeg_last_error() {
+    return _lastError;
+}
+
+// ===== Marker parsing =====
+
+static int read_u16(Decoder& d) {
+    if (d.pos + 2 > d.len) return -1;
+    int v = (d.data[d.pos] << 8) | d.data[d.pos + 1];
+    d.pos += 2;
+    return v;
+}
+
+static bool parse_dqt(Decoder& d, size_t end) {
+    while (d.pos < end) {
+        uint8_t pq = d.data[d.pos] >> 4;
+        uint8_t tq = d.data[d.pos] & 0x0F;
+        d.pos++;
+        if (tq > 3) return fail("Bad DQT table id");
+        size_t need = pq ? 128 : 64;
+        if (d.pos + need > end) return fail("Truncated DQT");
+        for (int k = 0; k < 64; k++) {
+            uint16_t q = pq ? (uint16_t)((d.data[d.pos + 2 * k] << 8) | d.data[d.pos + 2 * k + 1])
+                            : d.data[d.pos + k];
+            d.quant[tq][kZigzag[k]] = q;
+        }
+        d.quantDefined[tq] = true;
+        d.pos += need;
+    }
+    return true;
+}
+
+// False when the code counts oversubscribe the code space, which would
+// also write past the lookup table.
+static bool build_huffman(HuffTable& t, const uint8_t counts[16]) {
+    memset(t.look, 0, sizeof(t.look));
+    t.defined = false;
+    int code = 0;
+    int k = 0;
+    for (int len = 1; len <= 16; len++) {
+        t.valOffset[len] = k - code;
+        if (code + counts[len - 1] > (1 << len)) return fail("Oversubscribed DHT");
+        for (int i = 0; i < counts[len - 1]; i++) {
+            if (len <= kLookBits) {
+                int shift = kLookBits - len;
+                int base = code << shift;
+                for (int j = 0; j < (1 << shift); j++) {
+                    t.look[base + j] = (uint16_t)((len << 8) | t.values[k]);
+                }
+            }
+            code++;
+            k++;
+        }
+        t.maxCode[len] = counts[len - 1] ? code - 1 : -1;
+        code <<= 1;
+    }
+    t.maxCode[17] = 0x7FFFFFFF;  // sentinel: forces exit on corrupt data
+    t.defined = true;
+    return true;
+}
+
+static bool parse_dht(Decoder& d, size_t end) {
+    while (d.pos < end) {
+        uint8_t tc = d.data[d.pos] >> 4;
+        uint8_t th = d.data[d.pos] & 0x0F;
+        d.pos++;
+        if (tc > 1 || th > 1) return fail("Unsupported DHT table id");
+        if (d.pos + 16 > end) return fail("Truncated DHT");
+        uint8_t counts[16];
+        int total = 0;
+        for (int i = 0; i < 16; i++) {
+            counts[i] = d.data[d.pos + i];
+            total += counts[i];
+        }
+        d.pos += 16;
+        if (total > 256 || d.pos + total > end) return fail("Bad DHT length");
+        HuffTable& t = tc ? d.ac[th] : d.dc[th];
+        memcpy(t.values, d.data + d.pos, total);
+        d.pos += total;
+        if (!build_huffman(t, counts)) return false;
+    }
+    return true;
+}
+
+static bool parse_sof(Decoder& d, size_t end) {
+    if (d.pos + 6 > end) return fail("Truncated SOF");
+    if (d.data[d.pos] != 8) return fail("Only 8-bit precision supported");
+    d.height = (d.data[d.pos + 1] << 8) | d.data[d.pos + 2];
+    d.width = (d.data[d.pos + 3] << 8) | d.data[d.pos + 4];
+    d.numComponents = d.data[d.pos + 5];
+    d.pos += 6;
+    if (d.width <= 0 || d.height <= 0) return fail("Bad image dimensions");
+    if (d.numComponents != 1 && d.numComponents != 3) return fail("Unsupported component count");
+    if (d.pos + 3 * d.numComponents > end) return fail("Truncated SOF");
+
+    d.maxH = 1;
+    d.maxV = 1;
+    for (int i = 0; i < d.numComponents; i++) {
+        Component& c = d.comp[i];
+        c.id = d.data[d.pos];
+        c.h = d.data[d.pos + 1] >> 4;
+        c.v = d.data[d.pos + 1] & 0x0F;
+        c.quant = d.data[d.pos + 2] & 0x03;
+        d.pos += 3;
+        if (c.h < 1 || c.h > 2 || c.v < 1 || c.v > 2) return fail("Unsupported sampling factor");
+        if (c.h > d.maxH) d.maxH = c.h;
+        if (c.v > d.maxV) d.maxV = c.v;
+    }
+    // A single-component scan is non-interleaved: one block per MCU.
+    if (d.numComponents == 1) {
+        d.comp[0].h = d.comp[0].v = 1;
+        d.maxH = d.maxV = 1;
+    }
+    for (int i = 1; i < d.numComponents; i++) {
+        if (d.comp[i].h != 1 || d.comp[i].v != 1) return fail("Unsupported chroma sampling");
+    }
+    d.frameSeen = true;
+    return true;
+}
+
+static bool parse_sos(Decoder& d, size_t end) {
+    if (!d.frameSeen) return fail("SOS before SOF");
+    if (d.pos + 1 > end) return fail("Truncated SOS");
+    int n = d.data[d.pos++];
+    if (n != d.numComponents) return fail("Multi-scan JPEG not supported");
+    if (d.pos + 2 * n + 3 > end) return fail("Truncated SOS");
+    for (int i = 0; i < n; i++) {
+        int id = d.data[d.pos];
+        int tables = d.data[d.pos + 1];
+        d.pos += 2;
+        Component* c = nullptr;
+        for (int j = 0; j < d.numComponents; j++) {
+            if (d.comp[j].id == id) c = &d.comp[j];
+        }
+        if (!c) return fail("SOS references unknown component");
+        c->dcTable = tables >> 4;
+        c->acTable = tables & 0x0F;
+        if (c->dcTable > 1 || c->acTable > 1) return fail("Bad SOS table id");
+        if (!d.dc[c->dcTable].defined || !d.ac[c->acTable].defined) return fail("Missing Huffman table");
+        if (!d.quantDefined[c->quant]) return fail("Missing quantization table");
+    }
+    d.pos = end;  // skip Ss/Se/Ah/Al (fixed for baseline)
+    return true;
+}
+
+// Walk markers up to the start of entropy-coded data (or just through SOF
+// when headerOnly is set).
+static bool parse_headers(Decoder& d, bool headerOnly) {
+    if (d.len < 4 || d.data[0] != 0xFF || d.data[1] != 0xD8) return fail("Not a JPEG");
+    d.pos = 2;
+    while (d.pos < d.len) {
+        if (d.data[d.pos] != 0xFF) {
+            d.pos++;
+            continue;
+        }
+        if (d.pos + 1 >= d.len) break;
+        uint8_t marker = d.data[d.pos + 1];
+        d.pos += 2;
+        if (marker == 0xFF || marker == 0x00 || (marker >= 0xD0 && marker <= 0xD7)) {
+            if (marker == 0xFF) d.pos--;
+            continue;
+        }
+        if (marker == 0xD9) break;
+
+        int segLen = read_u16(d);
+        if (segLen < 2 || d.pos + segLen - 2 > d.len) return fail("Truncated segment");
+        size_t end = d.pos + segLen - 2;
+
+        switch (marker) {
+            case 0xC0:
+            case 0xC1:
+                if (!parse_sof(d, end)) return false;
+                if (headerOnly) return true;
+                break;
+            case 0xC2: case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+            case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF:
+                return fail("Progressive/lossless/arithmetic JPEG not supported");
+            case 0xC4:
+                if (!parse_dht(d, end)) return false;
+                break;
+            case 0xDB:
+                if (!parse_dqt(d, end)) return false;
+                break;
+            case 0xDD:
+                if (segLen != 4) return fail("Bad DRI");
+                d.restartInterval = (d.data[d.pos] << 8) | d.data[d.pos + 1];
+                break;
+            case 0xDA:
+                return parse_sos(d, end);
+            default:
+                break;  // APPn, COM and friends
+        }
+        d.pos = end;
+    }
+    return fail(headerOnly ? "No SOF marker" : "No SOS marker");
+}
+
+// ===== Entropy decoding =====
+
+static void fill_bits(Decoder& d) {
+    while (d.bitCount <= 24) {
+        uint32_t byte = 0;
+        if (!d.hitMarker && d.pos < d.len) {
+            byte = d.data[d.pos];
+            if (byte == 0xFF) {
+                uint8_t next = d.pos + 1 < d.len ? d.data[d.pos + 1] : 0xD9;
+                if (next == 0x00) {
+                    d.pos += 2;
+                } else {
+                    d.hitMarker = true;  // RSTn or EOI: feed zeros until handled
+                    byte = 0;
+                }
+            } else {
+                d.pos++;
+            }
+        }
+        d.bitBuf |= byte << (24 - d.bitCount);
+        d.bitCount += 8;
+    }
+}
+
+static inline uint32_t peek_bits(Decoder& d, int n) {
+    return d.bitBuf >> (32 - n);
+}
+
+static inline void skip_bits(Decoder& d, int n) {
+    d.bitBuf <<= n;
+    d.bitCount -= n;
+}
+
+static inline int get_bits(Decoder& d, int n) {
+    if (n == 0) return 0;
+    if (d.bitCount < n) fill_bits(d);
+    int v = (int)peek_bits(d, n);
+    skip_bits(d, n);
+    return v;
+}
+
+static int decode_huffman(Decoder& d, const HuffTable& t) {
+    if (d.bitCount < 16) fill_bits(d);
+    uint16_t fast = t.look[peek_bits(d, kLookBits)];
+    if (fast) {
+        skip_bits(d, fast >> 8);
+        return fast & 0xFF;
+    }
+    int len = kLookBits + 1;
+    int32_t code = (int32_t)peek_bits(d, len);
+    while (len <= 16 && code > t.maxCode[len]) {
+        len++;
+        code = (int32_t)peek_bits(d, len);
+    }
+    if (len > 16) return -1;
+    skip_bits(d, len);
+    return t.values[t.valOffset[len] + code];
+}
+
+static inline int extend(int v, int bits) {
+    return v < (1 << (bits - 1)) ? v - (1 << bits) + 1 : v;
+}
+
+// Valid 8-bit data dequantizes to within +-2048; corrupt data is clamped
+// so the IDCT's 32-bit sums can't overflow.
+static const int32_t kCoefLimit = 4095;
+
+static inline int32_t dequantize(int v, uint16_t q) {
+    int64_t c = (int64_t)v * q;
+    return c < -kCoefLimit ? -kCoefLimit : c > kCoefLimit ? kCoefLimit : (int32_t)c;
+}
+
+// Decode one 8x8 block. Only the top-left n x n dequantized coefficients are
+// kept; the rest are consumed from the bitstream and discarded.
+static bool decode_block(Decoder& d, Component& c, int n, int32_t* coef) {
+    memset(coef, 0, sizeof(int32_t) * 64);
+    const uint16_t* q = d.quant[c.quant];
+
+    int s = decode_huffman(d, d.dc[c.dcTable]);
+    if (s < 0 || s > 11) return fail("Corrupt DC code");
+    int diff = s ? extend(get_bits(d, s), s) : 0;
+    c.dcPred += diff;
+    if (c.dcPred < -32768 || c.dcPred > 32767) return fail("Corrupt DC value");
+    coef[0] = dequantize(c.dcPred, q[0]);
+
+    for (int k = 1; k < 64; k++) {
+        int rs = decode_huffman(d, d.ac[c.acTable]);
+        if (rs < 0) return fail("Corrupt AC code");
+        int run = rs >> 4;
+        int size = rs & 0x0F;
+        if (size == 0) {
+            if (run != 15) break;  // EOB
+            k += 15;
+            continue;
+        }
+        k += run;
+        if (k > 63) return fail("AC index out of range");
+        int v = extend(get_bits(d, size), size);
+        int pos = kZigzag[k];
+        if ((pos & 7) < n && (pos >> 3) < n) coef[pos] = dequantize(v, q[pos]);
+    }
+    return true;
+}
+
+// ===== Scaled IDCT =====
+
+// kIdct[n][x][u] = round(4096 * C(u)/2 * cos((2x+1)u*pi / 2n)) for n = 1, 2, 4, 8
+static int32_t kIdct[4][8][8];
+static bool _idctReady = false;
+
+static int scale_index(int n) {
+    return n == 8 ? 3 : n == 4 ? 2 : n == 2 ? 1 : 0;
+}
+
+static void init_idct_tables() {
+    if (_idctReady) return;
+    const double pi = 3.14159265358979323846;
+    for (int si = 0; si < 4; si++) {
+        int n = 1 << si;
+        for (int x = 0; x < n; x++) {
+            for (int u = 0; u < n; u++) {
+                double cu = u == 0 ? 1.0 / sqrt(2.0) : 1.0;
+                double v = cu / 2.0 * cos((2 * x + 1) * u * pi / (2.0 * n));
+                kIdct[si][x][u] = (int32_t)lround(v * 4096.0);
+            }
+        }
+    }
+    _idctReady = true;
+}
+
+static inline uint8_t clamp_u8(int v) {
+    return v < 0 ? 0 : v > 255 ? 255 : (uint8_t)v;
+}
+
+// Inverse-transform the top-left n x n coefficients into an n x n pixel block
+// written with the given row stride. Each output pixel approximates the mean
+// of the (8/n) x (8/n) full-resolution pixels it covers.
+static void idct_scaled(const int32_t* coef, int n, uint8_t* out, int stride) {
+    if (n == 1) {
+        out[0] = clamp_u8(((coef[0] + 4) >> 3) + 128);
+        return;
+    }
+    const int32_t (*t)[8] = kIdct[scale_index(n)];
+    int32_t tmp[8 * 8];
+
+    // Rows: tmp[v][x] = sum_u coef[v][u] * T[x][u], kept with 1 extra bit.
+    for (int v = 0; v < n; v++) {
+        const int32_t* row = coef + v * 8;
+        for (int x = 0; x < n; x++) {
+            int32_t acc = 0;
+            for (int u = 0; u < n; u++) acc += row[u] * t[x][u];
+            tmp[v * 8 + x] = (acc + (1 << 10)) >> 11;
+        }
+    }
+    // Columns: out[y][x] = sum_v tmp[v][x] * T[y][v]
+    for (int y = 0; y < n; y++) {
+        for (int x = 0; x < n; x++) {
+            int32_t acc = 0;
+            for (int v = 0; v < n; v++) acc += tmp[v * 8 + x] * t[y][v];
+            out[y * stride + x] = clamp_u8(((acc + (1 << 12)) >> 13) + 128);
+        }
+    }
+}
+
+// ===== Frame decode =====
+
+static bool handle_restart(Decoder& d) {
+    // Drop any buffered bits and step over the RSTn marker.
+    d.bitBuf = 0;
+    d.bitCount = 0;
+    d.hitMarker = false;
+    while (d.pos + 1 < d.len && !(d.data[d.pos] == 0xFF && d.data[d.pos + 1] >= 0xD0 && d.data[d.pos + 1] <= 0xD7)) {
+        d.pos++;
+    }
+    if (d.pos + 1 >= d.len) return fail("Missing restart marker");
+    d.pos += 2;
+    for (int i = 0; i < d.numComponents; i++) d.comp[i].dcPred = 0;
+    return true;
+}
+
+bool jpeg_read_info(const uint8_t* data, size_t len, JpegInfo* info) {
+    if (!data || !info) return fail("Null argument");
+    Decoder* d = (Decoder*)scratch_calloc(sizeof(Decoder));
+    if (!d) return fail("Out of memory");
+    d->data = data;
+    d->len = len;
+    bool ok = parse_headers(*d, true);
+    if (ok) {
+        info->width = d->width;
+        info->height = d->height;
+        info->components = d->numComponents;
+    }
+    scratch_free(d);
+    return ok;
+}
+
+bool jpeg_decode_scaled(const uint8_t* data, size_t len, int scaleDenom,
+                        JpegPixelFormat format, JpegBandCallback callback, void* ctx) {
+    if (!data || !callback) return fail("Null argument");
+    if (scaleDenom != 1 && scaleDenom != 2 && scaleDenom != 4 && scaleDenom != 8) {
+        return fail("Scale must be 1, 2, 4 or 8");
+    }
+    init_idct_tables();
+
+    Decoder* d = (Decoder*)scratch_calloc(sizeof(Decoder));
+    if (!d) return fail("Out of memory");
+    d->data = data;
+    d->len = len;
+    if (!parse_headers(*d, false)) {
+        scratch_free(d);
+        return false;
+    }
+
+    const int n = 8 / scaleDenom;                 // output pixels per block edge
+    const int mcuW = 8 * d->maxH;                 // full-resolution MCU size
+    const int mcuH = 8 * d->maxV;
+    const int mcusX = (d->width + mcuW - 1) / mcuW;
+    const int mcusY = (d->height + mcuH - 1) / mcuH;
+    const int outW = (d->width + scaleDenom - 1) / scaleDenom;
+    const int outH = (d->height + scaleDenom - 1) / scaleDenom;
+    const int bandW = mcusX * d->maxH * n;        // padded to whole MCUs
+    const int bandH = d->maxV * n;
+    const int bpp = format == JpegPixelFormat::Rgb888 ? 3 : 1;
+    const int planes = format == JpegPixelFormat::Gray8 ? 1 : d->numComponents;
+
+    // One MCU row per component plane, plus the interleaved output band.
+    size_t planeBytes = (size_t)bandW * bandH;
+    uint8_t* work = (uint8_t*)scratch_alloc(planeBytes * kMaxComponents + (size_t)bandW * bandH * bpp);
+    if (!work) {
+        scratch_free(d);
+        return fail("Out of memory");
+    }
+    uint8_t* plane[kMaxComponents] = {work, work + planeBytes, work + 2 * planeBytes};
+    uint8_t* band = work + planeBytes * kMaxComponents;
+
+    int32_t coef[64];
+    bool ok = true;
+    int mcuCount = 0;
+
+    for (int my = 0; my < mcusY && ok; my++) {
+        for (int mx = 0; mx < mcusX && ok; mx++) {
+            if (d->restartInterval && mcuCount && mcuCount % d->restartInterval == 0) {
+                ok = handle_restart(*d);
+                if (!ok) break;
+            }
+            mcuCount++;
+
+            for (int ci = 0; ci < d->numComponents && ok; ci++) {
+                Component& c = d->comp[ci];
+                // Component blocks are laid out in its own plane at its own
+                // sampling density; chroma planes are upsampled on output.
+                int planeStride = mcusX * c.h * n;
+                for (int by = 0; by < c.v && ok; by++) {
+                    for (int bx = 0; bx < c.h && ok; bx++) {
+                        ok = decode_block(*d, c, n, coef);
+                        if (ok && ci < planes) {
+                            uint8_t* dst = plane[ci] + (by * n) * planeStride + (mx * c.h + bx) * n;
+                            idct_scaled(coef, n, dst, planeStride);
+                        }
+                    }
+                }
+            }
+        }
+        if (!ok) break;
+
+        // Colour-convert the MCU row into the output band.
+        int rows = outH - my * bandH;
+        if (rows > bandH) rows = bandH;
+        for (int y = 0; y < rows; y++) {
+            uint8_t* out = band + (size_t)y * outW * bpp;
+            const uint8_t* yRow = plane[0] + (size_t)y * bandW;
+            if (bpp == 1 || planes == 1) {
+                if (bpp == 1) {
+                    memcpy(out, yRow, outW);
+                } else {
+                    for (int x = 0; x < outW; x++) out[3 * x] = out[3 * x + 1] = out[3 * x + 2] = yRow[x];
+                }
+                continue;
+            }
+            int cy = y * d->comp[1].v / d->maxV;
+            int chromaStride = mcusX * n;
+            const uint8_t* cbRow = plane[1] + (size_t)cy * chromaStride;
+            const uint8_t* crRow = plane[2] + (size_t)cy * chromaStride;
+            for (int x = 0; x < outW; x++) {
+                int cx = x / d->maxH;
+                int yy = yRow[x];
+                int cb = cbRow[cx] - 128;
+                int cr = crRow[cx] - 128;
+                // ITU-R BT.601 full-range YCbCr -> RGB, 16.16 fixed point
+                out[3 * x]     = clamp_u8(yy + ((91881 * cr + 32768) >> 16));
+                out[3 * x + 1] = clamp_u8(yy - ((22554 * cb + 46802 * cr - 32768) >> 16));
+                out[3 * x + 2] = clamp_u8(yy + ((116130 * cb + 32768) >> 16));
+            }
+        }
+        if (!callback(ctx, my * bandH, outW, rows, band)) {
+            ok = fail("Aborted by callback");
+        }
+    }
+
+    scratch_free(work);
+    scratch_free(d);
+    return ok;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Minimal baseline JPEG decoder with scaled IDCT.
+//
+// Decodes one MCU row at a time and hands each band of pixels to a callback,
+// so a full-resolution RGB frame is never materialized. Supports baseline
+// (SOF0/SOF1) Huffman JPEGs with 1 or 3 components, 1x1/2x1/1x2/2x2 chroma
+// subsampling and restart markers — i.e. everything the OV2640 produces.
+// Progressive and arithmetic-coded files are rejected.
+//
+// Portable C++ (no Arduino dependencies) so it also builds under the
+// PlatformIO `native` env for host-side tests and benchmarks.
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class JpegPixelFormat : uint8_t { Rgb888, Gray8 };
+
+struct JpegInfo {
+    int width;
+    int height;
+    int components;
+};
+
+// Called once per decoded band. `pixels` holds `rows` rows of `width` pixels
+// (3 bytes per pixel for Rgb888, 1 for Gray8), starting at output row `y`.
+// Return false to abort decoding.
+typedef bool (*JpegBandCallback)(void* ctx, int y, int width, int rows, const uint8_t* pixels);
+
+// Parse headers only and report image dimensions.
+bool jpeg_read_info(const uint8_t* data, size_t len, JpegInfo* info);
+
+// Decode at 1/scaleDenom resolution (scaleDenom = 1, 2, 4 or 8) using a
+// reduced-size IDCT. Output dimensions are ceil(width / scaleDenom) x
+// ceil(height / scaleDenom).
+bool jpeg_decode_scaled(const uint8_t* data, size_t len, int scaleDenom,
+                        JpegPixelFormat format, JpegBandCallback callback, void* ctx);
+
+// Human-readable reason for the most recent failure.
+const char* jpeg_last_error();
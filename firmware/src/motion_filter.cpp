@@ -0,0 +1,155 @@
+#include "motion_filter.h"
+#include "jpeg_decoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const int kBlocksX = MOTION_GRID_W / MOTION_BLOCK_CELLS;
+static const int kBlocksY = MOTION_GRID_H / MOTION_BLOCK_CELLS;
+static_assert(MOTION_GRID_W % MOTION_BLOCK_CELLS == 0 && MOTION_GRID_H % MOTION_BLOCK_CELLS == 0,
+              "blocks must tile the grid");
+
+void motion_filter_init(MotionFilter* filter, const MotionFilterConfig& config) {
+    memset(filter, 0, sizeof(*filter));
+    filter->config = config;
+}
+
+static inline uint8_t rgb565_luma(uint8_t hi, uint8_t lo) {
+    uint16_t px = (uint16_t)((hi << 8) | lo);
+    int r = (px >> 11) << 3;
+    int g = ((px >> 5) & 0x3F) << 2;
+    int b = (px & 0x1F) << 3;
+    return (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
+}
+
+bool motion_grid_from_raw(const uint8_t* src, int srcW, int srcH, RawPixelFormat format,
+                          uint8_t* grid) {
+    if (srcW < MOTION_GRID_W || srcH < MOTION_GRID_H) return false;
+    int bpp = format == RawPixelFormat::Rgb565 ? 2 : 1;
+    // Every other pixel in each direction once cells are big enough; the
+    // grid only has to see blob-sized changes
+    int step = (srcW >= 4 * MOTION_GRID_W && srcH >= 4 * MOTION_GRID_H) ? 2 : 1;
+
+    for (int gy = 0; gy < MOTION_GRID_H; gy++) {
+        int y0 = gy * srcH / MOTION_GRID_H;
+        int y1 = (gy + 1) * srcH / MOTION_GRID_H;
+        for (int gx = 0; gx < MOTION_GRID_W; gx++) {
+            int x0 = gx * srcW / MOTION_GRID_W;
+            int x1 = (gx + 1) * srcW / MOTION_GRID_W;
+            uint32_t sum = 0;
+            uint32_t n = 0;
+            for (int y = y0; y < y1; y += step) {
+                const uint8_t* row = src + ((size_t)y * srcW + x0) * bpp;
+                for (int x = x0; x < x1; x += step, row += step * bpp) {
+                    sum += bpp == 2 ? rgb565_luma(row[0], row[1]) : row[0];
+                    n++;
+                }
+            }
+            grid[gy * MOTION_GRID_W + gx] = (uint8_t)(sum / n);
+        }
+    }
+    return true;
+}
+
+struct JpegGrid {
+    int width;   // decoded (1/8 scale) size
+    int height;
+    uint16_t sums[MOTION_GRID_CELLS];
+};
+
+static bool accumulate_band(void* ctx, int y, int width, int rows, const uint8_t* pixels) {
+    JpegGrid& g = *(JpegGrid*)ctx;
+    for (int r = 0; r < rows; r++) {
+        int gy = (y + r) * MOTION_GRID_H / g.height;
+        uint16_t* sums = g.sums + gy * MOTION_GRID_W;
+        const uint8_t* row = pixels + (size_t)r * width;
+        for (int x = 0; x < width; x++) {
+            sums[x * MOTION_GRID_W / g.width] += row[x];
+        }
+    }
+    return true;
+}
+
+bool motion_grid_from_jpeg(const uint8_t* jpeg, size_t len, uint8_t* grid) {
+    JpegInfo info;
+    if (!jpeg_read_info(jpeg, len, &info)) return false;
+
+    // Not reentrant; the vision task is the only caller
+    static JpegGrid g;
+    g.width = (info.width + 7) / 8;
+    g.height = (info.height + 7) / 8;
+    if (g.width < MOTION_GRID_W || g.height < MOTION_GRID_H) return false;
+    // Keep per-cell sums within uint16
+    int cellW = (g.width + MOTION_GRID_W - 1) / MOTION_GRID_W;
+    int cellH = (g.height + MOTION_GRID_H - 1) / MOTION_GRID_H;
+    if (cellW * cellH > 257) return false;
+
+    memset(g.sums, 0, sizeof(g.sums));
+    if (!jpeg_decode_scaled(jpeg, len, 8, JpegPixelFormat::Gray8, accumulate_band, &g)) {
+        return false;
+    }
+
+    for (int gy = 0; gy < MOTION_GRID_H; gy++) {
+        // Same floor mapping as accumulate_band, inverted
+        int rows = (((gy + 1) * g.height + MOTION_GRID_H - 1) / MOTION_GRID_H) -
+                   ((gy * g.height + MOTION_GRID_H - 1) / MOTION_GRID_H);
+        for (int gx = 0; gx < MOTION_GRID_W; gx++) {
+            int cols = (((gx + 1) * g.width + MOTION_GRID_W - 1) / MOTION_GRID_W) -
+                       ((gx * g.width + MOTION_GRID_W - 1) / MOTION_GRID_W);
+            int i = gy * MOTION_GRID_W + gx;
+            grid[i] = (uint8_t)(g.sums[i] / (rows * cols));
+        }
+    }
+    return true;
+}
+
+MotionResult motion_filter_update(MotionFilter* filter, const uint8_t* grid) {
+    const MotionFilterConfig& cfg = filter->config;
+    MotionResult result = {true, 0, kBlocksX * kBlocksY};
+    filter->stats.frames++;
+
+    if (!filter->primed) {
+        memcpy(filter->background, grid, MOTION_GRID_CELLS);
+        filter->primed = true;
+        result.changedBlocks = result.totalBlocks;
+        return result;
+    }
+
+    // Remove a uniform brightness change before comparing cells
+    int32_t delta = 0;
+    for (int i = 0; i < MOTION_GRID_CELLS; i++) delta += grid[i] - filter->background[i];
+    int shift = delta / MOTION_GRID_CELLS;
+
+    const int cellsPerBlock = MOTION_BLOCK_CELLS * MOTION_BLOCK_CELLS;
+    const int needed = (cellsPerBlock * cfg.blockPercent + 99) / 100;
+    for (int by = 0; by < kBlocksY; by++) {
+        for (int bx = 0; bx < kBlocksX; bx++) {
+            int changed = 0;
+            for (int cy = 0; cy < MOTION_BLOCK_CELLS; cy++) {
+                int i = (by * MOTION_BLOCK_CELLS + cy) * MOTION_GRID_W + bx * MOTION_BLOCK_CELLS;
+                for (int cx = 0; cx < MOTION_BLOCK_CELLS; cx++, i++) {
+                    if (abs(grid[i] - filter->background[i] - shift) > cfg.cellThreshold) changed++;
+                }
+            }
+            if (changed >= needed) result.changedBlocks++;
+        }
+    }
+
+    for (int i = 0; i < MOTION_GRID_CELLS; i++) {
+        int bg = filter->background[i];
+        filter->background[i] = (uint8_t)(bg + ((grid[i] - bg) >> cfg.learnShift));
+    }
+
+    result.moved = result.changedBlocks >= cfg.minChangedBlocks;
+    if (result.moved) {
+        filter->consecutiveRejects = 0;
+    } else if (filter->consecutiveRejects >= cfg.maxConsecutiveRejects) {
+        filter->consecutiveRejects = 0;
+        filter->stats.forced++;
+        result.moved = true;
+    } else {
+        filter->consecutiveRejects++;
+        filter->stats.rejected++;
+    }
+    return result;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// Frame-difference prefilter that runs ahead of inference. Each frame is
+// reduced to a MOTION_GRID_W x MOTION_GRID_H grayscale grid and compared
+// with a running-average background; the grid is split into blocks and a
+// block counts as changed when enough of its cells differ by more than a
+// threshold. Frames with too few changed blocks are rejected, so a static
+// scene (swaying plants, an animal lying by the door) doesn't cost a
+// detection or an upload.
+//
+// The background absorbs every frame at a fixed rate, so anything that
+// stops moving fades into it after a few triggers. A global brightness
+// change (lights, clouds) is removed before thresholding. To never lock out
+// an animal that waits motionless at the door, a frame is let through
+// after maxConsecutiveRejects rejections in a row.
+//
+// Portable; builds under the `native` env.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "image_preprocess.h"
+
+#define MOTION_GRID_W 40
+#define MOTION_GRID_H 30
+#define MOTION_GRID_CELLS (MOTION_GRID_W * MOTION_GRID_H)
+#define MOTION_BLOCK_CELLS 5  // blocks are 5x5 cells -> an 8x6 block grid
+
+struct MotionFilterConfig {
+    uint8_t cellThreshold;     // |cell - background| counted as changed
+    uint8_t blockPercent;      // % of a block's cells that must change
+    uint8_t minChangedBlocks;  // changed blocks needed to pass a frame
+    uint8_t learnShift;        // background += (cell - background) >> learnShift
+    uint8_t maxConsecutiveRejects;
+};
+
+struct MotionFilterStats {
+    uint32_t frames;
+    uint32_t rejected;
+    uint32_t forced;  // passed only because of maxConsecutiveRejects
+};
+
+struct MotionFilter {
+    MotionFilterConfig config;
+    uint8_t background[MOTION_GRID_CELLS];
+    bool primed;
+    uint8_t consecutiveRejects;
+    MotionFilterStats stats;
+};
+
+struct MotionResult {
+    bool moved;
+    int changedBlocks;
+    int totalBlocks;
+};
+
+void motion_filter_init(MotionFilter* filter, const MotionFilterConfig& config);
+
+// Box-average an uncompressed frame into a MOTION_GRID_CELLS grid.
+bool motion_grid_from_raw(const uint8_t* src, int srcW, int srcH, RawPixelFormat format,
+                          uint8_t* grid);
+
+// Same for a JPEG frame, decoded in grayscale at 1/8 scale.
+bool motion_grid_from_jpeg(const uint8_t* jpeg, size_t len, uint8_t* grid);
+
+// Compare `grid` with the background, then fold it in. The first frame
+// after init only seeds the background and is reported as moved.
+MotionResult motion_filter_update(MotionFilter* filter, const uint8_t* grid);
@@ -0,0 +1,93 @@
+#include "multipart_writer.h"
+
+#include <string.h>
+
+// Small-write coalescer: part headers and short fields are gathered here so
+// a TLS sink sees a few large records instead of one per header line.
+struct Emitter {
+    MultipartSink sink;
+    void* ctx;
+    uint8_t buf[256];
+    size_t used;
+    bool ok;
+};
+
+static void flush(Emitter& e) {
+    if (e.ok && e.used > 0) e.ok = e.sink(e.ctx, e.buf, e.used);
+    e.used = 0;
+}
+
+// Large payloads bypass the buffer and go to the sink as-is.
+static void emit_raw(Emitter& e, const uint8_t* data, size_t len) {
+    if (len == 0) return;
+    flush(e);
+    if (e.ok) e.ok = e.sink(e.ctx, data, len);
+}
+
+static void emit(Emitter& e, const char* text) {
+    size_t len = strlen(text);
+    if (len > sizeof(e.buf)) {
+        emit_raw(e, (const uint8_t*)text, len);
+        return;
+    }
+    if (e.used + len > sizeof(e.buf)) flush(e);
+    memcpy(e.buf + e.used, text, len);
+    e.used += len;
+}
+
+void multipart_begin(MultipartBody* body, const char* fileField, const char* fileName,
+                     const char* fileType, const uint8_t* file, size_t fileLen) {
+    memset(body, 0, sizeof(*body));
+    body->fileField = fileField;
+    body->fileName = fileName;
+    body->fileType = fileType;
+    body->file = file;
+    body->fileLen = fileLen;
+}
+
+bool multipart_add_field(MultipartBody* body, const char* name, const char* value) {
+    if (!value || !value[0]) return true;
+    if (body->fieldCount >= MULTIPART_MAX_FIELDS) return false;
+    body->fieldNames[body->fieldCount] = name;
+    body->fieldValues[body->fieldCount] = value;
+    body->fieldCount++;
+    return true;
+}
+
+bool multipart_write(const MultipartBody& body, MultipartSink sink, void* ctx) {
+    Emitter e;
+    e.sink = sink;
+    e.ctx = ctx;
+    e.used = 0;
+    e.ok = true;
+
+    emit(e, "--" MULTIPART_BOUNDARY "\r\nContent-Disposition: form-data; name=\"");
+    emit(e, body.fileField);
+    emit(e, "\"; filename=\"");
+    emit(e, body.fileName);
+    emit(e, "\"\r\nContent-Type: ");
+    emit(e, body.fileType);
+    emit(e, "\r\n\r\n");
+    emit_raw(e, body.file, body.fileLen);
+
+    for (int i = 0; i < body.fieldCount; i++) {
+        emit(e, "\r\n--" MULTIPART_BOUNDARY "\r\nContent-Disposition: form-data; name=\"");
+        emit(e, body.fieldNames[i]);
+        emit(e, "\"\r\n\r\n");
+        emit(e, body.fieldValues[i]);
+    }
+    emit(e, "\r\n--" MULTIPART_BOUNDARY "--\r\n");
+    flush(e);
+    return e.ok;
+}
+
+static bool count_sink(void* ctx, const uint8_t*, size_t len) {
+    *(size_t*)ctx += len;
+    return true;
+}
+
+size_t multipart_content_length(const MultipartBody& body) {
+    size_t total = 0;
+    multipart_write(body, count_sink, &total);
+    return total;
+}
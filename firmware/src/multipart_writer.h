@@ -0,0 +1,47 @@
+#pragma once
+
+// Streaming multipart/form-data encoder for image uploads.
+//
+// The body is described, not built: one file part (the JPEG, referenced in
+// place) plus a few short text fields. multipart_write() emits it to a sink
+// in three kinds of writes — the part headers (coalesced in a small stack
+// buffer), the file bytes straight from the caller's buffer, and the
+// trailing fields — so an upload never needs a second copy of the frame.
+// multipart_content_length() runs the same encoder with a counting sink, so
+// the advertised Content-Length always matches what is sent.
+//
+// Portable; builds under the `native` env.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MULTIPART_BOUNDARY "----ESP32CAMBoundary"
+#define MULTIPART_CONTENT_TYPE "multipart/form-data; boundary=" MULTIPART_BOUNDARY
+#define MULTIPART_MAX_FIELDS 10
+
+struct MultipartBody {
+    const char* fileField;   // form field name, e.g. "image"
+    const char* fileName;    // e.g. "capture.jpg"
+    const char* fileType;    // e.g. "image/jpeg"
+    const uint8_t* file;     // not copied; must stay valid until written
+    size_t fileLen;
+    const char* fieldNames[MULTIPART_MAX_FIELDS];
+    const char* fieldValues[MULTIPART_MAX_FIELDS];
+    int fieldCount;
+};
+
+// Receives consecutive chunks of the encoded body. Return false to abort.
+typedef bool (*MultipartSink)(void* ctx, const uint8_t* data, size_t len);
+
+void multipart_begin(MultipartBody* body, const char* fileField, const char* fileName,
+                     const char* fileType, const uint8_t* file, size_t fileLen);
+
+// Append a text field after the file part. Null or empty values are skipped
+// (returns true); returns false if MULTIPART_MAX_FIELDS is exceeded.
+bool multipart_add_field(MultipartBody* body, const char* name, const char* value);
+
+// Exact encoded size in bytes.
+size_t multipart_content_length(const MultipartBody& body);
+
+// Encode `body` into `sink`. Returns false if the sink rejected a write.
+bool multipart_write(const MultipartBody& body, MultipartSink sink, void* ctx);
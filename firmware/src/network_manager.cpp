@@ -3,13 +3,21 @@
 #include "wifi_manager.h"
 #include "cellular_manager.h"
 #include "offline_queue.h"
-#include <HTTPClient.h>
-#include <WiFiClientSecure.h>
-#include <ArduinoJson.h>
+#include "api_connection.h"
+#include "payload_class.h"
 
 static NetworkTransport _transport = NetworkTransport::None;
 static bool _cellularReady = false;
-static WiFiClientSecure _secureClient;
+static unsigned long _lastDialFailure = 0;
+static bool _dialFailed = false;
+static LinkEstimator _link;
+
+// Bytes a socket write can return for before they have left the device
+#ifdef CONFIG_LWIP_TCP_SND_BUF_DEFAULT
+static const size_t kSendBufferBytes = CONFIG_LWIP_TCP_SND_BUF_DEFAULT;
+#else
+static const size_t kSendBufferBytes = 5744;
+#endif
 
 void network_manager_init() {
     _cellularReady = cellular_init();
@@ -17,32 +25,56 @@ void network_manager_init() {
         Serial.println("[NET] Cellular available");
     }
 
-#if API_INSECURE_TLS
-    _secureClient.setInsecure();
-    Serial.println("[NET] TLS: certificate verification disabled (dev mode)");
-#else
-    if (strlen(API_CA_CERT) > 0) {
-        _secureClient.setCACert(API_CA_CERT);
-        Serial.println("[NET] TLS: CA certificate loaded");
-    } else {
-        _secureClient.setInsecure();
-        Serial.println("[NET] TLS: no CA cert provided, verification disabled");
-    }
-#endif
+    api_connection_init();
+
+    PayloadPolicy policy = {PAYLOAD_FULL_MIN_BYTES_PER_SEC, PAYLOAD_REDUCED_MIN_BYTES_PER_SEC,
+                            PAYLOAD_HYSTERESIS_PERCENT, PAYLOAD_ESTIMATE_STALE_MS};
+    link_estimator_init(&_link, policy);
 }
 
+#if CELLULAR_USE_PPP
+// Cellular only counts once PPP is up; redials are spaced out after a failure
+static bool cellular_link_up() {
+    if (cellular_data_up()) return true;
+    if (_dialFailed && millis() - _lastDialFailure < CELLULAR_PPP_RETRY_INTERVAL_MS) return false;
+    _dialFailed = !cellular_data_start();
+    if (_dialFailed) _lastDialFailure = millis();
+    return !_dialFailed;
+}
+#endif
+
 void network_manager_ensure_connected() {
+    NetworkTransport previous = _transport;
     wifi_ensure_connected();
     if (wifi_is_connected()) {
         _transport = NetworkTransport::WiFi;
-        return;
-    }
-    // Fall back to cellular
-    if (_cellularReady && cellular_is_registered()) {
+#if CELLULAR_USE_PPP
+        // Back on WiFi; hang up rather than pay for an idle data session
+        if (cellular_data_up()) cellular_data_stop();
+#endif
+    } else if (_cellularReady && cellular_is_registered()) {
+        // Fall back to cellular
+#if CELLULAR_USE_PPP
+        _transport = cellular_link_up() ? NetworkTransport::Cellular : NetworkTransport::None;
+#else
         _transport = NetworkTransport::Cellular;
+#endif
     } else {
         _transport = NetworkTransport::None;
     }
+
+    if (_transport != previous && network_manager_has_ip()) {
+        // Sockets opened on the other interface are dead
+        api_connection_close();
+        if (_transport == NetworkTransport::WiFi) {
+            link_estimator_reset(&_link, PayloadClass::Full, PayloadClass::Full);
+        } else {
+            link_estimator_reset(&_link, PAYLOAD_CELLULAR_MAX_CLASS, PAYLOAD_CELLULAR_MAX_CLASS);
+        }
+        Serial.printf("[NET] Transport: %s, payload %s\n",
+                      _transport == NetworkTransport::WiFi ? "WiFi" : "cellular (PPP)",
+                      payload_class_name(link_estimator_class(&_link, millis())));
+    }
 }
 
 NetworkTransport network_manager_get_transport() {
@@ -53,34 +85,77 @@ bool network_manager_is_connected() {
     return _transport != NetworkTransport::None;
 }
 
-int network_manager_http_post_json(const char* url, const String& body) {
-    if (_transport == NetworkTransport::WiFi) {
-        HTTPClient http;
-        http.begin(_secureClient, url);
-        http.addHeader("Content-Type", "application/json");
-        http.setTimeout(API_TIMEOUT_MS);
-        int code = http.POST(body);
-        http.end();
-        return code;
+PayloadClass network_manager_payload_class() {
+    return link_estimator_class(&_link, millis());
+}
+
+bool network_manager_has_ip() {
+    return _transport == NetworkTransport::WiFi ||
+           (CELLULAR_USE_PPP && _transport == NetworkTransport::Cellular);
+}
+
+static bool write_buffer(Client& out, const void* ctx) {
+    const char* body = (const char*)ctx;
+    size_t len = strlen(body);
+    return out.write((const uint8_t*)body, len) == len;
+}
+
+int network_manager_http_post_json(const char* url, const char* body,
+                                   char* response, size_t responseCap) {
+    if (network_manager_has_ip()) {
+        if (response && responseCap) response[0] = '\0';
+        HttpResponseBuffer buffer = {response, responseCap};
+        return api_connection_post(url, "application/json", strlen(body), write_buffer, body,
+                                   response ? http_read_into_buffer : nullptr, &buffer);
     }
     if (_transport == NetworkTransport::Cellular) {
+        if (response && responseCap) response[0] = '\0';
         return cellular_http_post(url, "application/json",
-            (const uint8_t*)body.c_str(), body.length());
+            (const uint8_t*)body, strlen(body));
     }
     return -1;
 }
 
-int network_manager_http_post_multipart(const char* url, const uint8_t* body, size_t len, const char* contentType) {
-    if (_transport == NetworkTransport::WiFi) {
-        HTTPClient http;
-        http.begin(_secureClient, url);
-        http.addHeader("Content-Type", contentType);
-        http.setTimeout(API_TIMEOUT_MS);
-        int code = http.POST(const_cast<uint8_t*>(body), len);
-        http.end();
-        return code;
+static bool client_sink(void* ctx, const uint8_t* data, size_t len) {
+    Client& client = *(Client*)ctx;
+    while (len > 0) {
+        size_t written = client.write(data, len);
+        if (written == 0) return false;
+        data += written;
+        len -= written;
+    }
+    return true;
+}
+
+// Image uploads double as throughput probes for the payload class
+static bool write_multipart(Client& out, const void* ctx) {
+    const MultipartBody& body = *(const MultipartBody*)ctx;
+    uint32_t start = micros();
+    if (!multipart_write(body, client_sink, &out)) return false;
+    uint32_t elapsed = micros() - start;
+
+    // The tail of the body may still be sitting in the send buffer; only
+    // what had to leave it says anything about the link
+    size_t len = multipart_content_length(body);
+    if (len > kSendBufferBytes) {
+        PayloadClass before = _link.current;
+        link_estimator_record(&_link, len - kSendBufferBytes, elapsed, millis());
+        if (_link.current != before) {
+            Serial.printf("[NET] Payload class: %s (%lu B/s)\n",
+                          payload_class_name(_link.current), (unsigned long)_link.bytesPerSec);
+        }
+    }
+    return true;
+}
+
+int network_manager_http_post_multipart(const char* url, const MultipartBody& body,
+                                        HttpResponseReader readBody, void* readCtx) {
+    if (network_manager_has_ip()) {
+        return api_connection_post(url, MULTIPART_CONTENT_TYPE,
+                                   multipart_content_length(body), write_multipart, &body,
+                                   readBody, readCtx);
     }
-    // Cellular can't handle large JPEG payloads
-    Serial.println("[NET] Multipart skipped: WiFi unavailable, queuing event");
+    // The modem's AT HTTP stack can't take large JPEG payloads
+    Serial.println("[NET] Multipart skipped: no IP transport, queuing event");
     return -1;
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <Arduino.h>
+#include "multipart_writer.h"
+#include "payload_class.h"
+#include "http_stream.h"
 
 enum class NetworkTransport { None, WiFi, Cellular };
 
@@ -8,5 +11,19 @@ void network_manager_init();
 void network_manager_ensure_connected();
 NetworkTransport network_manager_get_transport();
 bool network_manager_is_connected();
-int network_manager_http_post_json(const char* url, const String& body);
-int network_manager_http_post_multipart(const char* url, const uint8_t* body, size_t len, const char* contentType);
+// WiFi, or cellular in PPP data mode: sockets work, so the TLS pool and
+// image uploads can use it (see api_connection.h).
+bool network_manager_has_ip();
+// Image to send on the current link, from the measured throughput of recent
+// uploads (see payload_class.h). Cellular is capped at
+// PAYLOAD_CELLULAR_MAX_CLASS.
+PayloadClass network_manager_payload_class();
+// The response body is copied into `response` when non-null and the link has
+// IP (the modem's AT HTTP stack doesn't return it; `response` is left empty).
+int network_manager_http_post_json(const char* url, const char* body,
+                                   char* response = nullptr, size_t responseCap = 0);
+// Stream a multipart upload (file part written in place). The response body
+// is handed to `readBody` when non-null (see http_stream.h). Returns the
+// HTTP status, or -1 when no transport can carry the upload.
+int network_manager_http_post_multipart(const char* url, const MultipartBody& body,
+                                        HttpResponseReader readBody, void* readCtx);
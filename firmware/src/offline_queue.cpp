@@ -1,10 +1,117 @@
 #include "offline_queue.h"
 #include "config.h"
+#include "network_manager.h"
+#include "ring_log.h"
 #include <LittleFS.h>
-#include <HTTPClient.h>
 #include <ArduinoJson.h>
 
-static const char* QUEUE_DIR = "/queue";
+// The ring log's region is stored as a small header file plus fixed-size
+// segment files of one LittleFS block each. LittleFS rewrites a file from
+// the modified block onwards, so one large file would be copied on every
+// header commit; with one block per file each push or pop touches only the
+// block it changes, and LittleFS's copy-on-write moves that block around
+// the partition.
+static const char* LOG_DIR = "/qlog";
+static const char* LEGACY_QUEUE_DIR = "/queue";
+static const uint32_t HEADER_REGION = 2 * RING_LOG_HEADER_BYTES;
+static const uint32_t SEGMENT_COUNT =
+    (OFFLINE_QUEUE_MAX_EVENTS * OFFLINE_QUEUE_SLOT_BYTES + OFFLINE_QUEUE_SEGMENT_BYTES - 1) /
+    OFFLINE_QUEUE_SEGMENT_BYTES;
+static_assert(OFFLINE_QUEUE_SEGMENT_BYTES % OFFLINE_QUEUE_SLOT_BYTES == 0,
+              "slots must not straddle segment files");
+
+static RingLog _log;
+static bool _ready = false;
+
+static void region_path(uint32_t offset, char* path, size_t cap, uint32_t* fileOffset) {
+    if (offset < HEADER_REGION) {
+        snprintf(path, cap, "%s/hdr", LOG_DIR);
+        *fileOffset = offset;
+    } else {
+        offset -= HEADER_REGION;
+        snprintf(path, cap, "%s/%02u", LOG_DIR, (unsigned)(offset / OFFLINE_QUEUE_SEGMENT_BYTES));
+        *fileOffset = offset % OFFLINE_QUEUE_SEGMENT_BYTES;
+    }
+}
+
+static bool fs_read(void*, uint32_t offset, void* buf, size_t len) {
+    char path[24];
+    uint32_t at;
+    region_path(offset, path, sizeof(path), &at);
+    File f = LittleFS.open(path, "r");
+    if (!f || !f.seek(at)) return false;
+    bool ok = f.read((uint8_t*)buf, len) == len;
+    f.close();
+    return ok;
+}
+
+static bool fs_write(void*, uint32_t offset, const void* buf, size_t len) {
+    char path[24];
+    uint32_t at;
+    region_path(offset, path, sizeof(path), &at);
+    File f = LittleFS.open(path, "r+");
+    if (!f || !f.seek(at)) return false;
+    bool ok = f.write((const uint8_t*)buf, len) == len;
+    f.close();  // close commits the block
+    return ok;
+}
+
+// Create (or regrow) a zero-filled file of exactly `size` bytes.
+static bool preallocate(const char* path, size_t size) {
+    if (LittleFS.exists(path)) {
+        File f = LittleFS.open(path, "r");
+        bool ok = f && f.size() == size;
+        f.close();
+        if (ok) return true;
+    }
+    File f = LittleFS.open(path, "w");
+    if (!f) return false;
+    uint8_t zeros[128] = {};
+    for (size_t n = 0; n < size; n += sizeof(zeros)) {
+        size_t chunk = size - n < sizeof(zeros) ? size - n : sizeof(zeros);
+        if (f.write(zeros, chunk) != chunk) {
+            f.close();
+            return false;
+        }
+    }
+    f.close();
+    return true;
+}
+
+static bool push_record(const char* json, size_t len) {
+    if (!ring_log_push(&_log, json, len)) return false;
+    if (_log.dropped > 0 && ring_log_size(&_log) == OFFLINE_QUEUE_MAX_EVENTS) {
+        Serial.printf("[WARN] Offline queue full; %lu oldest events overwritten\n",
+                      (unsigned long)_log.dropped);
+    }
+    return true;
+}
+
+// Move events queued by older firmware (one JSON file each) into the log.
+static void migrate_legacy_queue() {
+    File dir = LittleFS.open(LEGACY_QUEUE_DIR);
+    if (!dir || !dir.isDirectory()) return;
+
+    int moved = 0;
+    char buf[OFFLINE_QUEUE_SLOT_BYTES];
+    File entry = dir.openNextFile();
+    while (entry) {
+        char path[48];
+        snprintf(path, sizeof(path), "%s/%s", LEGACY_QUEUE_DIR, entry.name());
+        bool isFile = !entry.isDirectory();
+        size_t len = isFile ? entry.read((uint8_t*)buf, sizeof(buf)) : 0;
+        entry.close();
+        if (isFile && len <= OFFLINE_QUEUE_SLOT_BYTES - RING_LOG_RECORD_OVERHEAD &&
+            push_record(buf, len)) {
+            moved++;
+        }
+        LittleFS.remove(path);
+        entry = dir.openNextFile();
+    }
+    dir.close();
+    LittleFS.rmdir(LEGACY_QUEUE_DIR);
+    if (moved) Serial.printf("[QUEUE] Migrated %d legacy queued events\n", moved);
+}
 
 void offline_queue_init() {
     if (!LittleFS.begin(true)) {
@@ -12,30 +119,34 @@ void offline_queue_init() {
         LittleFS.format();
         LittleFS.begin();
     }
-    if (!LittleFS.exists(QUEUE_DIR)) {
-        LittleFS.mkdir(QUEUE_DIR);
+    if (!LittleFS.exists(LOG_DIR)) {
+        LittleFS.mkdir(LOG_DIR);
     }
-    Serial.printf("[OK] Offline queue ready (%d events)\n", offline_queue_size());
-}
 
-bool offline_queue_push(const QueuedEvent& event) {
-    if (offline_queue_size() >= OFFLINE_QUEUE_MAX_EVENTS) {
-        Serial.println("[WARN] Offline queue full; dropping event");
-        return false;
+    char path[24];
+    uint32_t unused;
+    bool allocated = true;
+    region_path(0, path, sizeof(path), &unused);
+    allocated &= preallocate(path, HEADER_REGION);
+    for (uint32_t i = 0; i < SEGMENT_COUNT; i++) {
+        region_path(HEADER_REGION + i * OFFLINE_QUEUE_SEGMENT_BYTES, path, sizeof(path), &unused);
+        allocated &= preallocate(path, OFFLINE_QUEUE_SEGMENT_BYTES);
     }
 
-    // Find next free index
-    int idx = 0;
-    while (true) {
-        char path[32];
-        snprintf(path, sizeof(path), "%s/%03d.json", QUEUE_DIR, idx);
-        if (!LittleFS.exists(path)) break;
-        idx++;
-        if (idx >= OFFLINE_QUEUE_MAX_EVENTS) return false;
+    RingLogIo io = {fs_read, fs_write, nullptr, nullptr};
+    _ready = allocated && ring_log_open(&_log, io, OFFLINE_QUEUE_MAX_EVENTS, OFFLINE_QUEUE_SLOT_BYTES);
+    if (!_ready) {
+        Serial.println("[WARN] Offline queue storage unavailable; events will be dropped");
+        return;
     }
 
-    char path[32];
-    snprintf(path, sizeof(path), "%s/%03d.json", QUEUE_DIR, idx);
+    migrate_legacy_queue();
+    Serial.printf("[OK] Offline queue ready (%d/%d events)\n",
+                  offline_queue_size(), OFFLINE_QUEUE_MAX_EVENTS);
+}
+
+bool offline_queue_push(const QueuedEvent& event) {
+    if (!_ready) return false;
 
     JsonDocument doc;
     doc["eventType"] = event.eventType;
@@ -43,63 +154,83 @@ bool offline_queue_push(const QueuedEvent& event) {
     doc["batteryVoltage"] = event.batteryVoltage;
     doc["apiKey"] = event.apiKey;
     doc["timestamp"] = (unsigned long)event.timestamp;
+    char key[17];
+    snprintf(key, sizeof(key), "%08lx%08lx", (unsigned long)esp_random(), (unsigned long)esp_random());
+    doc["idempotencyKey"] = key;
+
+    char buf[OFFLINE_QUEUE_SLOT_BYTES - RING_LOG_RECORD_OVERHEAD];
+    size_t len = measureJson(doc);
+    if (len >= sizeof(buf)) {
+        // Notes are informational; keep the event rather than the detail
+        doc.remove("notes");
+        len = measureJson(doc);
+    }
+    if (len >= sizeof(buf)) {
+        Serial.printf("[WARN] Event %s too large to queue\n", event.eventType);
+        return false;
+    }
+    len = serializeJson(doc, buf, sizeof(buf));
 
-    File f = LittleFS.open(path, "w");
-    if (!f) return false;
-    serializeJson(doc, f);
-    f.close();
-
-    Serial.printf("[QUEUE] Queued event: %s\n", event.eventType.c_str());
+    if (!push_record(buf, len)) {
+        Serial.println("[WARN] Offline queue write failed; dropping event");
+        return false;
+    }
+    Serial.printf("[QUEUE] Queued event: %s\n", event.eventType);
     return true;
 }
 
 int offline_queue_size() {
-    int count = 0;
-    File dir = LittleFS.open(QUEUE_DIR);
-    if (!dir || !dir.isDirectory()) return 0;
-    File entry = dir.openNextFile();
-    while (entry) {
-        if (!entry.isDirectory()) count++;
-        entry = dir.openNextFile();
-    }
-    return count;
+    return _ready ? (int)ring_log_size(&_log) : 0;
 }
 
-int offline_queue_flush(const char* baseUrl, const char* endpoint) {
-    int flushed = 0;
-    File dir = LittleFS.open(QUEUE_DIR);
-    if (!dir || !dir.isDirectory()) return 0;
-
-    File entry = dir.openNextFile();
-    while (entry) {
-        if (entry.isDirectory()) {
-            entry = dir.openNextFile();
+// Batch request body; only the uplink task flushes
+static char _batchBody[OFFLINE_QUEUE_BATCH_MAX_BYTES];
+
+int offline_queue_flush(const char* url) {
+    if (!_ready || ring_log_size(&_log) == 0) return 0;
+
+    // Records are stored as JSON objects, so the batch body is just the
+    // records joined into an array
+    static const char HEAD[] = "{\"events\":[";
+    memcpy(_batchBody, HEAD, sizeof(HEAD) - 1);
+    size_t bodyLen = sizeof(HEAD) - 1;
+    char buf[OFFLINE_QUEUE_SLOT_BYTES];
+    uint32_t covered = 0;  // records the batch accounts for, corrupt ones included
+    int events = 0;
+    int corrupt = 0;
+
+    while (covered < ring_log_size(&_log) && events < OFFLINE_QUEUE_BATCH_MAX_EVENTS) {
+        int len = ring_log_peek(&_log, covered, buf, sizeof(buf) - 1);
+        if (len == -1) {
+            corrupt++;
+            covered++;
             continue;
         }
-
-        String path = String(QUEUE_DIR) + "/" + entry.name();
-        String content = entry.readString();
-        entry.close();
-
-        HTTPClient http;
-        String url = String(baseUrl) + String(endpoint);
-        http.begin(url);
-        http.addHeader("Content-Type", "application/json");
-        http.setTimeout(API_TIMEOUT_MS);
-
-        int code = http.POST(content);
-        http.end();
-
-        if (code == 204 || code == 200) {
-            LittleFS.remove(path);
-            flushed++;
-            Serial.printf("[QUEUE] Flushed: %s (HTTP %d)\n", path.c_str(), code);
-        } else {
-            Serial.printf("[QUEUE] Flush failed: %s (HTTP %d)\n", path.c_str(), code);
+        if (len < 0) break;
+        // Room for the comma, the closing "]}" and the NUL
+        if (bodyLen + len + 4 > sizeof(_batchBody)) break;
+        if (events > 0) _batchBody[bodyLen++] = ',';
+        memcpy(_batchBody + bodyLen, buf, len);
+        bodyLen += len;
+        events++;
+        covered++;
+    }
+    memcpy(_batchBody + bodyLen, "]}", 3);
+    if (corrupt) Serial.printf("[QUEUE] Skipping %d corrupt queued events\n", corrupt);
+
+    if (events > 0) {
+        int code = network_manager_http_post_json(url, _batchBody);
+        if (code != 200 && code != 204) {
+            // Keep the events; the retry carries the same idempotency keys
+            Serial.printf("[QUEUE] Batch of %d failed (HTTP %d), %d events pending\n",
+                          events, code, offline_queue_size());
+            return 0;
         }
-
-        entry = dir.openNextFile();
     }
 
-    return flushed;
+    ring_log_pop(&_log, covered);
+    if (events > 0) {
+        Serial.printf("[QUEUE] Flushed %d events, %d pending\n", events, offline_queue_size());
+    }
+    return events;
 }
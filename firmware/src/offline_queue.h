@@ -3,14 +3,19 @@
 #include <Arduino.h>
 
 struct QueuedEvent {
-    String eventType;
-    String notes;
+    const char* eventType;
+    char notes[64];
     double batteryVoltage;
-    String apiKey;
+    const char* apiKey;
     unsigned long timestamp;
 };
 
 void offline_queue_init();
 bool offline_queue_push(const QueuedEvent& event);
 int offline_queue_size();
-int offline_queue_flush(const char* baseUrl, const char* endpoint);
+// Post the oldest queued events as one batch (up to
+// OFFLINE_QUEUE_BATCH_MAX_EVENTS) to the batch endpoint and drop them once
+// the server accepts it. Each event carries an idempotency key assigned at
+// push time, so resending a batch whose response was lost records nothing
+// twice. `url` is the batch endpoint. Returns the number of events sent.
+int offline_queue_flush(const char* url);
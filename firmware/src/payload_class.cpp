@@ -0,0 +1,72 @@
+#include "payload_class.h"
+
+#include <string.h>
+
+static PayloadClass worse(PayloadClass a, PayloadClass b) {
+    return (uint8_t)a > (uint8_t)b ? a : b;
+}
+
+static PayloadClass for_rate(const PayloadPolicy& p, uint32_t rate) {
+    if (rate >= p.fullMinBytesPerSec) return PayloadClass::Full;
+    if (rate >= p.reducedMinBytesPerSec) return PayloadClass::Reduced;
+    return PayloadClass::Thumbnail;
+}
+
+// Dropping happens at the threshold; climbing only once the rate clears it
+// by the hysteresis margin
+static PayloadClass classify(const PayloadPolicy& p, PayloadClass current, uint32_t rate) {
+    PayloadClass cls = for_rate(p, rate);
+    if ((uint8_t)cls >= (uint8_t)current) return cls;
+    uint32_t discounted = (uint32_t)((uint64_t)rate * 100 / (100 + p.hysteresisPercent));
+    PayloadClass up = for_rate(p, discounted);
+    return (uint8_t)up < (uint8_t)current ? up : current;
+}
+
+void link_estimator_init(LinkEstimator* est, const PayloadPolicy& policy) {
+    memset(est, 0, sizeof(*est));
+    est->policy = policy;
+    link_estimator_reset(est, PayloadClass::Full, PayloadClass::Full);
+}
+
+void link_estimator_reset(LinkEstimator* est, PayloadClass initial, PayloadClass ceiling) {
+    est->ceiling = ceiling;
+    est->initial = worse(initial, ceiling);
+    est->current = est->initial;
+    est->valid = false;
+    est->bytesPerSec = 0;
+    est->samples = 0;
+}
+
+void link_estimator_record(LinkEstimator* est, uint32_t bytes, uint32_t us, uint32_t nowMs) {
+    if (bytes == 0 || us == 0) return;
+    uint32_t rate = (uint32_t)((uint64_t)bytes * 1000000 / us);
+
+    if (!est->valid || (uint32_t)(nowMs - est->lastSampleMs) > est->policy.staleMs) {
+        est->bytesPerSec = rate;
+        est->valid = true;
+    } else {
+        // EWMA, weight 1/4 on the new sample
+        int64_t delta = (int64_t)rate - est->bytesPerSec;
+        est->bytesPerSec = (uint32_t)((int64_t)est->bytesPerSec + delta / 4);
+    }
+    est->lastSampleMs = nowMs;
+    est->samples++;
+    est->current = worse(classify(est->policy, est->current, est->bytesPerSec), est->ceiling);
+}
+
+PayloadClass link_estimator_class(LinkEstimator* est, uint32_t nowMs) {
+    if (est->valid && (uint32_t)(nowMs - est->lastSampleMs) > est->policy.staleMs) {
+        est->valid = false;
+        est->current = est->initial;
+    }
+    return est->current;
+}
+
+const char* payload_class_name(PayloadClass cls) {
+    switch (cls) {
+        case PayloadClass::Full: return "full";
+        case PayloadClass::Reduced: return "reduced";
+        case PayloadClass::Thumbnail: return "thumbnail";
+    }
+    return "full";
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Chooses how much image to send per upload from the measured throughput of
+// the current link.
+//
+// Every multipart upload reports how many body bytes it pushed and how long
+// the socket took to accept them; the estimator keeps an exponentially
+// weighted average of those rates. The class falls from Full (the frame's
+// upload JPEG) to Reduced (a smaller, lower-quality JPEG) to Thumbnail (a
+// grayscale thumbnail plus its dHash) as the estimate drops, and climbs back
+// only once the rate clears the next threshold by hysteresisPercent, so a
+// link near a threshold doesn't flap.
+//
+// Each transport starts at its own initial class and never goes above its
+// ceiling (cellular is metered: Reduced at best). An estimate older than
+// staleMs is dropped, so the link is re-probed at the initial class instead
+// of being stuck on thumbnails, which are too small to measure.
+//
+// Portable; builds under the `native` env.
+
+#include <stdint.h>
+
+// Ordered best to worst
+enum class PayloadClass : uint8_t { Full, Reduced, Thumbnail };
+
+struct PayloadPolicy {
+    uint32_t fullMinBytesPerSec;     // below this, Reduced
+    uint32_t reducedMinBytesPerSec;  // below this, Thumbnail
+    uint8_t hysteresisPercent;       // margin needed to move up a class
+    uint32_t staleMs;                // estimate lifetime without new samples
+};
+
+struct LinkEstimator {
+    PayloadPolicy policy;
+    PayloadClass initial;
+    PayloadClass ceiling;
+    PayloadClass current;
+    bool valid;                // at least one sample since the last reset
+    uint32_t bytesPerSec;      // smoothed estimate
+    uint32_t lastSampleMs;
+    uint32_t samples;
+};
+
+void link_estimator_init(LinkEstimator* est, const PayloadPolicy& policy);
+
+// Start over for a new transport.
+void link_estimator_reset(LinkEstimator* est, PayloadClass initial, PayloadClass ceiling);
+
+// One upload: `bytes` accepted by the socket in `us` microseconds. Callers
+// pass only bytes that actually had to cross the link (not those still
+// sitting in the send buffer); zero-byte or zero-time samples are ignored.
+void link_estimator_record(LinkEstimator* est, uint32_t bytes, uint32_t us, uint32_t nowMs);
+
+// Class to use for the next upload.
+PayloadClass link_estimator_class(LinkEstimator* est, uint32_t nowMs);
+
+// "full", "reduced", "thumbnail" — the value reported to the API
+const char* payload_class_name(PayloadClass cls);
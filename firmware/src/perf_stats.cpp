@@ -0,0 +1,54 @@
+#include "perf_stats.h"
+
+struct StageStats {
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t count;
+};
+
+static const char* const STAGE_NAMES[] = {
+    "capture", "motion_filter", "preprocess", "inference", "local_match", "jpeg_encode", "upload",
+    "tls_handshake", "http_request", "radar_to_capture", "radar_to_unlock",
+};
+static_assert(sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0]) == (size_t)PerfStage::Count,
+              "STAGE_NAMES must match PerfStage");
+
+static StageStats _stats[(size_t)PerfStage::Count];
+static portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+void perf_record(PerfStage stage, uint32_t us) {
+    portENTER_CRITICAL(&_mux);
+    StageStats& s = _stats[(size_t)stage];
+    s.lastUs = us;
+    if (us > s.maxUs) s.maxUs = us;
+    s.totalUs += us;
+    s.count++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+uint32_t perf_mean_us(PerfStage stage) {
+    portENTER_CRITICAL(&_mux);
+    const StageStats& s = _stats[(size_t)stage];
+    uint32_t mean = s.count ? (uint32_t)(s.totalUs / s.count) : 0;
+    portEXIT_CRITICAL(&_mux);
+    return mean;
+}
+
+void perf_log_summary() {
+    StageStats snapshot[(size_t)PerfStage::Count];
+    portENTER_CRITICAL(&_mux);
+    memcpy(snapshot, _stats, sizeof(snapshot));
+    portEXIT_CRITICAL(&_mux);
+
+    Serial.print("[PERF]");
+    for (size_t i = 0; i < (size_t)PerfStage::Count; i++) {
+        const StageStats& s = snapshot[i];
+        if (s.count == 0) continue;
+        Serial.printf(" %s=%lu/%lu/%lu", STAGE_NAMES[i],
+                      (unsigned long)s.lastUs,
+                      (unsigned long)(s.totalUs / s.count),
+                      (unsigned long)s.maxUs);
+    }
+    Serial.println(" (us last/avg/max)");
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// Per-stage latency counters for the detection pipeline. Each stage keeps
+// its last, mean and worst-case duration so modes (e.g. raw vs JPEG capture)
+// can be compared from the serial log.
+
+#include <Arduino.h>
+
+enum class PerfStage : uint8_t {
+    Capture,         // esp_camera_fb_get()
+    MotionFilter,    // frame-difference prefilter ahead of inference
+    Preprocess,      // JPEG decode or raw convert + resample into the input tensor
+    Inference,       // TFLite Invoke()
+    LocalMatch,      // frame dHash for the decision cache and local hash table
+    JpegEncode,      // software JPEG encode of a raw frame for upload
+    Upload,          // image upload end to end, including any reconnect
+    TlsHandshake,    // TCP connect + TLS handshake (full or resumed)
+    HttpRequest,     // request/response on an established connection
+    RadarToCapture,  // radar sample that triggered detection -> frame in hand
+    RadarToUnlock,   // radar sample that triggered detection -> door motor start
+    Count
+};
+
+void perf_record(PerfStage stage, uint32_t us);
+
+// Mean duration of a stage so far (0 with no samples).
+uint32_t perf_mean_us(PerfStage stage);
+
+// Print one summary line: last/avg/max per stage that has samples.
+void perf_log_summary();
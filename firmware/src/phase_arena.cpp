@@ -0,0 +1,110 @@
+#include "phase_arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The arena the running task has checked out; each FreeRTOS task (and
+// each host thread in tests) has its own
+static thread_local PhaseArena* _active = nullptr;
+
+static size_t align_up(size_t n) {
+    return (n + PHASE_ARENA_ALIGN - 1) & ~(size_t)(PHASE_ARENA_ALIGN - 1);
+}
+
+void phase_arena_init(PhaseArena* arena, void* block, size_t capacity) {
+    memset(arena, 0, sizeof(*arena));
+    // Start on an aligned address; the slack comes off the capacity
+    uintptr_t start = (uintptr_t)block;
+    uintptr_t aligned = align_up(start);
+    if (!block || capacity < aligned - start) return;
+    arena->base = (uint8_t*)aligned;
+    arena->capacity = capacity - (aligned - start);
+}
+
+void* phase_arena_reserve(PhaseArena* arena, size_t bytes) {
+    void* region = phase_arena_alloc(arena, bytes);
+    if (region) arena->reserved = arena->used;
+    return region;
+}
+
+void* phase_arena_alloc(PhaseArena* arena, size_t bytes) {
+    size_t need = align_up(bytes ? bytes : 1);
+    if (need > arena->capacity - arena->used) return nullptr;
+    void* p = arena->base + arena->used;
+    arena->used += need;
+    size_t scratch = arena->used - arena->reserved;
+    if (scratch > arena->stats.highWater) arena->stats.highWater = scratch;
+    return p;
+}
+
+ArenaMark phase_arena_begin(PhaseArena* arena, ArenaPhase phase) {
+    return {phase, arena->used};
+}
+
+void phase_arena_end(PhaseArena* arena, ArenaMark mark) {
+    size_t phaseBytes = arena->used - mark.used;
+    size_t& peak = arena->stats.phaseHighWater[(int)mark.phase];
+    if (phaseBytes > peak) peak = phaseBytes;
+    arena->used = mark.used;
+}
+
+void phase_arena_checkout(PhaseArena* arena) {
+    arena->used = arena->reserved;
+    _active = arena;
+}
+
+void phase_arena_checkin() {
+    if (!_active) return;
+    _active->used = _active->reserved;
+    _active->stats.events++;
+    _active = nullptr;
+}
+
+size_t phase_arena_available(const PhaseArena* arena) {
+    return arena->capacity - arena->used;
+}
+
+bool phase_arena_grew(PhaseArena* arena) {
+    if (arena->stats.highWater <= arena->reported.highWater &&
+        arena->stats.fallbacks <= arena->reported.fallbacks) {
+        return false;
+    }
+    arena->reported = arena->stats;
+    return true;
+}
+
+void phase_arena_format_stats(const PhaseArena* arena, char* out, size_t cap) {
+    const PhaseArenaStats& s = arena->stats;
+    snprintf(out, cap,
+             "high water %u of %u B (motion %u, hash %u, preprocess %u, encode %u), "
+             "%lu heap fallbacks in %lu events",
+             (unsigned)s.highWater, (unsigned)(arena->capacity - arena->reserved),
+             (unsigned)s.phaseHighWater[(int)ArenaPhase::Motion],
+             (unsigned)s.phaseHighWater[(int)ArenaPhase::Hash],
+             (unsigned)s.phaseHighWater[(int)ArenaPhase::Preprocess],
+             (unsigned)s.phaseHighWater[(int)ArenaPhase::Encode],
+             (unsigned long)s.fallbacks, (unsigned long)s.events);
+}
+
+void* scratch_alloc(size_t bytes) {
+    if (_active) {
+        void* p = phase_arena_alloc(_active, bytes);
+        if (p) return p;
+        _active->stats.fallbacks++;
+    }
+    return malloc(bytes);
+}
+
+void* scratch_calloc(size_t bytes) {
+    void* p = scratch_alloc(bytes);
+    if (p) memset(p, 0, bytes);
+    return p;
+}
+
+void scratch_free(void* ptr) {
+    if (_active && (uint8_t*)ptr >= _active->base && (uint8_t*)ptr < _active->base + _active->capacity) {
+        return;
+    }
+    free(ptr);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Per-event scratch memory for the detection pipeline, carved out of one
+// block (PSRAM on the device) instead of the general heap.
+//
+// The bottom of the block holds permanent regions reserved at boot (the
+// TFLite tensor arena). Above them, a task checks the arena out for one
+// event and the event's phases bump-allocate from it. Each phase gives its
+// memory back when it ends, so consecutive phases (motion grid, hash,
+// decode + resample into the tensor input, upload staging) reuse the same
+// bytes, and checking the arena back in resets it in one step. Nothing is
+// freed piecemeal, so the block can't fragment and an event's footprint is
+// bounded by the block size.
+//
+// The portable decoders (jpeg_decoder, image_preprocess) take their buffers
+// from scratch_alloc(), which draws from the arena the calling task has
+// checked out, or the heap when it has none or the arena is full (counted
+// as a fallback).
+//
+// Portable; builds under the `native` env. An arena belongs to one task at
+// a time.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PHASE_ARENA_ALIGN 16
+
+enum class ArenaPhase : uint8_t { Motion, Hash, Preprocess, Encode, Count };
+
+struct PhaseArenaStats {
+    uint32_t events;
+    uint32_t fallbacks;  // scratch_alloc() requests the arena couldn't take
+    size_t highWater;    // most scratch bytes in use at once
+    size_t phaseHighWater[(int)ArenaPhase::Count];
+};
+
+struct PhaseArena {
+    uint8_t* base;
+    size_t capacity;
+    size_t reserved;  // permanent regions at the bottom
+    size_t used;      // reserved + scratch in use
+    PhaseArenaStats stats;
+    PhaseArenaStats reported;  // as of the last phase_arena_grew()
+};
+
+// Phase bookkeeping returned by phase_arena_begin()
+struct ArenaMark {
+    ArenaPhase phase;
+    size_t used;
+};
+
+void phase_arena_init(PhaseArena* arena, void* block, size_t capacity);
+
+// Permanent region, for use at boot before any event. Returns nullptr if
+// the block is too small.
+void* phase_arena_reserve(PhaseArena* arena, size_t bytes);
+
+// Scratch for the current event, PHASE_ARENA_ALIGN-aligned. Returns nullptr
+// when full.
+void* phase_arena_alloc(PhaseArena* arena, size_t bytes);
+
+// Bracket one phase: everything allocated in between is released by
+// phase_arena_end(), which records the phase's high-water mark.
+ArenaMark phase_arena_begin(PhaseArena* arena, ArenaPhase phase);
+void phase_arena_end(PhaseArena* arena, ArenaMark mark);
+
+// Make `arena` the calling task's scratch source for one event, and hand it
+// back, releasing all of its scratch. Scratch memory must not outlive the
+// checkout.
+void phase_arena_checkout(PhaseArena* arena);
+void phase_arena_checkin();
+
+// Scratch bytes free for the rest of the event.
+size_t phase_arena_available(const PhaseArena* arena);
+
+// True when the high water or fallback count has risen since the last call,
+// so the [ARENA] log only shows growth. One-line summary of the stats for it.
+bool phase_arena_grew(PhaseArena* arena);
+void phase_arena_format_stats(const PhaseArena* arena, char* out, size_t cap);
+
+// Arena scratch when the task has one checked out, else malloc. Both are
+// zero-filled by scratch_calloc(). scratch_free() ignores arena memory.
+void* scratch_alloc(size_t bytes);
+void* scratch_calloc(size_t bytes);
+void scratch_free(void* ptr);
@@ -0,0 +1,634 @@
+#include "pipeline.h"
+#include "config.h"
+#include "sensors.h"
+#include "sensor_events.h"
+#include "detection.h"
+#include "door_control.h"
+#include "frame_handle.h"
+#include "motion_filter.h"
+#include "perf_stats.h"
+#include "uplink.h"
+#include "hash_sync.h"
+#include "decision_cache.h"
+#include "access_gate.h"
+#include "phase_arena.h"
+#include <esp_task_wdt.h>
+
+struct TriggerEvent {
+    uint32_t radarAtUs;  // radar edge time, or the range check that confirmed a held radar
+    float distanceCm;    // -1 while speculative: the range isn't known yet
+    float velocityCmS;   // negative while approaching
+    uint32_t attempt;    // access_gate.h attempt id
+    bool speculative;    // sent on the radar edge, before the range confirmed it
+};
+
+enum class DoorCommandType : uint8_t { Open, Close, Deny, StateChanged };
+
+struct DoorCommand {
+    DoorCommandType type;
+    bool autoClose;          // Open: close again after DOOR_AUTO_CLOSE_DELAY_MS
+    uint16_t denyLedMs;      // Deny: how long to show the red LED
+    uint32_t triggeredAtUs;  // Open: TriggerEvent::radarAtUs (0 for manual commands)
+    DoorState from;          // StateChanged: reported by the door controller
+    DoorState to;
+};
+
+static QueueHandle_t _triggerQueue = nullptr;
+static QueueHandle_t _doorQueue = nullptr;
+
+static bool send_door_command(const DoorCommand& cmd) {
+    if (xQueueSendToBack(_doorQueue, &cmd, 0) != pdTRUE) {
+        Serial.println("[PIPE] Door command queue full");
+        return false;
+    }
+    return true;
+}
+
+static void deny(uint16_t ledMs) {
+    DoorCommand cmd = {DoorCommandType::Deny, false, ledMs, 0};
+    send_door_command(cmd);
+}
+
+// ---- Access attempts ----
+// Every trigger is an access_gate.h attempt; the range, detector and access
+// verdicts settle it from whichever task has them.
+
+static AccessGate _gate;  // guarded by _gateLock
+static SemaphoreHandle_t _gateLock = nullptr;
+
+static uint32_t begin_attempt(uint32_t triggeredAtUs, uint8_t passed) {
+    xSemaphoreTake(_gateLock, portMAX_DELAY);
+    uint32_t id = access_gate_begin(&_gate, triggeredAtUs, passed);
+    xSemaphoreGive(_gateLock);
+    return id;
+}
+
+// Record one check's verdict. Opens the door when it completes the set; a
+// failure shows the deny LED for `denyLedMs`, but only once the range has
+// confirmed the animal (radar motion that never came close isn't told no).
+static GateResult settle_check(uint32_t attempt, AccessCheck check, bool passed,
+                               uint16_t denyLedMs = 0) {
+    xSemaphoreTake(_gateLock, portMAX_DELAY);
+    GateResult result = access_gate_verdict(&_gate, attempt, check, passed);
+    xSemaphoreGive(_gateLock);
+
+    if (result.outcome == GateOutcome::Open) {
+        DoorCommand cmd = {DoorCommandType::Open, true, 0, result.triggeredAtUs};
+        send_door_command(cmd);
+    } else if (result.outcome == GateOutcome::Cancel && denyLedMs &&
+               (result.passed & ACCESS_CHECK_BIT(AccessCheck::Range))) {
+        deny(denyLedMs);
+    }
+    return result;
+}
+
+static CheckState attempt_check(uint32_t attempt, AccessCheck check) {
+    xSemaphoreTake(_gateLock, portMAX_DELAY);
+    CheckState state = access_gate_check(&_gate, attempt, check);
+    xSemaphoreGive(_gateLock);
+    return state;
+}
+
+static bool attempt_opened(uint32_t attempt) {
+    xSemaphoreTake(_gateLock, portMAX_DELAY);
+    bool opened = access_gate_opened(&_gate, attempt);
+    xSemaphoreGive(_gateLock);
+    return opened;
+}
+
+// ---- Sensing (core 1) ----
+// Sleeps until the radar's edge interrupt reports motion, then confirms with
+// the filtered ultrasonic range (sampled in the background, so this never
+// waits on an echo). While the radar holds, the range is re-checked as each
+// new ping lands. Only touches sensors, the trigger queue and the access
+// gate, so nothing downstream can stall it.
+//
+// With SPECULATIVE_ACCESS_ENABLED the trigger goes out on the radar edge and
+// the range settles the attempt afterwards, within
+// SPECULATIVE_RANGE_WINDOW_MS. One speculative attempt per cooldown: if the
+// range doesn't confirm it, the next trigger waits for the range as usual.
+
+static void sensing_task(void*) {
+    esp_task_wdt_add(NULL);
+    QueueHandle_t events = sensor_events_subscribe(SENSOR_INPUT_BIT(SensorInput::Radar),
+                                                   SENSING_EVENT_QUEUE_DEPTH);
+    bool motion = sensor_events_state(SensorInput::Radar);
+    unsigned long lastTrigger = 0;
+#if SPECULATIVE_ACCESS_ENABLED
+    unsigned long lastSpeculation = 0;
+    uint32_t pending = 0;  // speculative attempt waiting on the range
+    unsigned long pendingSince = 0;
+#endif
+
+    for (;;) {
+        esp_task_wdt_reset();
+        bool ranging = motion;
+#if SPECULATIVE_ACCESS_ENABLED
+        ranging = ranging || pending;
+#endif
+        SensorEvent event;
+        uint32_t radarAtUs;
+        if (!events) {
+            // No subscription slot: fall back to polling
+            vTaskDelay(pdMS_TO_TICKS(ULTRASONIC_PING_INTERVAL_MS));
+            motion = radar_detected();
+            radarAtUs = micros();
+        } else if (xQueueReceive(events, &event,
+                                 pdMS_TO_TICKS(ranging ? ULTRASONIC_PING_INTERVAL_MS : 1000)) == pdTRUE) {
+            motion = event.active;
+            radarAtUs = event.atUs;
+        } else {
+            radarAtUs = micros();
+        }
+
+#if SPECULATIVE_ACCESS_ENABLED
+        if (pending) {
+            UltrasonicReading range = ultrasonic_read();
+            bool inRange = range.valid && range.distanceCm <= ULTRASONIC_TRIGGER_DISTANCE_CM;
+            if (inRange) {
+                Serial.printf("Animal in range at %.1f cm (%.0f cm/s)\n", range.distanceCm,
+                              range.velocityCmS);
+                lastTrigger = millis();
+            } else if (millis() - pendingSince < SPECULATIVE_RANGE_WINDOW_MS) {
+                continue;
+            }
+            settle_check(pending, AccessCheck::Range, inRange);
+            pending = 0;
+            continue;
+        }
+#endif
+        if (!motion) continue;
+
+        // The door is already open for an animal; don't stack up detections
+        if (door_is_open()) continue;
+        if (millis() - lastTrigger < DETECTION_COOLDOWN_MS) continue;
+
+#if SPECULATIVE_ACCESS_ENABLED
+        if (millis() - lastSpeculation >= DETECTION_COOLDOWN_MS) {
+            lastSpeculation = millis();
+            uint32_t attempt = begin_attempt(radarAtUs, 0);
+            TriggerEvent trig = {radarAtUs, -1, 0, attempt, true};
+            if (xQueueSendToBack(_triggerQueue, &trig, 0) == pdTRUE) {
+                pending = attempt;
+                pendingSince = millis();
+            } else {
+                settle_check(attempt, AccessCheck::Range, false);
+            }
+            continue;
+        }
+#endif
+
+        UltrasonicReading range = ultrasonic_read();
+        if (!range.valid || range.distanceCm > ULTRASONIC_TRIGGER_DISTANCE_CM) continue;
+
+        uint32_t attempt = begin_attempt(radarAtUs, ACCESS_CHECK_BIT(AccessCheck::Range));
+        TriggerEvent trig = {radarAtUs, range.distanceCm, range.velocityCmS, attempt, false};
+        if (xQueueSendToBack(_triggerQueue, &trig, 0) == pdTRUE) {
+            lastTrigger = millis();
+        } else {
+            settle_check(attempt, AccessCheck::Dog, false);
+        }
+    }
+}
+
+#if MOTION_FILTER_ENABLED
+static MotionFilter _motion;
+static uint64_t _motionSavedUs = 0;
+
+// False when the frame shows nothing the last triggers didn't. Frames the
+// filter can't read always pass (with totalBlocks 0 in `result`).
+static bool scene_changed(Frame* frame, MotionResult* result) {
+    camera_fb_t* fb = frame_fb(frame);
+    uint32_t start = micros();
+    uint8_t grid[MOTION_GRID_CELLS];
+    bool ok;
+    ArenaMark mark = phase_arena_begin(detection_arena(), ArenaPhase::Motion);
+    switch (fb->format) {
+        case PIXFORMAT_RGB565:
+            ok = motion_grid_from_raw(fb->buf, fb->width, fb->height, RawPixelFormat::Rgb565, grid);
+            break;
+        case PIXFORMAT_GRAYSCALE:
+            ok = motion_grid_from_raw(fb->buf, fb->width, fb->height, RawPixelFormat::Gray8, grid);
+            break;
+        case PIXFORMAT_JPEG:
+            ok = motion_grid_from_jpeg(fb->buf, fb->len, grid);
+            break;
+        default:
+            ok = false;
+            break;
+    }
+    phase_arena_end(detection_arena(), mark);
+    *result = {true, 0, 0};
+    if (!ok) return true;
+
+    *result = motion_filter_update(&_motion, grid);
+    perf_record(PerfStage::MotionFilter, micros() - start);
+    if (result->moved) return true;
+
+    // What this frame would have cost on the detector
+    _motionSavedUs += perf_mean_us(PerfStage::Preprocess) + perf_mean_us(PerfStage::Inference);
+    Serial.printf("[MOTION] Scene unchanged (%d/%d blocks), skipped: %lu of %lu frames rejected, "
+                  "~%lu ms inference saved\n",
+                  result->changedBlocks, result->totalBlocks,
+                  (unsigned long)_motion.stats.rejected, (unsigned long)_motion.stats.frames,
+                  (unsigned long)(_motionSavedUs / 1000));
+    return false;
+}
+#endif
+
+#if DECISION_CACHE_ENABLED
+static DecisionCache _decisions;  // guarded by _decisionLock
+static SemaphoreHandle_t _decisionLock = nullptr;
+static uint64_t _decisionSavedUs = 0;
+
+// How the API logs a grant on this board's side
+static const char* granted_event_type() {
+    return strcmp(THIS_SIDE, SIDE_OUTSIDE) == 0 ? "EntryGranted" : "ExitGranted";
+}
+
+// A dog the API let in on this side within the TTL passes the access check
+// without a request. The whole-frame hash is mostly background, so it can't
+// tell one animal from another: the detector still has to see a dog. The hit
+// is copied into `entry`.
+static bool find_cached_grant(uint64_t hash, DecisionCacheEntry* entry) {
+    xSemaphoreTake(_decisionLock, portMAX_DELAY);
+    bool hit = decision_cache_lookup(&_decisions, THIS_SIDE, hash, millis(), entry);
+    DecisionCacheStats stats = _decisions.stats;
+    uint32_t hitPercent = decision_cache_hit_percent(&_decisions);
+    xSemaphoreGive(_decisionLock);
+    if (!hit) return false;
+
+    // What the hit skips: the access request
+    _decisionSavedUs += perf_mean_us(PerfStage::Upload);
+    Serial.printf("[CACHE] Hit for %s (granted %lu s ago): %lu of %lu lookups hit (%lu%%), "
+                  "~%lu ms saved\n",
+                  entry->name, (unsigned long)((millis() - entry->grantedAtMs) / 1000),
+                  (unsigned long)stats.hits, (unsigned long)stats.lookups,
+                  (unsigned long)hitPercent, (unsigned long)(_decisionSavedUs / 1000));
+    return true;
+}
+
+// The server hears about a door opened from the cache through a firmware
+// event instead of an access request
+static void confirm_cached_grant(const DecisionCacheEntry& entry) {
+    char notes[64];
+    snprintf(notes, sizeof(notes), "Cached grant for %s (#%ld)", entry.name, (long)entry.animalId);
+    uplink_post_event(granted_event_type(), notes, -1);
+}
+
+// Runs on the uplink task: keep the API's latest verdict on this animal
+static void record_decision(const AccessResponse& response, const AccessContext& context) {
+    if (response.animalId <= 0) return;
+    xSemaphoreTake(_decisionLock, portMAX_DELAY);
+    if (!response.allowed) {
+        decision_cache_forget(&_decisions, response.animalId);
+    } else if (context.hashed) {
+        decision_cache_store(&_decisions, THIS_SIDE, context.frameHash, response.animalId,
+                             response.animalName, millis());
+    }
+    xSemaphoreGive(_decisionLock);
+}
+#endif
+
+#if LOCAL_GRANT_ENABLED
+// True for an allowed dog in the synced hash table, within
+// LOCAL_GRANT_MAX_DISTANCE, which then passes the access check without
+// waiting for the API.
+static bool local_grant(uint64_t hash) {
+    HashTableEntry entry;
+    LocalMatch match = hash_sync_lookup(hash, &entry);
+    if (match.decision != LocalDecision::Grant) {
+        Serial.printf("[HASH] No local grant: %s (distance %d)\n",
+                      local_decision_name(match.decision), match.distance);
+        return false;
+    }
+    if (match.distance > LOCAL_GRANT_MAX_DISTANCE) {
+        Serial.printf("[HASH] No local grant: %s too far (distance %d), waiting for the API\n",
+                      entry.name, match.distance);
+        return false;
+    }
+    Serial.printf("[HASH] Local grant for %s (distance %d)\n", entry.name, match.distance);
+    return true;
+}
+
+// Runs on the uplink task when the API denies a dog the local table let
+// in: fail the attempt, close the door if it opened, and stop granting
+// that entry locally
+static void overrule_local_grant(const AccessResponse& response, const AccessContext& context) {
+    xSemaphoreTake(_gateLock, portMAX_DELAY);
+    GateResult result = access_gate_overrule(&_gate, context.attempt, AccessCheck::Access);
+    xSemaphoreGive(_gateLock);
+
+    Serial.printf("[HASH] Server overruled local grant: %s\n", response.reason);
+    if (result.outcome == GateOutcome::AlreadyOpen) {
+        DoorCommand cmd = {DoorCommandType::Close, false, 0, 0};
+        send_door_command(cmd);
+    } else if (result.outcome == GateOutcome::Cancel) {
+        deny(3000);
+    }
+    HashTableEntry evicted;
+    if (context.hashed && hash_sync_evict(context.frameHash, &evicted)) {
+        Serial.printf("[HASH] Dropped %s from local grants\n", evicted.name);
+    }
+    hash_sync_request();
+}
+#endif
+
+// ---- Vision (core 1) ----
+// Capture, hand the approach photo to the uplink, run the dog detector and
+// hand dog frames on for identification. With COMBINED_ACCESS_UPLOAD one
+// request carries both, and for a frame that isn't a dog it only logs the
+// approach. The task never waits for a network reply: a dog the API let in
+// moments ago is let in again without a request, and one matched in the
+// local hash table is let in before the request is sent. A speculative
+// trigger sends the access request straight after capture, so the round
+// trip overlaps the detector and the range check.
+
+// The detector's verdict, then the access request (already on its way when
+// speculative). A decision-cache hit settles the access check in its place.
+static void identify(Frame* frame, const TriggerEvent& trig, AccessContext access, bool cachedGrant) {
+    bool submitted = trig.speculative && !cachedGrant && uplink_submit_access(frame, THIS_SIDE, access);
+
+    ArenaMark mark = phase_arena_begin(detection_arena(), ArenaPhase::Preprocess);
+    float dog_score = detection_run(frame_fb(frame));
+    phase_arena_end(detection_arena(), mark);
+    access.detection.dogScore = dog_score;
+    access.detection.dog = dog_score < 0 || dog_score >= DETECTION_CONFIDENCE_THRESHOLD;
+    if (!access.detection.dog) {
+        Serial.printf("Not a dog (score: %.3f)\n", dog_score);
+        perf_log_summary();
+        settle_check(trig.attempt, AccessCheck::Dog, false, 1000);
+        // Still the approach photo
+        if (access.combined) uplink_submit_access(frame, THIS_SIDE, access);
+        return;
+    }
+    settle_check(trig.attempt, AccessCheck::Dog, true);
+
+    if (cachedGrant) {
+        settle_check(trig.attempt, AccessCheck::Access, true);
+        if (access.combined) uplink_submit_approach(frame, THIS_SIDE);
+        return;
+    }
+#if LOCAL_GRANT_ENABLED
+    if (access.hashed && local_grant(access.frameHash)) {
+        settle_check(trig.attempt, AccessCheck::Access, true);
+    }
+#endif
+    if (!submitted && !uplink_submit_access(frame, THIS_SIDE, access)) {
+        settle_check(trig.attempt, AccessCheck::Access, false, 2000);
+    }
+}
+
+// The sensing task settles a speculative attempt's range within
+// SPECULATIVE_RANGE_WINDOW_MS of the radar edge
+static CheckState wait_for_range(const TriggerEvent& trig) {
+    const uint32_t limitUs = (SPECULATIVE_RANGE_WINDOW_MS + 2 * ULTRASONIC_PING_INTERVAL_MS) * 1000UL;
+    for (;;) {
+        CheckState state = attempt_check(trig.attempt, AccessCheck::Range);
+        if (state != CheckState::Pending || micros() - trig.radarAtUs > limitUs) return state;
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+// One trigger, start to finish. Runs with the detection arena checked out.
+static void process_trigger(const TriggerEvent& trig) {
+    if (trig.speculative) {
+        Serial.println("Radar motion: starting speculative access");
+    } else {
+        Serial.printf("Animal detected at %.1f cm (%.0f cm/s)\n", trig.distanceCm, trig.velocityCmS);
+        led_processing();
+    }
+
+    Frame* frame = frame_capture();
+    if (!frame) {
+        Serial.println("Camera capture failed");
+        settle_check(trig.attempt, AccessCheck::Dog, false, 1000);
+        return;
+    }
+    uint32_t latencyUs = micros() - trig.radarAtUs;
+    perf_record(PerfStage::RadarToCapture, latencyUs);
+    Serial.printf("[PIPE] radar->capture %lu us\n", (unsigned long)latencyUs);
+
+    AccessContext access = {};
+    access.attempt = trig.attempt;
+    access.combined = COMBINED_ACCESS_UPLOAD && !trig.speculative;
+    access.detection.logApproach = access.combined;
+    access.detection.dogScore = -1;
+#if MOTION_FILTER_ENABLED
+    MotionResult motion;
+    if (!scene_changed(frame, &motion)) {
+        settle_check(trig.attempt, AccessCheck::Dog, false);
+        frame_release(frame);
+        if (!trig.speculative) led_off();
+        return;
+    }
+    access.detection.motionChangedBlocks = motion.changedBlocks;
+    access.detection.motionTotalBlocks = motion.totalBlocks;
+#endif
+
+    // Every detection is logged in the admin portal, whatever TFLite
+    // says: with the access request when combined, a speculative one
+    // once the range has confirmed it (below)
+    if (!trig.speculative && !access.combined) uplink_submit_approach(frame, THIS_SIDE);
+
+#if DECISION_CACHE_ENABLED || LOCAL_GRANT_ENABLED
+    uint32_t hashStart = micros();
+    ArenaMark mark = phase_arena_begin(detection_arena(), ArenaPhase::Hash);
+    access.hashed = frame_dhash(frame, &access.frameHash);
+    phase_arena_end(detection_arena(), mark);
+    perf_record(PerfStage::LocalMatch, micros() - hashStart);
+#endif
+    bool cachedGrant = false;
+#if DECISION_CACHE_ENABLED
+    DecisionCacheEntry cached;
+    cachedGrant = access.hashed && find_cached_grant(access.frameHash, &cached);
+#endif
+    identify(frame, trig, access, cachedGrant);
+
+    if (trig.speculative && wait_for_range(trig) == CheckState::Passed) {
+        uplink_submit_approach(frame, THIS_SIDE);
+    }
+#if DECISION_CACHE_ENABLED
+    if (cachedGrant && attempt_opened(trig.attempt)) confirm_cached_grant(cached);
+#endif
+    frame_release(frame);
+}
+
+static void vision_task(void*) {
+    esp_task_wdt_add(NULL);
+    TriggerEvent trig;
+    for (;;) {
+        esp_task_wdt_reset();
+        if (xQueueReceive(_triggerQueue, &trig, pdMS_TO_TICKS(1000)) != pdTRUE) continue;
+
+        phase_arena_checkout(detection_arena());
+        process_trigger(trig);
+        phase_arena_checkin();
+        if (phase_arena_grew(detection_arena())) {
+            char line[160];
+            phase_arena_format_stats(detection_arena(), line, sizeof(line));
+            Serial.printf("[ARENA] vision: %s\n", line);
+        }
+    }
+}
+
+// Runs on the uplink task once the server has answered.
+static void on_access_result(const AccessResponse& response, const AccessContext& context) {
+#if DECISION_CACHE_ENABLED
+    if (response.success) record_decision(response, context);
+#endif
+    bool allowed = response.success && response.allowed;
+    if (response.skipped) {
+        Serial.printf("Access request skipped: %s\n", response.reason);
+    } else if (!response.success) {
+        Serial.printf("API request failed: %s\n", response.reason);
+    } else if (allowed) {
+        Serial.printf("Access GRANTED for %s (confidence: %.2f, direction: %s)\n",
+                      response.animalName, response.confidenceScore, response.direction);
+    } else {
+        Serial.printf("Access DENIED: %s (direction: %s)\n",
+                      response.reason, response.direction);
+    }
+
+    // A skipped request follows a Dog check that already failed the attempt,
+    // so it is neither an API failure nor a second deny
+    uint16_t denyLedMs = response.skipped ? 0 : response.success ? 3000 : 2000;
+    GateResult result = settle_check(context.attempt, AccessCheck::Access, allowed, denyLedMs);
+    if (result.outcome == GateOutcome::Cancel) perf_log_summary();
+
+#if LOCAL_GRANT_ENABLED
+    // The local hash table passed this dog before the server answered
+    if (result.repeated && (result.passed & ACCESS_CHECK_BIT(AccessCheck::Access)) &&
+        response.success && !response.allowed) {
+        overrule_local_grant(response, context);
+    }
+#endif
+}
+
+// ---- Actuation (core 1, highest priority) ----
+// Sole owner of door commands and LEDs. Door travel runs on the door
+// controller's timer and ISRs (door_control.h); this task only starts it
+// and hears back through StateChanged. Timers (auto-close, deny LED) are
+// checked on every wake-up instead of with delay(), so a pending command is
+// never held up by an LED blink or a moving door.
+
+// Runs on the door controller's timer
+static void on_door_state(DoorState from, DoorState to) {
+    DoorCommand cmd = {DoorCommandType::StateChanged, false, 0, 0, from, to};
+    send_door_command(cmd);
+}
+
+static void actuation_task(void*) {
+    esp_task_wdt_add(NULL);
+    bool waitingForClose = false;
+    unsigned long doorOpenedAt = 0;
+    unsigned long ledOffAt = 0;
+    bool ledTimer = false;
+    DoorCommand cmd;
+
+    for (;;) {
+        esp_task_wdt_reset();
+        if (xQueueReceive(_doorQueue, &cmd, pdMS_TO_TICKS(DOOR_SAFETY_CHECK_INTERVAL_MS)) == pdTRUE) {
+            switch (cmd.type) {
+                case DoorCommandType::Open:
+                    if (cmd.triggeredAtUs && !door_is_open()) {
+                        perf_record(PerfStage::RadarToUnlock, micros() - cmd.triggeredAtUs);
+                    }
+                    if (door_open()) {
+                        waitingForClose = cmd.autoClose;
+                        doorOpenedAt = millis();
+                        ledTimer = false;
+                        if (cmd.triggeredAtUs) perf_log_summary();
+                    } else {
+                        uplink_post_event("DoorObstructed", "open", -1);
+                    }
+                    break;
+                case DoorCommandType::Close:
+                    door_close();
+                    waitingForClose = false;
+                    break;
+                case DoorCommandType::Deny:
+                    if (door_is_open()) break;  // keep the green LED while open
+                    led_deny();
+                    ledOffAt = millis() + cmd.denyLedMs;
+                    ledTimer = true;
+                    break;
+                case DoorCommandType::StateChanged:
+                    Serial.printf("[DOOR] %s -> %s\n", door_state_name(cmd.from),
+                                  door_state_name(cmd.to));
+                    switch (cmd.to) {
+                        case DoorState::Open:
+                            uplink_post_event("DoorOpened", nullptr, -1);
+                            break;
+                        case DoorState::Closed:
+                            led_off();
+                            uplink_post_event("DoorClosed", nullptr, -1);
+                            break;
+                        case DoorState::Opening:
+                            if (cmd.from != DoorState::Closing) break;
+                            // Beam broken while closing; try again once it's clear
+                            Serial.println("IR beam broken during close - reversed");
+                            uplink_post_event("DoorObstructed", "close", -1);
+                            waitingForClose = true;
+                            doorOpenedAt = millis();
+                            break;
+                        case DoorState::Fault:
+                            uplink_post_event("DoorObstructed", "fault", -1);
+                            waitingForClose = false;
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+            }
+        }
+
+        if (ledTimer && (long)(millis() - ledOffAt) >= 0) {
+            ledTimer = false;
+            led_off();
+        }
+
+        if (waitingForClose && door_state() == DoorState::Open &&
+            millis() - doorOpenedAt > DOOR_AUTO_CLOSE_DELAY_MS) {
+            if (door_close()) {
+                waitingForClose = false;
+                Serial.println("Door auto-closing");
+            } else {
+                doorOpenedAt = millis();
+            }
+        }
+    }
+}
+
+void pipeline_start() {
+#if MOTION_FILTER_ENABLED
+    MotionFilterConfig motion = {MOTION_CELL_THRESHOLD, MOTION_BLOCK_PERCENT, MOTION_MIN_CHANGED_BLOCKS,
+                                 MOTION_LEARN_SHIFT, MOTION_MAX_CONSECUTIVE_REJECTS};
+    motion_filter_init(&_motion, motion);
+#endif
+#if DECISION_CACHE_ENABLED
+    decision_cache_init(&_decisions, DECISION_CACHE_TTL_MS, DECISION_CACHE_MAX_DISTANCE);
+    _decisionLock = xSemaphoreCreateMutex();
+#endif
+    access_gate_init(&_gate);
+    _gateLock = xSemaphoreCreateMutex();
+    _triggerQueue = xQueueCreate(PIPELINE_TRIGGER_QUEUE_DEPTH, sizeof(TriggerEvent));
+    _doorQueue = xQueueCreate(PIPELINE_DOOR_QUEUE_DEPTH, sizeof(DoorCommand));
+
+    uplink_init(on_access_result);
+    door_set_listener(on_door_state);
+
+    xTaskCreatePinnedToCore(actuation_task, "actuation", ACTUATION_TASK_STACK, nullptr,
+                            ACTUATION_TASK_PRIORITY, nullptr, 1);
+    xTaskCreatePinnedToCore(sensing_task, "sensing", SENSING_TASK_STACK, nullptr,
+                            SENSING_TASK_PRIORITY, nullptr, 1);
+    xTaskCreatePinnedToCore(vision_task, "vision", VISION_TASK_STACK, nullptr,
+                            VISION_TASK_PRIORITY, nullptr, 1);
+    Serial.println("[OK] Pipeline tasks started on core 1");
+}
+
+bool pipeline_request_door(bool open) {
+    if (!_doorQueue) return false;
+    DoorCommand cmd = {open ? DoorCommandType::Open : DoorCommandType::Close, false, 0, 0};
+    return send_door_command(cmd);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Detection pipeline split into pinned FreeRTOS tasks connected by bounded
+// queues:
+//
+//   sensing (core 1)  --trigger-->  vision (core 1)  --access job-->  uplink (core 0)
+//                                                                          |
+//   actuation (core 1)  <------------- door command -----------------------+
+//
+// Sensing sleeps on radar edge events (sensor_events.h) rather than polling.
+// Sensing and actuation only ever block on their own queues or on sensor
+// I/O, never on the network; every HTTP call, reconnect and queue flush runs
+// on the uplink task. Radar-to-capture and radar-to-unlock latencies are
+// recorded as perf stages (worst case shown as the max in perf_log_summary).
+// Vision drops frames in which nothing moved since the last trigger (see
+// motion_filter.h) before any upload or inference. With
+// DECISION_CACHE_ENABLED a dog the API granted within DECISION_CACHE_TTL_MS
+// still goes through the detector but is let back in without an access
+// request (see decision_cache.h).
+//
+// The door opens once an attempt has passed the range, the dog detector and
+// an access decision (access_gate.h). With SPECULATIVE_ACCESS_ENABLED the
+// trigger goes out on the radar edge, so the access request is on the wire
+// while the range and the detector are still running.
+
+#include <Arduino.h>
+
+// Create the queues and start the uplink, actuation, sensing and vision
+// tasks. Call once all subsystems (sensors, camera, detection, network) are up.
+void pipeline_start();
+
+// Ask the actuation task to open or close the door (e.g. a BLE command).
+// Never blocks; returns false if the command queue is full.
+bool pipeline_request_door(bool open);
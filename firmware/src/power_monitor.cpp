@@ -1,10 +1,7 @@
 #include "power_monitor.h"
 #include "config.h"
-#include "offline_queue.h"
+#include "api_client.h"
 #include <Arduino.h>
-#include <HTTPClient.h>
-#include <WiFiClientSecure.h>
-#include <ArduinoJson.h>
 
 #if !POWER_MONITOR_ENABLED
 
@@ -13,7 +10,7 @@ void power_monitor_init() {
 }
 float power_monitor_read_voltage() { return 0.0f; }
 int power_monitor_battery_percent() { return -1; }
-void power_monitor_update(const char*, const char*) {}
+void power_monitor_update(const char*) {}
 
 #else // POWER_MONITOR_ENABLED
 
@@ -22,8 +19,6 @@ static bool _lastBatteryLow = false;
 static bool _lastBatteryCharged = false;
 static bool _initialized = false;
 
-static void post_firmware_event(const char* apiKey, const char* baseUrl, const char* eventType, const char* notes, float voltage);
-
 void power_monitor_init() {
     pinMode(PIN_POWER_ADC, INPUT);
     pinMode(PIN_POWER_DETECT, INPUT);
@@ -45,7 +40,7 @@ int power_monitor_battery_percent() {
     return (int)(((v - BATTERY_EMPTY_VOLTS) / (BATTERY_FULL_VOLTS - BATTERY_EMPTY_VOLTS)) * 100.0f);
 }
 
-void power_monitor_update(const char* apiKey, const char* baseUrl) {
+void power_monitor_update(const char* apiKey) {
     if (!_initialized) return;
 
     bool mainPower = digitalRead(PIN_POWER_DETECT) == HIGH;
@@ -57,7 +52,7 @@ void power_monitor_update(const char* apiKey, const char* baseUrl) {
         _lastMainPower = mainPower;
         const char* eventType = mainPower ? "PowerRestored" : "PowerLost";
         Serial.printf("[POWER] %s\n", eventType);
-        post_firmware_event(apiKey, baseUrl, eventType, nullptr, voltage);
+        api_post_firmware_event(apiKey, eventType, nullptr, voltage);
     }
 
     // Battery low transition
@@ -65,7 +60,7 @@ void power_monitor_update(const char* apiKey, const char* baseUrl) {
     if (battLow && !_lastBatteryLow) {
         _lastBatteryLow = true;
         Serial.printf("[POWER] BatteryLow (%d%%)\n", pct);
-        post_firmware_event(apiKey, baseUrl, "BatteryLow", nullptr, voltage);
+        api_post_firmware_event(apiKey, "BatteryLow", nullptr, voltage);
     } else if (!battLow) {
         _lastBatteryLow = false;
     }
@@ -75,59 +70,10 @@ void power_monitor_update(const char* apiKey, const char* baseUrl) {
     if (battCharged && !_lastBatteryCharged) {
         _lastBatteryCharged = true;
         Serial.printf("[POWER] BatteryCharged (%d%%)\n", pct);
-        post_firmware_event(apiKey, baseUrl, "BatteryCharged", nullptr, voltage);
+        api_post_firmware_event(apiKey, "BatteryCharged", nullptr, voltage);
     } else if (!battCharged) {
         _lastBatteryCharged = false;
     }
 }
 
-static WiFiClientSecure& getPowerSecureClient() {
-    static WiFiClientSecure client;
-    static bool initialized = false;
-    if (!initialized) {
-#if API_INSECURE_TLS
-        client.setInsecure();
-#else
-        if (strlen(API_CA_CERT) > 0) {
-            client.setCACert(API_CA_CERT);
-        } else {
-            client.setInsecure();
-        }
-#endif
-        initialized = true;
-    }
-    return client;
-}
-
-static void post_firmware_event(const char* apiKey, const char* baseUrl, const char* eventType, const char* notes, float voltage) {
-    JsonDocument doc;
-    doc["apiKey"] = apiKey;
-    doc["eventType"] = eventType;
-    doc["notes"] = notes ? notes : "";
-    doc["batteryVoltage"] = voltage;
-
-    String body;
-    serializeJson(doc, body);
-
-    String url = String(baseUrl) + String(API_FIRMWARE_EVENT_ENDPOINT);
-    HTTPClient http;
-    http.begin(getPowerSecureClient(), url);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(API_TIMEOUT_MS);
-
-    int code = http.POST(body);
-    http.end();
-
-    if (code != 204 && code != 200) {
-        // Queue for later if network unavailable
-        QueuedEvent evt;
-        evt.eventType = eventType;
-        evt.notes = notes ? notes : "";
-        evt.batteryVoltage = voltage;
-        evt.apiKey = apiKey;
-        evt.timestamp = millis();
-        offline_queue_push(evt);
-    }
-}
-
 #endif // POWER_MONITOR_ENABLED
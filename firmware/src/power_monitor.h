@@ -1,6 +1,7 @@
 #pragma once
 
 void power_monitor_init();
-void power_monitor_update(const char* apiKey, const char* baseUrl);
+// Posts power events (queued offline on failure) on state transitions.
+void power_monitor_update(const char* apiKey);
 float power_monitor_read_voltage();
 int power_monitor_battery_percent();
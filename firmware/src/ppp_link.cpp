@@ -0,0 +1,97 @@
+#include "ppp_link.h"
+#include <lwip/dns.h>
+#include <lwip/netif.h>
+#include <netif/ppp/pppapi.h>
+#include <netif/ppp/pppos.h>
+
+#define PPP_UP_BIT BIT0
+#define PPP_DOWN_BIT BIT1
+
+static ppp_pcb* _ppp = nullptr;
+static struct netif _netif;
+static PppOutput _output = nullptr;
+static EventGroupHandle_t _events = nullptr;
+static volatile bool _open = false;
+static volatile bool _up = false;
+
+// lwIP's tcpip thread
+static u32_t output_cb(ppp_pcb*, u8_t* data, u32_t len, void*) {
+    return _output ? (u32_t)_output(data, len) : 0;
+}
+
+// lwIP's tcpip thread
+static void status_cb(ppp_pcb* pcb, int err, void*) {
+    if (err == PPPERR_NONE) {
+        const ip4_addr_t* ip = netif_ip4_addr(ppp_netif(pcb));
+        Serial.printf("[PPP] Up, IP %s\n", ip4addr_ntoa(ip));
+        _up = true;
+        xEventGroupClearBits(_events, PPP_DOWN_BIT);
+        xEventGroupSetBits(_events, PPP_UP_BIT);
+        return;
+    }
+    // Any error ends the session; the pcb is kept for the next connect
+    if (err == PPPERR_USER) {
+        Serial.println("[PPP] Closed");
+    } else {
+        Serial.printf("[PPP] Link down (error %d)\n", err);
+    }
+    _up = false;
+    _open = false;
+    xEventGroupClearBits(_events, PPP_UP_BIT);
+    xEventGroupSetBits(_events, PPP_DOWN_BIT);
+}
+
+bool ppp_link_open(PppOutput output) {
+    if (_open) return true;
+    _output = output;
+    if (!_events) _events = xEventGroupCreate();
+    if (!_ppp) {
+        _ppp = pppapi_pppos_create(&_netif, output_cb, status_cb, nullptr);
+        if (!_ppp) {
+            Serial.println("[PPP] Could not create the PPP interface");
+            return false;
+        }
+        // Carriers and a bare pppd peer both accept empty credentials
+        ppp_set_auth(_ppp, PPPAUTHTYPE_ANY, "", "");
+        ppp_set_usepeerdns(_ppp, 1);
+    }
+    xEventGroupClearBits(_events, PPP_UP_BIT | PPP_DOWN_BIT);
+    _open = true;
+    if (pppapi_connect(_ppp, 0) != ERR_OK) {
+        _open = false;
+        return false;
+    }
+    return true;
+}
+
+void ppp_link_input(const uint8_t* data, size_t len) {
+    if (_open) pppos_input_tcpip(_ppp, (u8_t*)data, (int)len);
+}
+
+bool ppp_link_wait_up(uint32_t timeoutMs) {
+    if (!_open) return false;
+    EventBits_t bits = xEventGroupWaitBits(_events, PPP_UP_BIT | PPP_DOWN_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(timeoutMs));
+    return bits & PPP_UP_BIT;
+}
+
+void ppp_link_close(uint32_t timeoutMs) {
+    if (!_open) return;
+    pppapi_close(_ppp, 0);
+    EventBits_t bits = xEventGroupWaitBits(_events, PPP_DOWN_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(timeoutMs));
+    // Peer never answered the terminate request; drop it without one
+    if (!(bits & PPP_DOWN_BIT)) pppapi_close(_ppp, 1);
+}
+
+bool ppp_link_is_open() {
+    return _open;
+}
+
+bool ppp_link_is_up() {
+    return _up;
+}
+
+void ppp_link_set_default() {
+    if (_ppp && _up) pppapi_set_default(_ppp);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// PPP over serial through lwIP. Once the modem is in data mode, the link
+// gets an IP interface of its own, so sockets (and with them the TLS pool,
+// keep-alive and multipart uploads in api_connection) work over cellular
+// exactly as over WiFi. This module only runs the PPP state machine: the
+// caller owns the UART, hands received bytes to ppp_link_input() and writes
+// whatever the output callback is given.
+
+#include <Arduino.h>
+
+// Writes PPP frames to the serial line; returns bytes written.
+typedef size_t (*PppOutput)(const uint8_t* data, size_t len);
+
+// Start negotiating (LCP/IPCP) over a line already in data mode. Non-blocking.
+bool ppp_link_open(PppOutput output);
+
+// Bytes received from the serial line while the link is open.
+void ppp_link_input(const uint8_t* data, size_t len);
+
+// Wait until the link has an IP address or has failed.
+bool ppp_link_wait_up(uint32_t timeoutMs);
+
+// Terminate the link (the peer drops back to command mode) and wait for it.
+void ppp_link_close(uint32_t timeoutMs);
+
+bool ppp_link_is_open();  // negotiating or up
+bool ppp_link_is_up();    // IP assigned
+
+// Route default traffic (and DNS from the peer) through the link.
+void ppp_link_set_default();
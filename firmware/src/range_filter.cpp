@@ -0,0 +1,73 @@
+#include "range_filter.h"
+
+#include <math.h>
+#include <string.h>
+
+void range_filter_init(RangeFilter* filter, float maxDeviationCm, uint32_t windowMs,
+                       uint8_t minSamples) {
+    memset(filter, 0, sizeof(*filter));
+    filter->maxDeviationCm = maxDeviationCm;
+    filter->windowMs = windowMs;
+    filter->minSamples = minSamples;
+}
+
+void range_filter_push(RangeFilter* filter, uint32_t atMs, float cm) {
+    filter->samples[filter->next] = {atMs, cm};
+    filter->next = (filter->next + 1) % RANGE_FILTER_CAPACITY;
+    if (filter->count < RANGE_FILTER_CAPACITY) filter->count++;
+}
+
+static float median(float* values, int n) {
+    // Insertion sort; n <= RANGE_FILTER_CAPACITY
+    for (int i = 1; i < n; i++) {
+        float v = values[i];
+        int j = i;
+        while (j > 0 && values[j - 1] > v) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+RangeEstimate range_filter_estimate(const RangeFilter* filter, uint32_t nowMs) {
+    RangeEstimate est = {false, -1.0f, 0.0f, 0};
+
+    RangeSample recent[RANGE_FILTER_CAPACITY];
+    float values[RANGE_FILTER_CAPACITY];
+    int n = 0;
+    for (int i = 0; i < filter->count; i++) {
+        const RangeSample& s = filter->samples[i];
+        if (s.cm < 0 || nowMs - s.atMs > filter->windowMs) continue;
+        recent[n] = s;
+        values[n] = s.cm;
+        n++;
+    }
+    if (n < filter->minSamples || n == 0) return est;
+
+    float mid = median(values, n);
+
+    // Drop outliers, then fit cm = a + v * t over what's left
+    int used = 0;
+    float sumT = 0, sumD = 0, sumTT = 0, sumTD = 0;
+    for (int i = 0; i < n; i++) {
+        if (fabsf(recent[i].cm - mid) > filter->maxDeviationCm) continue;
+        float t = (float)(int32_t)(recent[i].atMs - nowMs) / 1000.0f;
+        values[used++] = recent[i].cm;
+        sumT += t;
+        sumD += recent[i].cm;
+        sumTT += t * t;
+        sumTD += t * recent[i].cm;
+    }
+    if (used < filter->minSamples) return est;
+
+    est.valid = true;
+    est.samplesUsed = (uint8_t)used;
+    est.distanceCm = median(values, used);
+    float denom = used * sumTT - sumT * sumT;
+    if (used >= 2 && denom > 1e-6f) {
+        est.velocityCmS = (used * sumTD - sumT * sumD) / denom;
+    }
+    return est;
+}
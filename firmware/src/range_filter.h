@@ -0,0 +1,43 @@
+#pragma once
+
+// Filter for a stream of ultrasonic range samples. Keeps the last
+// RANGE_FILTER_CAPACITY samples with their timestamps and, on demand,
+// estimates distance (median of the recent samples, after dropping
+// outliers that stray more than maxDeviationCm from it) and approach
+// velocity (least-squares slope of the surviving samples; negative when the
+// target is coming closer). A single bad echo therefore can't trigger the
+// camera, and a lost echo just counts as a missing sample.
+//
+// Portable; builds under the `native` env.
+
+#include <stdint.h>
+
+#define RANGE_FILTER_CAPACITY 9
+
+struct RangeSample {
+    uint32_t atMs;
+    float cm;  // < 0: no echo
+};
+
+struct RangeFilter {
+    RangeSample samples[RANGE_FILTER_CAPACITY];
+    uint8_t next;
+    uint8_t count;
+    float maxDeviationCm;
+    uint32_t windowMs;   // samples older than this are ignored
+    uint8_t minSamples;  // valid in-window inliers needed for an estimate
+};
+
+struct RangeEstimate {
+    bool valid;
+    float distanceCm;
+    float velocityCmS;
+    uint8_t samplesUsed;
+};
+
+void range_filter_init(RangeFilter* filter, float maxDeviationCm, uint32_t windowMs,
+                       uint8_t minSamples);
+
+void range_filter_push(RangeFilter* filter, uint32_t atMs, float cm);
+
+RangeEstimate range_filter_estimate(const RangeFilter* filter, uint32_t nowMs);
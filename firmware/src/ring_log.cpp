@@ -0,0 +1,158 @@
+#include "ring_log.h"
+
+#include <string.h>
+
+static const uint32_t kMagic = 0x51474F44;  // "DOGQ"
+static const uint32_t kVersion = 1;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t generation;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t capacity;
+    uint32_t slotSize;
+    uint32_t crc;  // over all preceding fields
+};
+static_assert(sizeof(Header) == RING_LOG_HEADER_BYTES, "header layout");
+
+struct RecordHeader {
+    uint32_t counter;  // must equal the counter the slot is read for
+    uint16_t len;
+    uint16_t reserved;
+    uint32_t crc;      // over counter, len and payload
+};
+static_assert(sizeof(RecordHeader) == RING_LOG_RECORD_OVERHEAD, "record layout");
+
+uint32_t ring_log_crc32(const void* data, size_t len, uint32_t crc) {
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+uint32_t ring_log_region_size(uint32_t capacity, uint32_t slotSize) {
+    return 2 * RING_LOG_HEADER_BYTES + capacity * slotSize;
+}
+
+static uint32_t slot_offset(const RingLog* log, uint32_t counter) {
+    return 2 * RING_LOG_HEADER_BYTES + (counter % log->capacity) * log->slotSize;
+}
+
+static uint32_t record_crc(const RecordHeader& rec, const void* payload) {
+    uint32_t crc = ring_log_crc32(&rec.counter, sizeof(rec.counter));
+    crc = ring_log_crc32(&rec.len, sizeof(rec.len), crc);
+    return ring_log_crc32(payload, rec.len, crc);
+}
+
+static bool header_valid(const Header& h, uint32_t capacity, uint32_t slotSize) {
+    return h.magic == kMagic && h.version == kVersion &&
+           h.crc == ring_log_crc32(&h, offsetof(Header, crc)) &&
+           h.capacity == capacity && h.slotSize == slotSize &&
+           h.tail - h.head <= capacity;
+}
+
+// Write the next header generation into the copy not holding the current one.
+static bool commit(RingLog* log, uint32_t head, uint32_t tail) {
+    Header h;
+    h.magic = kMagic;
+    h.version = kVersion;
+    h.generation = log->generation + 1;
+    h.head = head;
+    h.tail = tail;
+    h.capacity = log->capacity;
+    h.slotSize = log->slotSize;
+    h.crc = ring_log_crc32(&h, offsetof(Header, crc));
+
+    uint32_t offset = (h.generation % 2) * RING_LOG_HEADER_BYTES;
+    if (!log->io.write(log->io.ctx, offset, &h, sizeof(h))) return false;
+    if (log->io.sync && !log->io.sync(log->io.ctx)) return false;
+
+    log->generation = h.generation;
+    log->head = head;
+    log->tail = tail;
+    return true;
+}
+
+bool ring_log_open(RingLog* log, const RingLogIo& io, uint32_t capacity, uint32_t slotSize) {
+    memset(log, 0, sizeof(*log));
+    log->io = io;
+    log->capacity = capacity;
+    log->slotSize = slotSize;
+    if (capacity == 0 || slotSize <= RING_LOG_RECORD_OVERHEAD ||
+        slotSize - RING_LOG_RECORD_OVERHEAD > 0xFFFF) {
+        return false;
+    }
+
+    Header copies[2];
+    bool valid[2];
+    for (int i = 0; i < 2; i++) {
+        if (!io.read(io.ctx, i * RING_LOG_HEADER_BYTES, &copies[i], sizeof(Header))) return false;
+        valid[i] = header_valid(copies[i], capacity, slotSize);
+    }
+
+    const Header* latest = nullptr;
+    if (valid[0] && valid[1]) {
+        latest = (int32_t)(copies[0].generation - copies[1].generation) > 0 ? &copies[0] : &copies[1];
+    } else if (valid[0]) {
+        latest = &copies[0];
+    } else if (valid[1]) {
+        latest = &copies[1];
+    }
+
+    if (latest) {
+        log->generation = latest->generation;
+        log->head = latest->head;
+        log->tail = latest->tail;
+        return true;
+    }
+
+    // Fresh or incompatible region: start empty with both copies valid
+    return commit(log, 0, 0) && commit(log, 0, 0);
+}
+
+bool ring_log_push(RingLog* log, const void* data, size_t len) {
+    if (len > log->slotSize - RING_LOG_RECORD_OVERHEAD) return false;
+
+    RecordHeader rec;
+    rec.counter = log->tail;
+    rec.len = (uint16_t)len;
+    rec.reserved = 0;
+    rec.crc = record_crc(rec, data);
+
+    uint32_t offset = slot_offset(log, rec.counter);
+    if (!log->io.write(log->io.ctx, offset, &rec, sizeof(rec))) return false;
+    if (len > 0 && !log->io.write(log->io.ctx, offset + sizeof(rec), data, len)) return false;
+
+    uint32_t head = log->head;
+    if (ring_log_size(log) == log->capacity) {
+        head++;  // the slot just written held the oldest record
+        log->dropped++;
+    }
+    return commit(log, head, log->tail + 1);
+}
+
+int ring_log_peek(RingLog* log, uint32_t index, void* buf, size_t cap) {
+    if (index >= ring_log_size(log)) return -2;
+    uint32_t counter = log->head + index;
+    uint32_t offset = slot_offset(log, counter);
+
+    RecordHeader rec;
+    if (!log->io.read(log->io.ctx, offset, &rec, sizeof(rec))) return -2;
+    if (rec.counter != counter || rec.len > log->slotSize - RING_LOG_RECORD_OVERHEAD) return -1;
+    if (rec.len > cap) return -2;
+    if (rec.len > 0 && !log->io.read(log->io.ctx, offset + sizeof(rec), buf, rec.len)) return -2;
+    if (rec.crc != record_crc(rec, buf)) return -1;
+    return rec.len;
+}
+
+bool ring_log_pop(RingLog* log, uint32_t count) {
+    uint32_t size = ring_log_size(log);
+    if (count > size) count = size;
+    if (count == 0) return true;
+    return commit(log, log->head + count, log->tail);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// Fixed-capacity, CRC-protected ring log of small records on a preallocated
+// region (LittleFS files on device, a RAM buffer in host tests).
+//
+// Layout:  [header A][header B][slot 0][slot 1]...[slot capacity-1]
+//
+// head and tail are free-running record counters (slot = counter % capacity,
+// size = tail - head), so push, peek, pop and size are O(1) with no
+// directory scans. Every push/pop commits a new header alternately to A or B
+// with an incremented generation and a CRC; a torn header write leaves the
+// other copy intact, so the pointers always reload to the last committed
+// state. Records carry their own counter and CRC, so a slot that was being
+// written during a power cut is detected and skipped rather than replayed.
+// Slots are written round-robin, spreading wear evenly across the region.
+//
+// Portable; builds under the `native` env.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Storage backend: byte-addressed reads/writes within the region.
+struct RingLogIo {
+    bool (*read)(void* ctx, uint32_t offset, void* buf, size_t len);
+    bool (*write)(void* ctx, uint32_t offset, const void* buf, size_t len);
+    bool (*sync)(void* ctx);  // may be null
+    void* ctx;
+};
+
+struct RingLog {
+    RingLogIo io;
+    uint32_t capacity;    // records
+    uint32_t slotSize;    // bytes per slot, including the record header
+    uint32_t head;        // counter of the oldest record
+    uint32_t tail;        // counter the next push will use
+    uint32_t generation;  // header commit counter
+    uint32_t dropped;     // oldest records overwritten because the log was full
+};
+
+#define RING_LOG_HEADER_BYTES 32
+#define RING_LOG_RECORD_OVERHEAD 12
+
+// Bytes of backing storage needed for `capacity` slots of `slotSize`.
+uint32_t ring_log_region_size(uint32_t capacity, uint32_t slotSize);
+
+// Load the log from `io`, or format it (empty) if neither header is valid
+// or the geometry changed. Returns false only on I/O failure.
+bool ring_log_open(RingLog* log, const RingLogIo& io, uint32_t capacity, uint32_t slotSize);
+
+// Append a record of up to slotSize - RING_LOG_RECORD_OVERHEAD bytes. When
+// the log is full the oldest record is overwritten (and counted in
+// `dropped`).
+bool ring_log_push(RingLog* log, const void* data, size_t len);
+
+// Copy the record `index` places after head into `buf`. Returns its length,
+// -1 if the record is corrupt (it should be popped and skipped) or -2 on an
+// I/O error / out-of-range index / buffer too small.
+int ring_log_peek(RingLog* log, uint32_t index, void* buf, size_t cap);
+
+// Discard the `count` oldest records with a single header commit.
+bool ring_log_pop(RingLog* log, uint32_t count);
+
+inline uint32_t ring_log_size(const RingLog* log) { return log->tail - log->head; }
+
+uint32_t ring_log_crc32(const void* data, size_t len, uint32_t crc = 0);
@@ -0,0 +1,139 @@
+#include "sensor_events.h"
+#include "config.h"
+#include "debounce.h"
+#include <soc/gpio_reg.h>
+
+struct RawEdge {
+    uint8_t input;
+    uint32_t atUs;
+};
+
+struct InputConfig {
+    uint8_t pin;
+    bool activeLevel;
+    uint32_t settleMs;
+};
+
+// In DRAM: read from the ISR
+static DRAM_ATTR const InputConfig kInputs[SENSOR_INPUT_COUNT] = {
+    {PIN_RADAR, HIGH, SENSOR_RADAR_DEBOUNCE_MS},
+    {PIN_IR_BEAM, LOW, SENSOR_IR_BEAM_DEBOUNCE_MS},      // active low
+    {PIN_REED_SWITCH, LOW, SENSOR_REED_DEBOUNCE_MS},     // LOW = magnet near = closed
+};
+
+struct Subscriber {
+    QueueHandle_t queue;
+    uint8_t mask;
+};
+
+static QueueHandle_t _edges = nullptr;
+static Debouncer _debounce[SENSOR_INPUT_COUNT];
+static volatile bool _state[SENSOR_INPUT_COUNT];
+static Subscriber _subscribers[SENSOR_EVENTS_MAX_SUBSCRIBERS];
+static uint8_t _subscriberCount = 0;
+static portMUX_TYPE _subscriberMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t _edgesDropped = 0;
+static SensorIsrHook volatile _isrHooks[SENSOR_INPUT_COUNT];
+
+static bool IRAM_ATTR read_active(int i) {
+    return ((REG_READ(GPIO_IN_REG) >> kInputs[i].pin) & 1) == kInputs[i].activeLevel;
+}
+
+static void IRAM_ATTR edge_isr(void* arg) {
+    RawEdge edge = {(uint8_t)(uintptr_t)arg, (uint32_t)micros()};
+    SensorIsrHook hook = _isrHooks[edge.input];
+    if (hook) hook(read_active(edge.input), edge.atUs);
+
+    BaseType_t woken = pdFALSE;
+    // A lost edge is picked up again from the level on the next resync
+    if (xQueueSendToBackFromISR(_edges, &edge, &woken) != pdTRUE) _edgesDropped++;
+    if (woken) portYIELD_FROM_ISR();
+}
+
+static void publish(const SensorEvent& event) {
+    _state[(int)event.input] = event.active;
+    uint8_t bit = SENSOR_INPUT_BIT(event.input);
+    portENTER_CRITICAL(&_subscriberMux);
+    uint8_t count = _subscriberCount;
+    portEXIT_CRITICAL(&_subscriberMux);
+    for (int i = 0; i < count; i++) {
+        if (_subscribers[i].mask & bit) xQueueSendToBack(_subscribers[i].queue, &event, 0);
+    }
+}
+
+static void dispatch_task(void*) {
+    uint32_t dropsReported = 0;
+    for (;;) {
+        uint32_t now = micros();
+        uint32_t waitUs = SENSOR_EVENTS_RESYNC_MS * 1000UL;
+        for (int i = 0; i < SENSOR_INPUT_COUNT; i++) {
+            uint32_t w = debounce_wait_us(&_debounce[i], now);
+            if (w < waitUs) waitUs = w;
+        }
+        // Round up so a pending settle is never checked a tick early
+        TickType_t wait = (waitUs + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000);
+
+        RawEdge edge;
+        if (xQueueReceive(_edges, &edge, wait) == pdTRUE) {
+            do {
+                debounce_edge(&_debounce[edge.input], edge.atUs);
+            } while (xQueueReceive(_edges, &edge, 0) == pdTRUE);
+        }
+
+        now = micros();
+        for (int i = 0; i < SENSOR_INPUT_COUNT; i++) {
+            uint32_t changedAt;
+            if (debounce_poll(&_debounce[i], read_active(i), now, &changedAt)) {
+                publish({(SensorInput)i, _debounce[i].stable, changedAt});
+            }
+        }
+
+        if (_edgesDropped != dropsReported) {
+            dropsReported = _edgesDropped;
+            Serial.printf("[SENSOR] Edge queue overflowed (%lu edges dropped)\n",
+                          (unsigned long)dropsReported);
+        }
+    }
+}
+
+void sensor_events_start() {
+    _edges = xQueueCreate(SENSOR_EVENTS_EDGE_QUEUE_DEPTH, sizeof(RawEdge));
+    for (int i = 0; i < SENSOR_INPUT_COUNT; i++) {
+        bool level = read_active(i);
+        debounce_init(&_debounce[i], level, kInputs[i].settleMs * 1000UL);
+        _state[i] = level;
+    }
+    xTaskCreatePinnedToCore(dispatch_task, "sensor_events", SENSOR_EVENTS_TASK_STACK, nullptr,
+                            SENSOR_EVENTS_TASK_PRIORITY, nullptr, 1);
+    for (int i = 0; i < SENSOR_INPUT_COUNT; i++) {
+        attachInterruptArg(digitalPinToInterrupt(kInputs[i].pin), edge_isr,
+                           (void*)(uintptr_t)i, CHANGE);
+    }
+}
+
+QueueHandle_t sensor_events_subscribe(uint8_t mask, uint8_t depth) {
+    QueueHandle_t queue = xQueueCreate(depth, sizeof(SensorEvent));
+    if (!queue) return nullptr;
+    portENTER_CRITICAL(&_subscriberMux);
+    bool added = _subscriberCount < SENSOR_EVENTS_MAX_SUBSCRIBERS;
+    if (added) {
+        // Filled in before the count is published to the dispatcher
+        _subscribers[_subscriberCount] = {queue, mask};
+        _subscriberCount++;
+    }
+    portEXIT_CRITICAL(&_subscriberMux);
+    if (!added) {
+        vQueueDelete(queue);
+        Serial.println("[SENSOR] No subscriber slot left");
+        return nullptr;
+    }
+    return queue;
+}
+
+bool sensor_events_state(SensorInput input) {
+    return _state[(int)input];
+}
+
+void sensor_events_set_isr_hook(SensorInput input, SensorIsrHook hook) {
+    _isrHooks[(int)input] = hook;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Edge-interrupt capture for the radar, IR break beam and reed switch.
+// Each pin's ISR only timestamps the edge and queues it; a small dispatcher
+// task debounces every input (debounce.h), reads the settled level and
+// fans the change out to subscriber queues. Consumers block on their queue
+// instead of polling, so a radar edge reaches the sensing task within a
+// context switch and the beam interlock doesn't wait on a check interval.
+//
+// Event times are micros() of the first edge of the burst. Inputs that need
+// a faster response than that get a hook run inside the ISR.
+
+#include <Arduino.h>
+
+enum class SensorInput : uint8_t { Radar, IrBeam, ReedSwitch };
+#define SENSOR_INPUT_COUNT 3
+#define SENSOR_INPUT_BIT(input) (1u << (uint8_t)(input))
+
+struct SensorEvent {
+    SensorInput input;
+    bool active;    // radar: motion; IR beam: broken; reed switch: door closed
+    uint32_t atUs;  // micros() of the first edge of the change
+};
+
+// Attach the pin interrupts and start the dispatcher. Called by sensors_init().
+void sensor_events_start();
+
+// Queue of SensorEvents for the inputs in `mask` (SENSOR_INPUT_BIT). Safe to
+// call before or after start; events are dropped, not waited on, when the
+// subscriber's queue is full. Returns nullptr if no slot or memory is left.
+QueueHandle_t sensor_events_subscribe(uint8_t mask, uint8_t depth);
+
+// Last debounced state of an input
+bool sensor_events_state(SensorInput input);
+
+// Called from the edge ISR itself, before debouncing, with the raw level.
+// For safety responses that can't wait for the dispatcher: must be
+// IRAM_ATTR and only do ISR-safe work. One hook per input; nullptr clears it.
+typedef void (*SensorIsrHook)(bool active, uint32_t atUs);
+void sensor_events_set_isr_hook(SensorInput input, SensorIsrHook hook);
@@ -1,5 +1,11 @@
 #include "sensors.h"
 #include "config.h"
+#include "range_filter.h"
+#include "sensor_events.h"
+#include <esp_timer.h>
+#include <soc/gpio_reg.h>
+
+static void ultrasonic_start();
 
 void sensors_init() {
     pinMode(PIN_RADAR, INPUT);
@@ -13,36 +19,73 @@ void sensors_init() {
     digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
     digitalWrite(PIN_LED_GREEN, LOW);
     digitalWrite(PIN_LED_RED, LOW);
+
+    ultrasonic_start();
+    sensor_events_start();
 }
 
 bool radar_detected() {
     return digitalRead(PIN_RADAR) == HIGH;
 }
 
-float ultrasonic_distance_cm() {
-    // Send trigger pulse
-    digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
-    delayMicroseconds(2);
-    digitalWrite(PIN_ULTRASONIC_TRIG, HIGH);
-    delayMicroseconds(10);
-    digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
+// ---- Ultrasonic ----
+// The echo pin's edges are timestamped in an ISR; a periodic esp_timer
+// collects the previous ping's pulse width into the filter and sends the
+// next trigger pulse. Readers only take the filter's lock.
 
-    // Measure echo duration
-    long duration = pulseIn(PIN_ULTRASONIC_ECHO, HIGH, 30000); // 30ms timeout
+static volatile uint32_t _echoRiseUs = 0;
+static volatile uint32_t _echoWidthUs = 0;  // 0 until the falling edge arrives
+static RangeFilter _range;
+static portMUX_TYPE _rangeMux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t _pingTimer = nullptr;
 
-    if (duration == 0) {
-        return -1.0f; // No echo received
+static void IRAM_ATTR echo_isr() {
+    uint32_t now = micros();
+    if ((REG_READ(GPIO_IN_REG) >> PIN_ULTRASONIC_ECHO) & 1) {
+        _echoRiseUs = now;
+    } else if (_echoRiseUs) {
+        _echoWidthUs = now - _echoRiseUs;
     }
+}
 
-    // Calculate distance: speed of sound = 343 m/s = 0.0343 cm/us
-    // Distance = (duration * 0.0343) / 2
-    float distance = (duration * 0.0343f) / 2.0f;
+static void ping(void*) {
+    // Result of the previous ping; no falling edge by now means no echo
+    uint32_t width = _echoWidthUs;
+    float cm = width ? (width * 0.0343f) / 2.0f : -1.0f;  // 343 m/s, there and back
+    if (cm > ULTRASONIC_MAX_DISTANCE_CM) cm = -1.0f;
+    portENTER_CRITICAL(&_rangeMux);
+    range_filter_push(&_range, millis(), cm);
+    portEXIT_CRITICAL(&_rangeMux);
 
-    if (distance > ULTRASONIC_MAX_DISTANCE_CM) {
-        return -1.0f;
-    }
+    _echoRiseUs = 0;
+    _echoWidthUs = 0;
+    digitalWrite(PIN_ULTRASONIC_TRIG, HIGH);
+    delayMicroseconds(10);
+    digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
+}
 
-    return distance;
+static void ultrasonic_start() {
+    range_filter_init(&_range, ULTRASONIC_OUTLIER_CM, ULTRASONIC_FILTER_WINDOW_MS,
+                      ULTRASONIC_MIN_SAMPLES);
+    attachInterrupt(digitalPinToInterrupt(PIN_ULTRASONIC_ECHO), echo_isr, CHANGE);
+    esp_timer_create_args_t args = {};
+    args.callback = ping;
+    args.name = "ultrasonic";
+    esp_timer_create(&args, &_pingTimer);
+    esp_timer_start_periodic(_pingTimer, ULTRASONIC_PING_INTERVAL_MS * 1000ULL);
+}
+
+UltrasonicReading ultrasonic_read() {
+    portENTER_CRITICAL(&_rangeMux);
+    RangeFilter snapshot = _range;
+    portEXIT_CRITICAL(&_rangeMux);
+    RangeEstimate est = range_filter_estimate(&snapshot, millis());
+    return {est.valid, est.distanceCm, est.velocityCmS, est.samplesUsed};
+}
+
+float ultrasonic_distance_cm() {
+    UltrasonicReading r = ultrasonic_read();
+    return r.valid ? r.distanceCm : -1.0f;
 }
 
 bool ir_beam_broken() {
@@ -6,12 +6,26 @@
 
 #include <Arduino.h>
 
+// Also starts edge capture for radar, IR beam and reed switch; subscribe to
+// those through sensor_events.h rather than polling the functions below.
 void sensors_init();
 
 // Radar: returns true if motion detected
 bool radar_detected();
 
-// Ultrasonic: returns distance in cm, -1 on error
+// Ultrasonic ranging runs in the background: a timer pings every
+// ULTRASONIC_PING_INTERVAL_MS and the echo is timed by edge interrupts, so
+// reading never blocks. Samples are median/outlier filtered (range_filter.h).
+struct UltrasonicReading {
+    bool valid;           // enough recent, consistent echoes
+    float distanceCm;
+    float velocityCmS;    // negative while the target approaches
+    uint8_t samples;      // echoes behind the estimate
+};
+
+UltrasonicReading ultrasonic_read();
+
+// Filtered distance in cm, -1 if there is no stable reading
 float ultrasonic_distance_cm();
 
 // IR break beam: returns true if beam is broken (something in doorway)
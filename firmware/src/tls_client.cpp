@@ -0,0 +1,246 @@
+#include "tls_client.h"
+#include <WiFi.h>
+#include <lwip/sockets.h>
+
+ResumableTlsClient::ResumableTlsClient()
+    : _timeoutMs(10000), _lastHandshakeUs(0), _peeked(-1),
+      _rngReady(false), _caLoaded(false), _caInvalid(false), _haveSession(false), _offeredSession(false),
+      _connected(false) {
+    _sessionHost[0] = '\0';
+    mbedtls_net_init(&_net);
+    mbedtls_ssl_init(&_ssl);
+    mbedtls_ssl_config_init(&_conf);
+    mbedtls_entropy_init(&_entropy);
+    mbedtls_ctr_drbg_init(&_drbg);
+    mbedtls_x509_crt_init(&_ca);
+    mbedtls_ssl_session_init(&_session);
+}
+
+ResumableTlsClient::~ResumableTlsClient() {
+    stop();
+    mbedtls_ssl_session_free(&_session);
+    mbedtls_x509_crt_free(&_ca);
+    mbedtls_ctr_drbg_free(&_drbg);
+    mbedtls_entropy_free(&_entropy);
+}
+
+void ResumableTlsClient::setCACert(const char* pem) {
+    mbedtls_x509_crt_free(&_ca);
+    mbedtls_x509_crt_init(&_ca);
+    _caLoaded = pem && pem[0] &&
+        mbedtls_x509_crt_parse(&_ca, (const unsigned char*)pem, strlen(pem) + 1) == 0;
+    _caInvalid = pem && pem[0] && !_caLoaded;
+    if (_caInvalid) {
+        Serial.println("[TLS] Failed to parse CA certificate; connections will be refused");
+    }
+}
+
+bool ResumableTlsClient::initRng() {
+    if (_rngReady) return true;
+    static const char pers[] = "dogdoor-tls";
+    _rngReady = mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy,
+                                      (const unsigned char*)pers, sizeof(pers) - 1) == 0;
+    return _rngReady;
+}
+
+// TCP connect with a bounded wait (lwIP's own SYN timeout is far longer
+// than API_TIMEOUT_MS).
+int ResumableTlsClient::openSocket(const char* host, uint16_t port) {
+    IPAddress ip;
+    if (!WiFi.hostByName(host, ip)) return -1;
+
+    int fd = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = (uint32_t)ip;
+
+    int flags = lwip_fcntl(fd, F_GETFL, 0);
+    lwip_fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int res = lwip_connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+    if (res < 0 && errno != EINPROGRESS) {
+        lwip_close(fd);
+        return -1;
+    }
+
+    fd_set wfds;
+    FD_ZERO(&wfds);
+    FD_SET(fd, &wfds);
+    struct timeval tv = {(time_t)(_timeoutMs / 1000), (suseconds_t)((_timeoutMs % 1000) * 1000)};
+    res = lwip_select(fd + 1, nullptr, &wfds, nullptr, &tv);
+    int sockErr = 0;
+    socklen_t errLen = sizeof(sockErr);
+    if (res <= 0 || lwip_getsockopt(fd, SOL_SOCKET, SO_ERROR, &sockErr, &errLen) < 0 || sockErr) {
+        lwip_close(fd);
+        return -1;
+    }
+
+    lwip_fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+    lwip_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    lwip_setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    int one = 1;
+    lwip_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+int ResumableTlsClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port);
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port) {
+    stop();
+    if (_caInvalid) {
+        Serial.printf("[TLS] Not connecting to %s: configured CA certificate is invalid\n", host);
+        return 0;
+    }
+    if (!initRng()) return 0;
+
+    uint32_t start = micros();
+    int fd = openSocket(host, port);
+    if (fd < 0) return 0;
+    _net.fd = fd;
+
+    if (mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                    MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+        teardown();
+        return 0;
+    }
+    if (_caLoaded) {
+        mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+        mbedtls_ssl_conf_ca_chain(&_conf, &_ca, nullptr);
+    } else {
+        mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_NONE);
+    }
+    mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_drbg);
+    mbedtls_ssl_conf_read_timeout(&_conf, _timeoutMs);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+    if (mbedtls_ssl_setup(&_ssl, &_conf) != 0 || mbedtls_ssl_set_hostname(&_ssl, host) != 0) {
+        teardown();
+        return 0;
+    }
+    mbedtls_ssl_set_bio(&_ssl, &_net, mbedtls_net_send, nullptr, mbedtls_net_recv_timeout);
+
+    _offeredSession = _haveSession && strcmp(_sessionHost, host) == 0;
+    if (_offeredSession) mbedtls_ssl_set_session(&_ssl, &_session);
+
+    int ret;
+    while ((ret = mbedtls_ssl_handshake(&_ssl)) != 0) {
+        if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) continue;
+        Serial.printf("[TLS] Handshake with %s failed: -0x%04x\n", host, -ret);
+        // A stale ticket must not poison every later attempt
+        if (_offeredSession) clearSession();
+        teardown();
+        return 0;
+    }
+    _lastHandshakeUs = micros() - start;
+
+    // Keep this connection's session for the next reconnect
+    mbedtls_ssl_session_free(&_session);
+    mbedtls_ssl_session_init(&_session);
+    _haveSession = mbedtls_ssl_get_session(&_ssl, &_session) == 0;
+    if (_haveSession) strlcpy(_sessionHost, host, sizeof(_sessionHost));
+
+    // From here on reads are polled through available(), so never block in recv
+    mbedtls_net_set_nonblock(&_net);
+    mbedtls_ssl_set_bio(&_ssl, &_net, mbedtls_net_send, mbedtls_net_recv, nullptr);
+    _peeked = -1;
+    _connected = true;
+    return 1;
+}
+
+size_t ResumableTlsClient::write(const uint8_t* buf, size_t size) {
+    if (!_connected) return 0;
+    size_t sent = 0;
+    unsigned long deadline = millis() + _timeoutMs;
+    while (sent < size) {
+        int ret = mbedtls_ssl_write(&_ssl, buf + sent, size - sent);
+        if (ret > 0) {
+            sent += ret;
+            continue;
+        }
+        if ((ret != MBEDTLS_ERR_SSL_WANT_WRITE && ret != MBEDTLS_ERR_SSL_WANT_READ) ||
+            (long)(millis() - deadline) >= 0) {
+            teardown();
+            break;
+        }
+        delay(1);
+    }
+    return sent;
+}
+
+int ResumableTlsClient::available() {
+    if (!_connected) return _peeked >= 0 ? 1 : 0;
+    int ret = mbedtls_ssl_read(&_ssl, nullptr, 0);
+    if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+        // Close notify, EOF or a fatal alert
+        int peeked = _peeked;
+        teardown();
+        _peeked = peeked;
+        return peeked >= 0 ? 1 : 0;
+    }
+    return (int)mbedtls_ssl_get_bytes_avail(&_ssl) + (_peeked >= 0 ? 1 : 0);
+}
+
+int ResumableTlsClient::read(uint8_t* buf, size_t size) {
+    if (size == 0) return 0;
+    size_t n = 0;
+    if (_peeked >= 0) {
+        buf[n++] = (uint8_t)_peeked;
+        _peeked = -1;
+        if (n == size) return 1;
+    }
+    if (!_connected || available() == 0) return n ? (int)n : -1;
+
+    int ret = mbedtls_ssl_read(&_ssl, buf + n, size - n);
+    if (ret > 0) return (int)n + ret;
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) teardown();
+    return n ? (int)n : -1;
+}
+
+int ResumableTlsClient::read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+}
+
+int ResumableTlsClient::peek() {
+    if (_peeked < 0) {
+        uint8_t b;
+        if (read(&b, 1) == 1) _peeked = b;
+    }
+    return _peeked;
+}
+
+uint8_t ResumableTlsClient::connected() {
+    if (_connected && _peeked < 0 && mbedtls_ssl_get_bytes_avail(&_ssl) == 0) {
+        available();  // notices a peer close
+    }
+    return _connected;
+}
+
+void ResumableTlsClient::stop() {
+    if (_connected) mbedtls_ssl_close_notify(&_ssl);
+    teardown();
+}
+
+void ResumableTlsClient::clearSession() {
+    mbedtls_ssl_session_free(&_session);
+    mbedtls_ssl_session_init(&_session);
+    _haveSession = false;
+    _sessionHost[0] = '\0';
+}
+
+void ResumableTlsClient::teardown() {
+    mbedtls_net_free(&_net);
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_config_free(&_conf);
+    mbedtls_net_init(&_net);
+    mbedtls_ssl_init(&_ssl);
+    mbedtls_ssl_config_init(&_conf);
+    _connected = false;
+    _peeked = -1;
+}
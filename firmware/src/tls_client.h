@@ -0,0 +1,71 @@
+#pragma once
+
+// TLS client (mbedTLS over an lwIP socket) that remembers the session from
+// its last handshake and offers it on the next connect to the same host, so
+// a reconnect is an abbreviated handshake (session ticket or session ID)
+// instead of a full key exchange. WiFiClientSecure discards the session on
+// stop(), which makes every reconnect pay for a full handshake.
+
+#include <Arduino.h>
+#include <Client.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+
+class ResumableTlsClient : public Client {
+public:
+    ResumableTlsClient();
+    ~ResumableTlsClient();
+
+    // PEM CA bundle; null or empty disables certificate verification. A
+    // bundle that doesn't parse makes every connect() fail.
+    void setCACert(const char* pem);
+    void setTimeout(uint32_t ms) { _timeoutMs = ms; }
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t b) override { return write(&b, 1); }
+    size_t write(const uint8_t* buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return connected(); }
+
+    // Forget the cached session (e.g. after the server rejected it).
+    void clearSession();
+
+    // Duration of the most recent handshake and whether a cached session
+    // was offered for it.
+    uint32_t lastHandshakeUs() const { return _lastHandshakeUs; }
+    bool lastHandshakeOfferedSession() const { return _offeredSession; }
+
+private:
+    bool initRng();
+    int openSocket(const char* host, uint16_t port);
+    void teardown();
+
+    mbedtls_net_context _net;
+    mbedtls_ssl_context _ssl;
+    mbedtls_ssl_config _conf;
+    mbedtls_entropy_context _entropy;
+    mbedtls_ctr_drbg_context _drbg;
+    mbedtls_x509_crt _ca;
+    mbedtls_ssl_session _session;
+
+    char _sessionHost[64];
+    uint32_t _timeoutMs;
+    uint32_t _lastHandshakeUs;
+    int _peeked;
+    bool _rngReady;
+    bool _caLoaded;
+    bool _caInvalid;  // configured but unparseable: fail closed
+    bool _haveSession;
+    bool _offeredSession;
+    bool _connected;
+};
@@ -0,0 +1,199 @@
+#include "uplink.h"
+#include "config.h"
+#include "network_manager.h"
+#include "offline_queue.h"
+#include "image_spool.h"
+#include "hash_sync.h"
+#include "power_monitor.h"
+#include "wifi_manager.h"
+#include "api_connection.h"
+#include "phase_arena.h"
+#include <WiFi.h>
+#include <esp_task_wdt.h>
+
+enum class UplinkJobType : uint8_t { Approach, Access, Event };
+
+struct UplinkJob {
+    UplinkJobType type;
+    Frame* frame;            // Approach/Access: reference owned by the job
+    const char* side;
+    AccessContext access;    // Access: handed back with the result
+    const char* eventType;   // Event: string literal
+    char notes[64];
+    double batteryVoltage;
+};
+
+static QueueHandle_t _jobQueue = nullptr;
+static AccessResultHandler _onAccessResult = nullptr;
+static volatile bool _reconnectRequested = false;
+static unsigned long _lastMaintenance = 0;
+static unsigned long _lastStatsLog = 0;
+static PhaseArena _arena;  // upload staging: reduced-JPEG decode and resample
+
+// Keep the links up and drain deferred work. Runs between jobs only, so a
+// slow reconnect or flush delays later uploads but never the tasks that
+// queued them.
+static void maintain_network() {
+    // Each step can block for several seconds; the task watchdog is fed
+    // between them
+    if (_reconnectRequested) {
+        _reconnectRequested = false;
+        api_connection_close();
+        WiFi.disconnect();
+        wifi_connect();
+        esp_task_wdt_reset();
+    }
+
+    power_monitor_update(API_KEY);
+    esp_task_wdt_reset();
+    network_manager_ensure_connected();
+    esp_task_wdt_reset();
+    api_connection_maintain(network_manager_has_ip());
+    esp_task_wdt_reset();
+
+#if LOCAL_GRANT_ENABLED
+    if (network_manager_has_ip() && hash_sync_due()) {
+        hash_sync_run();
+        esp_task_wdt_reset();
+    }
+#endif
+    if (network_manager_is_connected() && offline_queue_size() > 0) {
+        offline_queue_flush(API_BASE_URL API_FIRMWARE_EVENT_BATCH_ENDPOINT);
+        esp_task_wdt_reset();
+    }
+    // One image per pass; large uploads mustn't hold up queued access requests.
+    // Backfill waits for a link fast (and cheap) enough for full frames.
+    if (network_manager_has_ip() && image_spool_count() > 0 &&
+        network_manager_payload_class() == PayloadClass::Full) {
+        image_spool_upload_next();
+        esp_task_wdt_reset();
+    }
+
+    if (millis() - _lastStatsLog >= TRANSPORT_STATS_LOG_INTERVAL_MS) {
+        api_connection_log_stats();
+        _lastStatsLog = millis();
+    }
+}
+
+// Frame jobs check the uplink arena out around their encode and upload
+static ArenaMark begin_frame_job() {
+    phase_arena_checkout(&_arena);
+    return phase_arena_begin(&_arena, ArenaPhase::Encode);
+}
+
+static void end_frame_job(ArenaMark mark) {
+    phase_arena_end(&_arena, mark);
+    phase_arena_checkin();
+    if (phase_arena_grew(&_arena)) {
+        char line[160];
+        phase_arena_format_stats(&_arena, line, sizeof(line));
+        Serial.printf("[ARENA] uplink: %s\n", line);
+    }
+}
+
+static void run_job(const UplinkJob& job) {
+    switch (job.type) {
+        case UplinkJobType::Approach: {
+            ArenaMark mark = begin_frame_job();
+            api_post_approach_photo(job.frame, job.side);
+            end_frame_job(mark);
+            frame_release(job.frame);
+            break;
+        }
+        case UplinkJobType::Access: {
+            const AccessContext& access = job.access;
+            ArenaMark mark = begin_frame_job();
+            AccessResponse response = api_request_access_direct(job.frame, job.side,
+                                                                access.combined ? &access.detection : nullptr);
+            end_frame_job(mark);
+            frame_release(job.frame);
+            if (_onAccessResult) _onAccessResult(response, job.access);
+            break;
+        }
+        case UplinkJobType::Event:
+            api_post_firmware_event(API_KEY, job.eventType,
+                                    job.notes[0] ? job.notes : nullptr, job.batteryVoltage);
+            break;
+    }
+}
+
+static void uplink_task(void*) {
+    esp_task_wdt_add(NULL);
+    UplinkJob job;
+    for (;;) {
+        esp_task_wdt_reset();
+        if (xQueueReceive(_jobQueue, &job, pdMS_TO_TICKS(UPLINK_MAINTENANCE_INTERVAL_MS)) == pdTRUE) {
+            run_job(job);
+        }
+        if (uxQueueMessagesWaiting(_jobQueue) == 0 &&
+            millis() - _lastMaintenance >= UPLINK_MAINTENANCE_INTERVAL_MS) {
+            maintain_network();
+            _lastMaintenance = millis();
+        }
+    }
+}
+
+void uplink_init(AccessResultHandler onAccessResult) {
+    _onAccessResult = onAccessResult;
+    void* scratch = psramFound() ? ps_malloc(UPLINK_SCRATCH_BYTES) : nullptr;
+    phase_arena_init(&_arena, scratch, scratch ? UPLINK_SCRATCH_BYTES : 0);
+    _jobQueue = xQueueCreate(UPLINK_QUEUE_DEPTH, sizeof(UplinkJob));
+    xTaskCreatePinnedToCore(uplink_task, "uplink", UPLINK_TASK_STACK, nullptr,
+                            UPLINK_TASK_PRIORITY, nullptr, 0);
+    Serial.println("[OK] Uplink task started on core 0");
+}
+
+static bool submit_frame(UplinkJobType type, Frame* frame, const char* side,
+                         const AccessContext* access, bool urgent) {
+    if (!_jobQueue || !frame) return false;
+    frame_retain(frame);
+    UplinkJob job = {};
+    job.type = type;
+    job.frame = frame;
+    job.side = side;
+    if (access) job.access = *access;
+    BaseType_t ok = urgent ? xQueueSendToFront(_jobQueue, &job, 0)
+                           : xQueueSendToBack(_jobQueue, &job, 0);
+    if (ok != pdTRUE) {
+        frame_release(frame);
+        return false;
+    }
+    return true;
+}
+
+bool uplink_submit_approach(Frame* frame, const char* side) {
+    if (!submit_frame(UplinkJobType::Approach, frame, side, nullptr, false)) {
+        Serial.println("[UPLINK] Queue full; skipping approach upload");
+        return false;
+    }
+    return true;
+}
+
+bool uplink_submit_access(Frame* frame, const char* side, const AccessContext& context) {
+    // A combined request for a non-dog only logs the approach; it queues
+    // like the upload it replaces
+    bool urgent = !context.combined || context.detection.dog;
+    if (!submit_frame(UplinkJobType::Access, frame, side, &context, urgent)) {
+        Serial.println("[UPLINK] Queue full; dropping access request");
+        return false;
+    }
+    return true;
+}
+
+bool uplink_post_event(const char* eventType, const char* notes, double batteryVoltage) {
+    if (!_jobQueue) return false;
+    UplinkJob job = {};
+    job.type = UplinkJobType::Event;
+    job.eventType = eventType;
+    if (notes) strlcpy(job.notes, notes, sizeof(job.notes));
+    job.batteryVoltage = batteryVoltage;
+    if (xQueueSendToBack(_jobQueue, &job, 0) != pdTRUE) {
+        Serial.printf("[UPLINK] Queue full; dropping event %s\n", eventType);
+        return false;
+    }
+    return true;
+}
+
+void uplink_request_reconnect() {
+    _reconnectRequested = true;
+}
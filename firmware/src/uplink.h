@@ -0,0 +1,43 @@
+#pragma once
+
+// Network task on core 0. Owns every blocking network operation: approach
+// uploads, access requests, firmware events, WiFi/cellular reconnects,
+// offline-queue flushes, hash-table syncs and power reporting. Other tasks
+// hand it work through a bounded queue and never wait on it; access requests
+// jump the queue ahead of uploads and events.
+
+#include <Arduino.h>
+#include "frame_handle.h"
+#include "api_client.h"
+
+// What the vision task knew when it asked for access; handed back with the
+// result.
+struct AccessContext {
+    uint32_t attempt;    // access_gate.h attempt the reply settles
+    bool hashed;         // frameHash is set
+    uint64_t frameHash;  // dHash of the frame sent, for the decision cache
+    bool combined;       // also log the approach; send `detection` with it
+    DetectionInfo detection;
+};
+
+// Called on the uplink task with the result of each access request, along
+// with the context passed to uplink_submit_access().
+typedef void (*AccessResultHandler)(const AccessResponse& response, const AccessContext& context);
+
+void uplink_init(AccessResultHandler onAccessResult);
+
+// Queue an approach-photo upload for `frame`. Takes its own reference, which
+// is released once the upload finishes. Returns false (and drops the upload)
+// if the queue is full.
+bool uplink_submit_approach(Frame* frame, const char* side);
+
+// Queue an access request for `frame` (same reference rules as above). The
+// result is delivered to the handler passed to uplink_init().
+bool uplink_submit_access(Frame* frame, const char* side, const AccessContext& context);
+
+// Queue a firmware event. `eventType` must be a string literal; `notes` is
+// copied (truncated to 63 chars) and may be null.
+bool uplink_post_event(const char* eventType, const char* notes, double batteryVoltage);
+
+// Drop and re-establish WiFi with freshly provisioned credentials.
+void uplink_request_reconnect();
@@ -0,0 +1,121 @@
+/*
+ * Host-side tests for the access-attempt gate.
+ *
+ * Run with: pio test -e native -f test_access_gate
+ */
+
+#include <unity.h>
+
+#include "access_gate.h"
+
+static AccessGate gate;
+
+void setUp(void) {
+    access_gate_init(&gate);
+}
+
+void tearDown(void) {}
+
+void test_confirmed_trigger_opens_on_dog_and_access(void) {
+    uint32_t id = access_gate_begin(&gate, 1234, ACCESS_CHECK_BIT(AccessCheck::Range));
+    TEST_ASSERT_EQUAL(GateOutcome::Pending, access_gate_verdict(&gate, id, AccessCheck::Dog, true).outcome);
+    GateResult r = access_gate_verdict(&gate, id, AccessCheck::Access, true);
+    TEST_ASSERT_EQUAL(GateOutcome::Open, r.outcome);
+    TEST_ASSERT_EQUAL_UINT32(1234, r.triggeredAtUs);
+    TEST_ASSERT_TRUE(access_gate_opened(&gate, id));
+}
+
+void test_speculative_waits_for_range_whatever_the_order(void) {
+    uint32_t id = access_gate_begin(&gate, 0, 0);
+    TEST_ASSERT_EQUAL(GateOutcome::Pending, access_gate_verdict(&gate, id, AccessCheck::Access, true).outcome);
+    TEST_ASSERT_EQUAL(GateOutcome::Pending, access_gate_verdict(&gate, id, AccessCheck::Dog, true).outcome);
+    TEST_ASSERT_EQUAL(CheckState::Pending, access_gate_check(&gate, id, AccessCheck::Range));
+    TEST_ASSERT_EQUAL(GateOutcome::Open, access_gate_verdict(&gate, id, AccessCheck::Range, true).outcome);
+}
+
+void test_first_failure_cancels(void) {
+    uint32_t id = access_gate_begin(&gate, 0, 0);
+    TEST_ASSERT_EQUAL(GateOutcome::Cancel, access_gate_verdict(&gate, id, AccessCheck::Dog, false).outcome);
+    TEST_ASSERT_EQUAL(GateOutcome::AlreadyCancelled,
+                      access_gate_verdict(&gate, id, AccessCheck::Access, false).outcome);
+    TEST_ASSERT_FALSE(access_gate_opened(&gate, id));
+}
+
+void test_range_still_recorded_after_cancel(void) {
+    uint32_t id = access_gate_begin(&gate, 0, 0);
+    access_gate_verdict(&gate, id, AccessCheck::Dog, false);
+    GateResult r = access_gate_verdict(&gate, id, AccessCheck::Range, true);
+    TEST_ASSERT_EQUAL(GateOutcome::AlreadyCancelled, r.outcome);
+    TEST_ASSERT_EQUAL(CheckState::Passed, access_gate_check(&gate, id, AccessCheck::Range));
+}
+
+void test_late_verdict_after_open(void) {
+    uint32_t id = access_gate_begin(&gate, 0, ACCESS_CHECK_BIT(AccessCheck::Range));
+    access_gate_verdict(&gate, id, AccessCheck::Dog, true);
+    access_gate_verdict(&gate, id, AccessCheck::Access, true);
+    // e.g. the API denying a dog the local table let in
+    GateResult r = access_gate_verdict(&gate, id, AccessCheck::Access, false);
+    TEST_ASSERT_EQUAL(GateOutcome::AlreadyOpen, r.outcome);
+    TEST_ASSERT_TRUE(r.repeated);
+}
+
+void test_repeated_verdict_keeps_the_first(void) {
+    uint32_t id = access_gate_begin(&gate, 0, 0);
+    access_gate_verdict(&gate, id, AccessCheck::Access, true);
+    GateResult r = access_gate_verdict(&gate, id, AccessCheck::Access, false);
+    TEST_ASSERT_EQUAL(GateOutcome::Pending, r.outcome);
+    TEST_ASSERT_TRUE(r.repeated);
+    TEST_ASSERT_EQUAL(CheckState::Passed, access_gate_check(&gate, id, AccessCheck::Access));
+}
+
+void test_overrule_cancels_or_reports_open(void) {
+    uint32_t pending = access_gate_begin(&gate, 0, 0);
+    access_gate_verdict(&gate, pending, AccessCheck::Access, true);
+    TEST_ASSERT_EQUAL(GateOutcome::Cancel, access_gate_overrule(&gate, pending, AccessCheck::Access).outcome);
+    TEST_ASSERT_EQUAL(CheckState::Failed, access_gate_check(&gate, pending, AccessCheck::Access));
+    // The range arriving later no longer opens it
+    access_gate_verdict(&gate, pending, AccessCheck::Dog, true);
+    TEST_ASSERT_EQUAL(GateOutcome::AlreadyCancelled,
+                      access_gate_verdict(&gate, pending, AccessCheck::Range, true).outcome);
+
+    uint32_t open = access_gate_begin(&gate, 0, ACCESS_CHECK_BIT(AccessCheck::Range));
+    access_gate_verdict(&gate, open, AccessCheck::Dog, true);
+    access_gate_verdict(&gate, open, AccessCheck::Access, true);
+    TEST_ASSERT_EQUAL(GateOutcome::AlreadyOpen, access_gate_overrule(&gate, open, AccessCheck::Access).outcome);
+}
+
+void test_unknown_attempt(void) {
+    TEST_ASSERT_EQUAL(GateOutcome::Unknown, access_gate_verdict(&gate, 0, AccessCheck::Dog, true).outcome);
+    TEST_ASSERT_EQUAL(GateOutcome::Unknown, access_gate_verdict(&gate, 99, AccessCheck::Dog, true).outcome);
+    TEST_ASSERT_EQUAL(CheckState::Failed, access_gate_check(&gate, 99, AccessCheck::Range));
+}
+
+void test_full_gate_drops_settled_attempts_first(void) {
+    uint32_t pending = access_gate_begin(&gate, 0, 0);
+    uint32_t settled = access_gate_begin(&gate, 0, 0);
+    access_gate_verdict(&gate, settled, AccessCheck::Dog, false);
+    for (int i = 2; i < ACCESS_GATE_CAPACITY; i++) access_gate_begin(&gate, 0, 0);
+
+    uint32_t newest = access_gate_begin(&gate, 0, 0);
+    TEST_ASSERT_EQUAL(GateOutcome::Unknown, access_gate_verdict(&gate, settled, AccessCheck::Dog, true).outcome);
+    TEST_ASSERT_EQUAL(GateOutcome::Pending, access_gate_verdict(&gate, pending, AccessCheck::Dog, true).outcome);
+
+    // With nothing settled, the oldest goes
+    access_gate_begin(&gate, 0, 0);
+    TEST_ASSERT_EQUAL(GateOutcome::Unknown, access_gate_verdict(&gate, pending, AccessCheck::Range, true).outcome);
+    TEST_ASSERT_EQUAL(GateOutcome::Pending, access_gate_verdict(&gate, newest, AccessCheck::Range, true).outcome);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_confirmed_trigger_opens_on_dog_and_access);
+    RUN_TEST(test_speculative_waits_for_range_whatever_the_order);
+    RUN_TEST(test_first_failure_cancels);
+    RUN_TEST(test_range_still_recorded_after_cancel);
+    RUN_TEST(test_late_verdict_after_open);
+    RUN_TEST(test_repeated_verdict_keeps_the_first);
+    RUN_TEST(test_overrule_cancels_or_reports_open);
+    RUN_TEST(test_unknown_attempt);
+    RUN_TEST(test_full_gate_drops_settled_attempts_first);
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+/*
+ * Host-side tests for the cellular modem's AT line engine.
+ *
+ * Run with: pio test -e native -f test_at_engine
+ */
+
+#include <unity.h>
+#include <string.h>
+
+#include "at_engine.h"
+
+static AtEngine at;
+static char lines[8][AT_LINE_MAX];
+static int lineCount;
+
+static void collect(void*, const char* line) {
+    if (lineCount < 8) strcpy(lines[lineCount], line);
+    lineCount++;
+}
+
+static bool feed(const char* s) {
+    return at_engine_feed(&at, (const uint8_t*)s, strlen(s));
+}
+
+void setUp(void) {
+    at_engine_init(&at, collect, nullptr);
+    lineCount = 0;
+}
+
+void tearDown(void) {}
+
+void test_ok_completes_command_and_info_lines_reach_handler(void) {
+    at_engine_begin(&at, nullptr);
+    TEST_ASSERT_FALSE(feed("AT+CSQ\r\r\n"));  // echo
+    TEST_ASSERT_FALSE(feed("\r\n+CSQ: 17,99\r\n"));
+    TEST_ASSERT_TRUE(at.busy);
+    TEST_ASSERT_TRUE(feed("\r\nOK\r\n"));
+    TEST_ASSERT_FALSE(at.busy);
+    TEST_ASSERT_TRUE(at.result == AtResult::Ok);
+    TEST_ASSERT_EQUAL_INT(1, lineCount);
+    TEST_ASSERT_EQUAL_STRING("+CSQ: 17,99", lines[0]);
+}
+
+void test_errors_complete_with_error(void) {
+    at_engine_begin(&at, nullptr);
+    TEST_ASSERT_TRUE(feed("+CME ERROR: 10\r\n"));
+    TEST_ASSERT_TRUE(at.result == AtResult::Error);
+
+    at_engine_begin(&at, nullptr);
+    TEST_ASSERT_TRUE(feed("ERROR\r\n"));
+    TEST_ASSERT_TRUE(at.result == AtResult::Error);
+}
+
+void test_terminator_completes_command(void) {
+    at_engine_begin(&at, "DOWNLOAD");
+    TEST_ASSERT_TRUE(feed("\r\nDOWNLOAD\r\n"));
+    TEST_ASSERT_TRUE(at.result == AtResult::Ok);
+}
+
+void test_lines_split_across_feeds(void) {
+    at_engine_begin(&at, nullptr);
+    TEST_ASSERT_FALSE(feed("+CR"));
+    TEST_ASSERT_FALSE(feed("EG: 1\r"));
+    TEST_ASSERT_FALSE(feed("\n\r\nO"));
+    TEST_ASSERT_TRUE(feed("K\r\n"));
+    TEST_ASSERT_EQUAL_INT(1, lineCount);
+    TEST_ASSERT_EQUAL_STRING("+CREG: 1", lines[0]);
+}
+
+void test_unsolicited_lines_while_idle(void) {
+    TEST_ASSERT_FALSE(feed("\r\n+HTTPACTION: 1,200,15\r\n\r\nOK\r\n"));
+    // A stray OK with nothing pending is just another line
+    TEST_ASSERT_EQUAL_INT(2, lineCount);
+    TEST_ASSERT_EQUAL_STRING("+HTTPACTION: 1,200,15", lines[0]);
+}
+
+void test_urc_after_final_result_in_same_chunk(void) {
+    at_engine_begin(&at, nullptr);
+    TEST_ASSERT_TRUE(feed("OK\r\n+CREG: 5\r\n"));
+    TEST_ASSERT_EQUAL_INT(1, lineCount);
+    TEST_ASSERT_EQUAL_STRING("+CREG: 5", lines[0]);
+}
+
+void test_overlong_line_is_dropped(void) {
+    char buf[AT_LINE_MAX + 40];
+    memset(buf, 'x', sizeof(buf) - 2);
+    buf[sizeof(buf) - 2] = '\n';
+    buf[sizeof(buf) - 1] = '\0';
+    feed(buf);
+    feed("+CSQ: 5,0\n");
+    TEST_ASSERT_EQUAL_UINT32(1, at.overflows);
+    TEST_ASSERT_EQUAL_INT(1, lineCount);
+    TEST_ASSERT_EQUAL_STRING("+CSQ: 5,0", lines[0]);
+}
+
+void test_parse_ints(void) {
+    int v[3];
+    TEST_ASSERT_EQUAL_INT(3, at_parse_ints("+HTTPACTION: 1,204,0", "+HTTPACTION:", v, 3));
+    TEST_ASSERT_EQUAL_INT(204, v[1]);
+    TEST_ASSERT_EQUAL_INT(2, at_parse_ints("+CREG: 0,5", "+CREG:", v, 3));
+    TEST_ASSERT_EQUAL_INT(5, v[1]);
+    TEST_ASSERT_EQUAL_INT(1, at_parse_ints("+CREG: 2,1,\"1A2B\",\"01C2D3E\",7", "+CREG:", v, 1));
+    TEST_ASSERT_EQUAL_INT(-1, at_parse_ints("+CSQ: 1,2", "+CREG:", v, 3));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ok_completes_command_and_info_lines_reach_handler);
+    RUN_TEST(test_errors_complete_with_error);
+    RUN_TEST(test_terminator_completes_command);
+    RUN_TEST(test_lines_split_across_feeds);
+    RUN_TEST(test_unsolicited_lines_while_idle);
+    RUN_TEST(test_urc_after_final_result_in_same_chunk);
+    RUN_TEST(test_overlong_line_is_dropped);
+    RUN_TEST(test_parse_ints);
+    return UNITY_END();
+}
@@ -0,0 +1,88 @@
+/*
+ * Host-side tests for the edge-interrupt debouncer.
+ *
+ * Run with: pio test -e native -f test_debounce
+ */
+
+#include <unity.h>
+
+#include "debounce.h"
+
+static Debouncer d;
+static uint32_t at;
+
+void setUp(void) {
+    debounce_init(&d, false, 5000);
+    at = 0;
+}
+
+void tearDown(void) {}
+
+void test_idle_reports_nothing(void) {
+    TEST_ASSERT_FALSE(debounce_poll(&d, false, 1000, &at));
+    TEST_ASSERT_EQUAL_UINT32(DEBOUNCE_IDLE, debounce_wait_us(&d, 1000));
+}
+
+void test_bouncing_contact_reports_once_with_first_edge_time(void) {
+    const uint32_t edges[] = {10000, 10300, 10900, 11200, 12000};
+    for (uint32_t e : edges) debounce_edge(&d, e);
+
+    // Still bouncing 4 ms after the last edge
+    TEST_ASSERT_FALSE(debounce_poll(&d, true, 16000, &at));
+    TEST_ASSERT_EQUAL_UINT32(1000, debounce_wait_us(&d, 16000));
+
+    TEST_ASSERT_TRUE(debounce_poll(&d, true, 17000, &at));
+    TEST_ASSERT_EQUAL_UINT32(10000, at);
+    TEST_ASSERT_TRUE(d.stable);
+    TEST_ASSERT_FALSE(debounce_poll(&d, true, 30000, &at));
+}
+
+void test_glitch_back_to_old_level_is_ignored(void) {
+    debounce_edge(&d, 1000);
+    debounce_edge(&d, 1200);
+    TEST_ASSERT_FALSE(debounce_poll(&d, false, 7000, &at));
+    TEST_ASSERT_FALSE(d.pending);
+    TEST_ASSERT_FALSE(d.stable);
+}
+
+void test_zero_settle_reports_on_the_edge(void) {
+    debounce_init(&d, false, 0);
+    debounce_edge(&d, 500);
+    TEST_ASSERT_EQUAL_UINT32(0, debounce_wait_us(&d, 500));
+    TEST_ASSERT_TRUE(debounce_poll(&d, true, 500, &at));
+    TEST_ASSERT_EQUAL_UINT32(500, at);
+}
+
+void test_edge_newer_than_now_is_not_settled(void) {
+    // The ISR can stamp an edge after the dispatcher read the clock
+    debounce_edge(&d, 20000);
+    TEST_ASSERT_FALSE(debounce_poll(&d, true, 19990, &at));
+    TEST_ASSERT_TRUE(d.pending);
+    TEST_ASSERT_TRUE(debounce_poll(&d, true, 25000, &at));
+}
+
+void test_missed_edge_is_resynced_from_level(void) {
+    TEST_ASSERT_FALSE(debounce_poll(&d, true, 40000, &at));
+    TEST_ASSERT_TRUE(d.pending);
+    TEST_ASSERT_TRUE(debounce_poll(&d, true, 45000, &at));
+    TEST_ASSERT_EQUAL_UINT32(40000, at);
+}
+
+void test_timestamps_wrap(void) {
+    debounce_edge(&d, 0xFFFFF000u);
+    TEST_ASSERT_FALSE(debounce_poll(&d, true, 0x00000100u, &at));
+    TEST_ASSERT_TRUE(debounce_poll(&d, true, 0x00001000u, &at));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFF000u, at);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_reports_nothing);
+    RUN_TEST(test_bouncing_contact_reports_once_with_first_edge_time);
+    RUN_TEST(test_glitch_back_to_old_level_is_ignored);
+    RUN_TEST(test_zero_settle_reports_on_the_edge);
+    RUN_TEST(test_edge_newer_than_now_is_not_settled);
+    RUN_TEST(test_missed_edge_is_resynced_from_level);
+    RUN_TEST(test_timestamps_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,88 @@
+/*
+ * Host-side tests for the short-lived access decision cache.
+ *
+ * Run with: pio test -e native -f test_decision_cache
+ */
+
+#include <unity.h>
+
+#include "decision_cache.h"
+
+static DecisionCache cache;
+static DecisionCacheEntry hit;
+
+void setUp(void) {
+    decision_cache_init(&cache, 60000, 6);
+    decision_cache_store(&cache, "inside", 0x00000000FFFFFFFFULL, 1, "Buddy", 1000);
+}
+
+void tearDown(void) {}
+
+void test_similar_frame_on_same_side_hits(void) {
+    TEST_ASSERT_TRUE(decision_cache_lookup(&cache, "inside", 0x000000003FFFFFFFULL, 5000, &hit));
+    TEST_ASSERT_EQUAL_INT(1, hit.animalId);
+    TEST_ASSERT_EQUAL_STRING("Buddy", hit.name);
+}
+
+void test_other_side_misses(void) {
+    TEST_ASSERT_FALSE(decision_cache_lookup(&cache, "outside", 0x00000000FFFFFFFFULL, 5000, &hit));
+}
+
+void test_dissimilar_frame_misses(void) {
+    // 7 bits away, one more than maxDistance
+    TEST_ASSERT_FALSE(decision_cache_lookup(&cache, "inside", 0x0000007FFFFFFFFFULL, 5000, &hit));
+}
+
+void test_entry_expires_after_ttl(void) {
+    TEST_ASSERT_TRUE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 60999, &hit));
+    TEST_ASSERT_FALSE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 61000, &hit));
+}
+
+void test_hit_does_not_extend_ttl(void) {
+    TEST_ASSERT_TRUE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 50000, &hit));
+    TEST_ASSERT_FALSE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 70000, &hit));
+}
+
+void test_store_refreshes_same_animal(void) {
+    decision_cache_store(&cache, "inside", 0xFFFFFFFF00000000ULL, 1, "Buddy", 30000);
+    TEST_ASSERT_FALSE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 31000, &hit));
+    TEST_ASSERT_TRUE(decision_cache_lookup(&cache, "inside", 0xFFFFFFFF00000000ULL, 80000, &hit));
+}
+
+void test_nearest_entry_wins_and_full_cache_evicts_oldest(void) {
+    decision_cache_store(&cache, "inside", 0x00000000FFFFFFF0ULL, 2, "Rex", 2000);
+    TEST_ASSERT_TRUE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFF1ULL, 3000, &hit));
+    TEST_ASSERT_EQUAL_INT(2, hit.animalId);
+
+    for (int id = 3; id <= DECISION_CACHE_CAPACITY + 1; id++) {
+        decision_cache_store(&cache, "inside", (uint64_t)id << 40, id, "Dog", 3000 + id);
+    }
+    // Buddy (stored first) made room for the last one
+    TEST_ASSERT_TRUE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFF0ULL, 9000, &hit));
+    TEST_ASSERT_EQUAL_INT(2, hit.animalId);
+    decision_cache_forget(&cache, 2);
+    TEST_ASSERT_FALSE(decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 9000, &hit));
+}
+
+void test_hit_rate(void) {
+    decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFFULL, 2000, &hit);
+    decision_cache_lookup(&cache, "outside", 0x00000000FFFFFFFFULL, 2000, &hit);
+    decision_cache_lookup(&cache, "inside", 0xFFFFFFFF00000000ULL, 2000, &hit);
+    decision_cache_lookup(&cache, "inside", 0x00000000FFFFFFFEULL, 2000, &hit);
+    TEST_ASSERT_EQUAL_UINT32(4, cache.stats.lookups);
+    TEST_ASSERT_EQUAL_UINT32(2, cache.stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(50, decision_cache_hit_percent(&cache));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_similar_frame_on_same_side_hits);
+    RUN_TEST(test_other_side_misses);
+    RUN_TEST(test_dissimilar_frame_misses);
+    RUN_TEST(test_entry_expires_after_ttl);
+    RUN_TEST(test_hit_does_not_extend_ttl);
+    RUN_TEST(test_store_refreshes_same_animal);
+    RUN_TEST(test_nearest_entry_wins_and_full_cache_evicts_oldest);
+    RUN_TEST(test_hit_rate);
+    return UNITY_END();
+}
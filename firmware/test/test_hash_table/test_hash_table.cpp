@@ -0,0 +1,95 @@
+/*
+ * Host-side tests for local hash-table matching.
+ *
+ * Run with: pio test -e native -f test_hash_table
+ */
+
+#include <unity.h>
+#include <string.h>
+
+#include "hash_table.h"
+
+static HashTable table;
+
+static void add(uint64_t hash, int32_t animalId, bool allowed, const char* name) {
+    HashTableEntry& e = table.entries[table.count++];
+    e.hash = hash;
+    e.animalId = animalId;
+    e.allowed = allowed;
+    strncpy(e.name, name, sizeof(e.name) - 1);
+}
+
+void setUp(void) {
+    hash_table_clear(&table);
+    table.enabled = true;
+    table.maxDistance = 25;  // similarity 0.6
+    add(0x0000000000000000ULL, 1, true, "Buddy");
+    add(0xFFFFFFFF00000000ULL, 2, false, "Stray");
+}
+
+void tearDown(void) {}
+
+void test_empty_table_never_grants(void) {
+    hash_table_clear(&table);
+    LocalMatch m = hash_table_match(&table, 0, 1000);
+    TEST_ASSERT_EQUAL(LocalDecision::Empty, m.decision);
+    TEST_ASSERT_EQUAL_INT(-1, m.index);
+}
+
+void test_nearest_allowed_animal_is_granted(void) {
+    LocalMatch m = hash_table_match(&table, 0x00000000000000FFULL, -1);
+    TEST_ASSERT_EQUAL(LocalDecision::Grant, m.decision);
+    TEST_ASSERT_EQUAL_INT(0, m.index);
+    TEST_ASSERT_EQUAL_INT(8, m.distance);
+}
+
+void test_match_limit_is_inclusive(void) {
+    LocalMatch m = hash_table_match(&table, 0x0000000001FFFFFFULL, -1);  // 25 bits
+    TEST_ASSERT_EQUAL(LocalDecision::Grant, m.decision);
+    m = hash_table_match(&table, 0x0000000003FFFFFFULL, -1);  // 26 bits
+    TEST_ASSERT_EQUAL(LocalDecision::NoMatch, m.decision);
+    TEST_ASSERT_EQUAL_INT(26, m.distance);
+}
+
+void test_nearest_animal_not_allowed(void) {
+    LocalMatch m = hash_table_match(&table, 0xFFFFFFFF0000000FULL, -1);
+    TEST_ASSERT_EQUAL(LocalDecision::NotAllowed, m.decision);
+    TEST_ASSERT_EQUAL_INT(1, m.index);
+}
+
+void test_tie_goes_to_first_entry(void) {
+    add(0x0000000000000000ULL, 3, false, "Twin");
+    LocalMatch m = hash_table_match(&table, 0x1ULL, -1);
+    TEST_ASSERT_EQUAL_INT(0, m.index);
+}
+
+void test_disabled_door(void) {
+    table.enabled = false;
+    TEST_ASSERT_EQUAL(LocalDecision::Disabled, hash_table_match(&table, 0, -1).decision);
+}
+
+void test_night_mode_window(void) {
+    table.nightStartSec = 22 * 3600;
+    table.nightEndSec = 6 * 3600;  // wraps midnight
+    TEST_ASSERT_EQUAL(LocalDecision::TimeUnknown, hash_table_match(&table, 0, -1).decision);
+    TEST_ASSERT_EQUAL(LocalDecision::NightMode, hash_table_match(&table, 0, 23 * 3600).decision);
+    TEST_ASSERT_EQUAL(LocalDecision::NightMode, hash_table_match(&table, 0, 6 * 3600).decision);
+    TEST_ASSERT_EQUAL(LocalDecision::Grant, hash_table_match(&table, 0, 6 * 3600 + 1).decision);
+
+    table.nightStartSec = 1 * 3600;
+    table.nightEndSec = 5 * 3600;
+    TEST_ASSERT_EQUAL(LocalDecision::NightMode, hash_table_match(&table, 0, 3 * 3600).decision);
+    TEST_ASSERT_EQUAL(LocalDecision::Grant, hash_table_match(&table, 0, 23 * 3600).decision);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_table_never_grants);
+    RUN_TEST(test_nearest_allowed_animal_is_granted);
+    RUN_TEST(test_match_limit_is_inclusive);
+    RUN_TEST(test_nearest_animal_not_allowed);
+    RUN_TEST(test_tie_goes_to_first_entry);
+    RUN_TEST(test_disabled_door);
+    RUN_TEST(test_night_mode_window);
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+/*
+ * Host-side tests for the dHash shared with the API.
+ *
+ * Run with: pio test -e native -f test_image_hash
+ */
+
+#include <unity.h>
+#include <string.h>
+
+#include "image_hash.h"
+
+static uint8_t img[60][80];
+
+void setUp(void) {
+    memset(img, 0, sizeof(img));
+}
+
+void tearDown(void) {}
+
+void test_flat_image_hashes_to_zero(void) {
+    memset(img, 128, sizeof(img));
+    TEST_ASSERT_EQUAL_UINT64(0, dhash_gray(&img[0][0], 80, 60));
+}
+
+void test_darkening_left_to_right_sets_every_bit(void) {
+    for (int y = 0; y < 60; y++)
+        for (int x = 0; x < 80; x++) img[y][x] = (uint8_t)(255 - x * 3);
+    TEST_ASSERT_EQUAL_UINT64(~0ULL, dhash_gray(&img[0][0], 80, 60));
+}
+
+void test_bit_layout_is_row_major(void) {
+    // One bright cell at (0, 1) of the 9x8 grid: only bit 1 * 8 + 0 is set
+    int x1 = 80 / 9, y0 = 60 / 8, y1 = 2 * 60 / 8;
+    for (int y = y0; y < y1; y++)
+        for (int x = 0; x < x1; x++) img[y][x] = 200;
+    TEST_ASSERT_EQUAL_UINT64(1ULL << 8, dhash_gray(&img[0][0], 80, 60));
+}
+
+void test_brightness_and_scale_invariant(void) {
+    static uint8_t small[8][9], large[16][18];
+    for (int y = 0; y < 8; y++)
+        for (int x = 0; x < 9; x++) small[y][x] = (uint8_t)((x * 37 + y * 91) % 200);
+    for (int y = 0; y < 16; y++)
+        for (int x = 0; x < 18; x++) large[y][x] = (uint8_t)(small[y / 2][x / 2] + 40);
+    TEST_ASSERT_EQUAL_UINT64(dhash_gray(&small[0][0], 9, 8), dhash_gray(&large[0][0], 18, 16));
+}
+
+void test_too_small_is_zero(void) {
+    memset(img, 200, sizeof(img));
+    TEST_ASSERT_EQUAL_UINT64(0, dhash_gray(&img[0][0], 8, 8));
+    TEST_ASSERT_EQUAL_UINT64(0, dhash_gray(nullptr, 80, 60));
+}
+
+void test_hex_matches_api_format(void) {
+    char hex[DHASH_HEX_LEN + 1];
+    dhash_to_hex(0x00A1B2C3D4E5F607ULL, hex);
+    TEST_ASSERT_EQUAL_STRING("00A1B2C3D4E5F607", hex);
+    dhash_to_hex(0, hex);
+    TEST_ASSERT_EQUAL_STRING("0000000000000000", hex);
+}
+
+// Same pattern and expected value as the API's
+// AnimalRecognitionServiceTests.ComputeDHash_MatchesFirmwareTestVector, so the
+// two implementations can't drift apart
+void test_matches_api_test_vector(void) {
+    static uint8_t rgb[30][40][3];
+    DHashAccumulator acc;
+    TEST_ASSERT_TRUE(dhash_begin(&acc, 40, 30));
+    for (int y = 0; y < 30; y++) {
+        for (int x = 0; x < 40; x++) {
+            rgb[y][x][0] = (uint8_t)(x * 7 + y * 3);
+            rgb[y][x][1] = (uint8_t)(x * x + y);
+            rgb[y][x][2] = (uint8_t)((x ^ y) * 5);
+        }
+        dhash_add_rgb888_row(&acc, y, &rgb[y][0][0]);
+    }
+    char hex[DHASH_HEX_LEN + 1];
+    dhash_to_hex(dhash_finish(&acc), hex);
+    TEST_ASSERT_EQUAL_STRING("786868C848C8C8C8", hex);
+}
+
+void test_rgb565_rows_match_gray(void) {
+    // The gray reference is built from the same widened RGB565 values
+    static uint8_t px565[60][80 * 2];
+    for (int y = 0; y < 60; y++) {
+        for (int x = 0; x < 80; x++) {
+            uint8_t v5 = (uint8_t)((x + y * 3) & 0x1F);
+            uint8_t v8 = (uint8_t)((v5 << 3) | (v5 >> 2));
+            uint8_t g6 = (uint8_t)(v8 >> 2);
+            uint16_t v = (uint16_t)((v5 << 11) | (g6 << 5) | v5);
+            px565[y][2 * x] = (uint8_t)(v >> 8);
+            px565[y][2 * x + 1] = (uint8_t)v;
+            img[y][x] = dhash_luma(v8, (uint8_t)((g6 << 2) | (g6 >> 4)), v8);
+        }
+    }
+    DHashAccumulator acc;
+    dhash_begin(&acc, 80, 60);
+    for (int y = 0; y < 60; y++) dhash_add_rgb565_row(&acc, y, px565[y]);
+    TEST_ASSERT_EQUAL_UINT64(dhash_gray(&img[0][0], 80, 60), dhash_finish(&acc));
+}
+
+void test_distance_and_hex_round_trip(void) {
+    TEST_ASSERT_EQUAL_INT(0, dhash_distance(0x1234, 0x1234));
+    TEST_ASSERT_EQUAL_INT(64, dhash_distance(0, ~0ULL));
+    TEST_ASSERT_EQUAL_INT(3, dhash_distance(0x7, 0x0));
+
+    uint64_t v = 0;
+    TEST_ASSERT_TRUE(dhash_from_hex("00a1B2C3D4E5F607", &v));
+    TEST_ASSERT_EQUAL_UINT64(0x00A1B2C3D4E5F607ULL, v);
+    TEST_ASSERT_FALSE(dhash_from_hex("00A1B2C3D4E5F60", &v));
+    TEST_ASSERT_FALSE(dhash_from_hex("00A1B2C3D4E5F6070", &v));
+    TEST_ASSERT_FALSE(dhash_from_hex("00A1B2C3D4E5F6G7", &v));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_flat_image_hashes_to_zero);
+    RUN_TEST(test_darkening_left_to_right_sets_every_bit);
+    RUN_TEST(test_bit_layout_is_row_major);
+    RUN_TEST(test_brightness_and_scale_invariant);
+    RUN_TEST(test_too_small_is_zero);
+    RUN_TEST(test_hex_matches_api_format);
+    RUN_TEST(test_matches_api_test_vector);
+    RUN_TEST(test_rgb565_rows_match_gray);
+    RUN_TEST(test_distance_and_hex_round_trip);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+/*
+ * Host-side tests for the frame-difference motion prefilter.
+ *
+ * Frames are synthetic QVGA RGB565 scenes (a textured background with an
+ * optional "animal" rectangle), so each test controls exactly what moved.
+ *
+ * Run with: pio test -e native -f test_motion
+ */
+
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "motion_filter.h"
+#include "../test_preprocess/fixture_qvga_gradient.h"
+
+static const int kW = 320;
+static const int kH = 240;
+static uint8_t frame[kW * kH * 2];
+static uint8_t grid[MOTION_GRID_CELLS];
+
+static const MotionFilterConfig kConfig = {
+    20,  // cellThreshold
+    30,  // blockPercent
+    2,   // minChangedBlocks
+    1,   // learnShift
+    3,   // maxConsecutiveRejects
+};
+
+static void put_gray(int x, int y, int v) {
+    if (v < 0) v = 0;
+    if (v > 255) v = 255;
+    uint16_t px = (uint16_t)(((v >> 3) << 11) | ((v >> 2) << 5) | (v >> 3));
+    frame[(y * kW + x) * 2] = px >> 8;
+    frame[(y * kW + x) * 2 + 1] = px & 0xFF;
+}
+
+// Textured scene, optional brightness offset, per-pixel noise and a bright
+// 64x64 object with its top-left corner at (ox, oy) (ox < 0: no object).
+static void render(int brightness, int noise, int ox, int oy) {
+    for (int y = 0; y < kH; y++) {
+        for (int x = 0; x < kW; x++) {
+            int v = 60 + ((x / 16 + y / 16) % 2) * 40 + brightness;
+            if (noise) v += rand() % (2 * noise + 1) - noise;
+            if (ox >= 0 && x >= ox && x < ox + 64 && y >= oy && y < oy + 64) v = 230;
+            put_gray(x, y, v);
+        }
+    }
+}
+
+static MotionResult feed(MotionFilter* f) {
+    motion_grid_from_raw(frame, kW, kH, RawPixelFormat::Rgb565, grid);
+    return motion_filter_update(f, grid);
+}
+
+void setUp(void) {
+    srand(1234);
+}
+
+void tearDown(void) {}
+
+void test_first_frame_passes_and_seeds_background(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 0, -1, 0);
+    TEST_ASSERT_TRUE(feed(&f).moved);
+    TEST_ASSERT_FALSE(feed(&f).moved);
+    TEST_ASSERT_EQUAL_UINT32(2, f.stats.frames);
+    TEST_ASSERT_EQUAL_UINT32(1, f.stats.rejected);
+}
+
+void test_sensor_noise_is_rejected(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 0, -1, 0);
+    feed(&f);
+    render(0, 12, -1, 0);
+    MotionResult r = feed(&f);
+    TEST_ASSERT_FALSE(r.moved);
+    TEST_ASSERT_EQUAL_INT(0, r.changedBlocks);
+}
+
+void test_global_brightness_change_is_rejected(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 0, -1, 0);
+    feed(&f);
+    render(50, 0, -1, 0);
+    TEST_ASSERT_FALSE(feed(&f).moved);
+}
+
+void test_new_object_passes(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 0, -1, 0);
+    feed(&f);
+    render(0, 4, 100, 80);
+    MotionResult r = feed(&f);
+    TEST_ASSERT_TRUE(r.moved);
+    TEST_ASSERT_GREATER_OR_EQUAL(2, r.changedBlocks);
+    TEST_ASSERT_EQUAL_INT(48, r.totalBlocks);
+}
+
+void test_stationary_object_fades_into_background(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 0, -1, 0);
+    feed(&f);
+    render(0, 0, 100, 80);
+    TEST_ASSERT_TRUE(feed(&f).moved);
+
+    // It lies still: after a few frames it is part of the scene
+    bool moved = true;
+    for (int i = 0; i < 4 && moved; i++) moved = feed(&f).moved;
+    TEST_ASSERT_FALSE(moved);
+
+    // ...until it gets up and walks off
+    render(0, 0, 20, 20);
+    TEST_ASSERT_TRUE(feed(&f).moved);
+}
+
+void test_forces_a_frame_through_after_consecutive_rejects(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 0, -1, 0);
+    feed(&f);
+    for (int i = 0; i < kConfig.maxConsecutiveRejects; i++) TEST_ASSERT_FALSE(feed(&f).moved);
+    TEST_ASSERT_TRUE(feed(&f).moved);
+    TEST_ASSERT_EQUAL_UINT32(1, f.stats.forced);
+    TEST_ASSERT_FALSE(feed(&f).moved);
+}
+
+void test_jpeg_grid_matches_gradient(void) {
+    TEST_ASSERT_TRUE(motion_grid_from_jpeg(fixture_qvga_gradient, fixture_qvga_gradient_len, grid));
+    // Luma rises left-to-right (red) and top-to-bottom (green)
+    TEST_ASSERT_TRUE(grid[15 * MOTION_GRID_W + MOTION_GRID_W - 1] > grid[15 * MOTION_GRID_W] + 40);
+    TEST_ASSERT_TRUE(grid[(MOTION_GRID_H - 1) * MOTION_GRID_W + 20] > grid[20] + 80);
+}
+
+void test_raw_grid_rejects_frames_smaller_than_grid(void) {
+    render(0, 0, -1, 0);
+    TEST_ASSERT_TRUE(motion_grid_from_raw(frame, kW, kH, RawPixelFormat::Rgb565, grid));
+    TEST_ASSERT_FALSE(motion_grid_from_raw(frame, 32, 24, RawPixelFormat::Gray8, grid));
+}
+
+void test_runs_in_budget(void) {
+    MotionFilter f;
+    motion_filter_init(&f, kConfig);
+    render(0, 4, 100, 80);
+    clock_t start = clock();
+    for (int i = 0; i < 100; i++) feed(&f);
+    double perFrameMs = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / 100;
+    // Generous on the host; the device budget is a few ms per frame
+    TEST_ASSERT_TRUE(perFrameMs < 5.0);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_passes_and_seeds_background);
+    RUN_TEST(test_sensor_noise_is_rejected);
+    RUN_TEST(test_global_brightness_change_is_rejected);
+    RUN_TEST(test_new_object_passes);
+    RUN_TEST(test_stationary_object_fades_into_background);
+    RUN_TEST(test_forces_a_frame_through_after_consecutive_rejects);
+    RUN_TEST(test_jpeg_grid_matches_gradient);
+    RUN_TEST(test_raw_grid_rejects_frames_smaller_than_grid);
+    RUN_TEST(test_runs_in_budget);
+    return UNITY_END();
+}
@@ -0,0 +1,113 @@
+/*
+ * Host-side tests for the streaming multipart encoder.
+ *
+ * Run with: pio test -e native -f test_multipart
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+
+#include "multipart_writer.h"
+
+struct Recorder {
+    std::string bytes;
+    const uint8_t* filePtrSeen;
+    const uint8_t* file;
+    int writes;
+};
+
+static bool record(void* ctx, const uint8_t* data, size_t len) {
+    Recorder& r = *(Recorder*)ctx;
+    if (data == r.file) r.filePtrSeen = data;
+    r.bytes.append((const char*)data, len);
+    r.writes++;
+    return true;
+}
+
+static bool reject_all(void*, const uint8_t*, size_t) {
+    return false;
+}
+
+static const uint8_t kJpeg[] = {0xFF, 0xD8, 0x00, 0x0D, 0x0A, 0xFF, 0xD9};
+
+void test_matches_legacy_layout() {
+    MultipartBody body;
+    multipart_begin(&body, "image", "capture.jpg", "image/jpeg", kJpeg, sizeof(kJpeg));
+    TEST_ASSERT_TRUE(multipart_add_field(&body, "apiKey", "secret"));
+    TEST_ASSERT_TRUE(multipart_add_field(&body, "side", "inside"));
+
+    Recorder r = {"", nullptr, kJpeg, 0};
+    TEST_ASSERT_TRUE(multipart_write(body, record, &r));
+
+    std::string expected =
+        "--" MULTIPART_BOUNDARY "\r\n"
+        "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n"
+        "Content-Type: image/jpeg\r\n\r\n";
+    expected.append((const char*)kJpeg, sizeof(kJpeg));
+    expected +=
+        "\r\n--" MULTIPART_BOUNDARY "\r\n"
+        "Content-Disposition: form-data; name=\"apiKey\"\r\n\r\nsecret"
+        "\r\n--" MULTIPART_BOUNDARY "\r\n"
+        "Content-Disposition: form-data; name=\"side\"\r\n\r\ninside"
+        "\r\n--" MULTIPART_BOUNDARY "--\r\n";
+    TEST_ASSERT_TRUE(r.bytes == expected);
+    TEST_ASSERT_EQUAL(expected.size(), multipart_content_length(body));
+}
+
+void test_file_is_written_in_place() {
+    MultipartBody body;
+    multipart_begin(&body, "image", "approach.jpg", "image/jpeg", kJpeg, sizeof(kJpeg));
+    multipart_add_field(&body, "side", "outside");
+
+    Recorder r = {"", nullptr, kJpeg, 0};
+    TEST_ASSERT_TRUE(multipart_write(body, record, &r));
+    // Headers, the file itself, then fields + trailer
+    TEST_ASSERT_EQUAL_PTR(kJpeg, r.filePtrSeen);
+    TEST_ASSERT_EQUAL(3, r.writes);
+}
+
+void test_empty_fields_are_skipped() {
+    MultipartBody body;
+    multipart_begin(&body, "image", "capture.jpg", "image/jpeg", kJpeg, sizeof(kJpeg));
+    TEST_ASSERT_TRUE(multipart_add_field(&body, "apiKey", ""));
+    TEST_ASSERT_TRUE(multipart_add_field(&body, "side", nullptr));
+    TEST_ASSERT_EQUAL(0, body.fieldCount);
+
+    for (int i = 0; i < MULTIPART_MAX_FIELDS; i++) {
+        TEST_ASSERT_TRUE(multipart_add_field(&body, "f", "v"));
+    }
+    TEST_ASSERT_FALSE(multipart_add_field(&body, "f", "v"));
+}
+
+void test_content_length_with_large_payload() {
+    static uint8_t big[64 * 1024];
+    memset(big, 0xAB, sizeof(big));
+    std::string longValue(400, 'x');  // larger than the coalescing buffer
+
+    MultipartBody body;
+    multipart_begin(&body, "image", "capture.jpg", "image/jpeg", big, sizeof(big));
+    multipart_add_field(&body, "notes", longValue.c_str());
+
+    Recorder r = {"", nullptr, big, 0};
+    TEST_ASSERT_TRUE(multipart_write(body, record, &r));
+    TEST_ASSERT_EQUAL(r.bytes.size(), multipart_content_length(body));
+}
+
+void test_sink_failure_aborts() {
+    MultipartBody body;
+    multipart_begin(&body, "image", "capture.jpg", "image/jpeg", kJpeg, sizeof(kJpeg));
+    TEST_ASSERT_FALSE(multipart_write(body, reject_all, nullptr));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_matches_legacy_layout);
+    RUN_TEST(test_file_is_written_in_place);
+    RUN_TEST(test_empty_fields_are_skipped);
+    RUN_TEST(test_content_length_with_large_payload);
+    RUN_TEST(test_sink_failure_aborts);
+
+    return UNITY_END();
+}
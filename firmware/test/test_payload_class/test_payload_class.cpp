@@ -0,0 +1,104 @@
+/*
+ * Host-side tests for upload payload class selection.
+ *
+ * Run with: pio test -e native -f test_payload_class
+ */
+
+#include <unity.h>
+
+#include "payload_class.h"
+
+static LinkEstimator est;
+
+// Full from 40 KB/s, Reduced from 10 KB/s, 25% margin to move up
+static const PayloadPolicy kPolicy = {40000, 10000, 25, 60000};
+
+void setUp(void) {
+    link_estimator_init(&est, kPolicy);
+}
+
+void tearDown(void) {}
+
+// `rate` bytes per second, as one 1-second upload
+static void sample(uint32_t rate, uint32_t atMs) {
+    link_estimator_record(&est, rate, 1000000, atMs);
+}
+
+void test_starts_at_initial_class(void) {
+    TEST_ASSERT_EQUAL(PayloadClass::Full, link_estimator_class(&est, 0));
+    link_estimator_reset(&est, PayloadClass::Reduced, PayloadClass::Full);
+    TEST_ASSERT_EQUAL(PayloadClass::Reduced, link_estimator_class(&est, 0));
+}
+
+void test_slow_link_drops_class(void) {
+    sample(20000, 100);
+    TEST_ASSERT_EQUAL(PayloadClass::Reduced, link_estimator_class(&est, 100));
+    TEST_ASSERT_EQUAL_UINT32(20000, est.bytesPerSec);
+
+    // Smoothed: one very slow upload moves the estimate a quarter of the way
+    sample(1000, 200);
+    TEST_ASSERT_EQUAL(PayloadClass::Reduced, link_estimator_class(&est, 200));
+    for (int i = 0; i < 3; i++) sample(1000, 300 + i * 100);
+    TEST_ASSERT_EQUAL(PayloadClass::Thumbnail, link_estimator_class(&est, 700));
+}
+
+void test_climbing_needs_hysteresis_margin(void) {
+    link_estimator_reset(&est, PayloadClass::Thumbnail, PayloadClass::Full);
+    sample(11000, 100);  // above 10 KB/s, but not by 25%
+    TEST_ASSERT_EQUAL(PayloadClass::Thumbnail, link_estimator_class(&est, 100));
+
+    link_estimator_reset(&est, PayloadClass::Thumbnail, PayloadClass::Full);
+    sample(13000, 100);
+    TEST_ASSERT_EQUAL(PayloadClass::Reduced, link_estimator_class(&est, 100));
+
+    // Straight from thumbnail to full on a fast link
+    link_estimator_reset(&est, PayloadClass::Thumbnail, PayloadClass::Full);
+    sample(60000, 100);
+    TEST_ASSERT_EQUAL(PayloadClass::Full, link_estimator_class(&est, 100));
+}
+
+void test_ceiling_caps_class(void) {
+    link_estimator_reset(&est, PayloadClass::Full, PayloadClass::Reduced);
+    TEST_ASSERT_EQUAL(PayloadClass::Reduced, link_estimator_class(&est, 0));
+    sample(500000, 100);
+    TEST_ASSERT_EQUAL(PayloadClass::Reduced, link_estimator_class(&est, 100));
+    // Still free to drop below it
+    for (int i = 0; i < 16; i++) sample(1000, 200 + i * 100);
+    TEST_ASSERT_EQUAL(PayloadClass::Thumbnail, link_estimator_class(&est, 1700));
+}
+
+void test_stale_estimate_reprobes_initial_class(void) {
+    sample(2000, 1000);
+    TEST_ASSERT_EQUAL(PayloadClass::Thumbnail, link_estimator_class(&est, 1000));
+    TEST_ASSERT_EQUAL(PayloadClass::Thumbnail, link_estimator_class(&est, 61000));
+    TEST_ASSERT_EQUAL(PayloadClass::Full, link_estimator_class(&est, 61001));
+
+    // A sample after a long gap replaces the estimate rather than averaging
+    sample(30000, 200000);
+    TEST_ASSERT_EQUAL_UINT32(30000, est.bytesPerSec);
+}
+
+void test_empty_samples_are_ignored(void) {
+    link_estimator_record(&est, 0, 1000, 100);
+    link_estimator_record(&est, 1000, 0, 100);
+    TEST_ASSERT_FALSE(est.valid);
+    TEST_ASSERT_EQUAL_UINT32(0, est.samples);
+}
+
+void test_class_names(void) {
+    TEST_ASSERT_EQUAL_STRING("full", payload_class_name(PayloadClass::Full));
+    TEST_ASSERT_EQUAL_STRING("reduced", payload_class_name(PayloadClass::Reduced));
+    TEST_ASSERT_EQUAL_STRING("thumbnail", payload_class_name(PayloadClass::Thumbnail));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_at_initial_class);
+    RUN_TEST(test_slow_link_drops_class);
+    RUN_TEST(test_climbing_needs_hysteresis_margin);
+    RUN_TEST(test_ceiling_caps_class);
+    RUN_TEST(test_stale_estimate_reprobes_initial_class);
+    RUN_TEST(test_empty_samples_are_ignored);
+    RUN_TEST(test_class_names);
+    return UNITY_END();
+}
@@ -0,0 +1,103 @@
+/*
+ * Host-side tests for the per-event scratch arena.
+ *
+ * Run with: pio test -e native -f test_phase_arena
+ */
+
+#include <unity.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "phase_arena.h"
+
+static uint8_t block[1024 + PHASE_ARENA_ALIGN];
+static PhaseArena arena;
+
+void setUp(void) {
+    phase_arena_init(&arena, block + 1, 1024);  // deliberately misaligned
+}
+
+void tearDown(void) {
+    phase_arena_checkin();
+}
+
+void test_allocations_are_aligned(void) {
+    void* a = phase_arena_alloc(&arena, 3);
+    void* b = phase_arena_alloc(&arena, 5);
+    TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)a % PHASE_ARENA_ALIGN);
+    TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)b % PHASE_ARENA_ALIGN);
+    TEST_ASSERT_EQUAL_UINT32(PHASE_ARENA_ALIGN, (uint8_t*)b - (uint8_t*)a);
+}
+
+void test_reserved_region_survives_checkin(void) {
+    uint8_t* tensors = (uint8_t*)phase_arena_reserve(&arena, 256);
+    TEST_ASSERT_NOT_NULL(tensors);
+    size_t free0 = phase_arena_available(&arena);
+
+    phase_arena_checkout(&arena);
+    TEST_ASSERT_NOT_NULL(scratch_alloc(100));
+    TEST_ASSERT_LESS_THAN(free0, phase_arena_available(&arena));
+    phase_arena_checkin();
+
+    TEST_ASSERT_EQUAL(free0, phase_arena_available(&arena));
+    TEST_ASSERT_EQUAL_UINT32(1, arena.stats.events);
+    // Scratch never lands on the reserved region
+    phase_arena_checkout(&arena);
+    TEST_ASSERT_TRUE((uint8_t*)scratch_alloc(1) >= tensors + 256);
+}
+
+void test_phases_share_the_same_bytes(void) {
+    phase_arena_checkout(&arena);
+    ArenaMark motion = phase_arena_begin(&arena, ArenaPhase::Motion);
+    void* grid = scratch_alloc(200);
+    phase_arena_end(&arena, motion);
+
+    ArenaMark hash = phase_arena_begin(&arena, ArenaPhase::Hash);
+    void* decode = scratch_alloc(500);
+    scratch_alloc(100);
+    phase_arena_end(&arena, hash);
+
+    TEST_ASSERT_EQUAL_PTR(grid, decode);
+    TEST_ASSERT_EQUAL(208, arena.stats.phaseHighWater[(int)ArenaPhase::Motion]);
+    TEST_ASSERT_EQUAL(624, arena.stats.phaseHighWater[(int)ArenaPhase::Hash]);
+    TEST_ASSERT_EQUAL(624, arena.stats.highWater);
+}
+
+void test_full_arena_falls_back_to_heap(void) {
+    phase_arena_checkout(&arena);
+    uint8_t* big = (uint8_t*)scratch_alloc(2000);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL_UINT32(1, arena.stats.fallbacks);
+    memset(big, 0xAA, 2000);
+    scratch_free(big);
+
+    uint8_t* small = (uint8_t*)scratch_calloc(16);
+    TEST_ASSERT_EQUAL_UINT8(0, small[15]);
+    scratch_free(small);  // arena memory: ignored
+    TEST_ASSERT_EQUAL_UINT32(1, arena.stats.fallbacks);
+
+    // Reported once, then not again until it grows
+    TEST_ASSERT_TRUE(phase_arena_grew(&arena));
+    TEST_ASSERT_FALSE(phase_arena_grew(&arena));
+    scratch_free(scratch_alloc(2000));
+    TEST_ASSERT_TRUE(phase_arena_grew(&arena));
+}
+
+void test_no_checkout_uses_heap(void) {
+    size_t before = phase_arena_available(&arena);
+    void* p = scratch_alloc(32);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL(before, phase_arena_available(&arena));
+    scratch_free(p);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_allocations_are_aligned);
+    RUN_TEST(test_reserved_region_survives_checkin);
+    RUN_TEST(test_phases_share_the_same_bytes);
+    RUN_TEST(test_full_arena_falls_back_to_heap);
+    RUN_TEST(test_no_checkout_uses_heap);
+    return UNITY_END();
+}
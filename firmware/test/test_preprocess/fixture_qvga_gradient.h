@@ -0,0 +1,338 @@
+#pragma once
+
+// 320x240 baseline JPEG, 4:2:2 (OV2640 layout), quality 80.
+// R = x * 255 / 319, G = y * 255 / 239, B = 128.
+// Generated with libjpeg (cjpeg-equivalent settings) for host-side decoder tests.
+static const unsigned char fixture_qvga_gradient[] = {
+    0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x06, 0x04, 0x05, 0x06, 0x05, 0x04, 0x06,
+    0x06, 0x05, 0x06, 0x07, 0x07, 0x06, 0x08, 0x0a, 0x10, 0x0a, 0x0a, 0x09, 0x09, 0x0a, 0x14, 0x0e,
+    0x0f, 0x0c, 0x10, 0x17, 0x14, 0x18, 0x18, 0x17, 0x14, 0x16, 0x16, 0x1a, 0x1d, 0x25, 0x1f, 0x1a,
+    0x1b, 0x23, 0x1c, 0x16, 0x16, 0x20, 0x2c, 0x20, 0x23, 0x26, 0x27, 0x29, 0x2a, 0x29, 0x19, 0x1f,
+    0x2d, 0x30, 0x2d, 0x28, 0x30, 0x25, 0x28, 0x29, 0x28, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x07, 0x07,
+    0x07, 0x0a, 0x08, 0x0a, 0x13, 0x0a, 0x0a, 0x13, 0x28, 0x1a, 0x16, 0x1a, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0xff, 0xc0,
+    0x00, 0x11, 0x08, 0x00, 0xf0, 0x01, 0x40, 0x03, 0x01, 0x21, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+    0x01, 0xff, 0xc4, 0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05,
+    0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7d, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23,
+    0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+    0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7,
+    0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5,
+    0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1,
+    0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xc4, 0x00, 0x1f, 0x01, 0x00, 0x03,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00,
+    0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13,
+    0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15,
+    0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27,
+    0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88,
+    0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6,
+    0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4,
+    0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
+    0xfa, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0xf9,
+    0xac, 0x2d, 0x3c, 0x2d, 0x7e, 0x8e, 0xd9, 0xcb, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x66, 0xf1,
+    0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x66, 0xf1, 0x63,
+    0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x74, 0x45, 0x8f, 0x0b, 0x4e, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0,
+    0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x38, 0x2d,
+    0x3c, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x2d, 0x3c,
+    0x2d, 0x43, 0x67, 0x44, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b,
+    0x50, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4,
+    0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0xc2, 0xd4, 0x36,
+    0x74, 0x45, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b,
+    0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x79, 0x10, 0x5a, 0x70, 0x5a, 0xfa, 0xc6,
+    0xcf, 0xe7, 0x08, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5,
+    0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xe1, 0x6a, 0x1b, 0x3a, 0x22, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c,
+    0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xe8,
+    0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b,
+    0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7,
+    0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05,
+    0xa7, 0x85, 0xa9, 0x6c, 0xe8, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x69,
+    0xe1, 0x6a, 0x5b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70,
+    0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a,
+    0x96, 0xce, 0x88, 0xb3, 0xc8, 0xc2, 0xd3, 0x82, 0xd7, 0xd5, 0xb6, 0x7f, 0x37, 0xc5, 0x8f, 0x0b,
+    0x4e, 0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0xc2, 0xd3,
+    0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x67, 0x44, 0x58, 0xe0, 0xb4, 0xf0,
+    0xb5, 0x2d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5,
+    0x0d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43,
+    0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x74, 0x45, 0x8f, 0x0b, 0x4e, 0x0b, 0x50, 0xd9,
+    0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc,
+    0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9d, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0x36, 0x6f, 0x16,
+    0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0x36, 0x74, 0x45, 0x8f,
+    0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9b, 0xc5, 0x9e, 0x44,
+    0x16, 0x9e, 0x16, 0xbe, 0xb1, 0xb3, 0xf9, 0xc2, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x96, 0xce, 0x88,
+    0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1,
+    0xe1, 0x69, 0xc1, 0x2a, 0x1b, 0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xde, 0x2c, 0x78,
+    0x4a, 0x70, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x04, 0xa9, 0x6c, 0xe8, 0x8b, 0x1e, 0x16,
+    0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x37, 0x8b, 0x1c, 0x16, 0x9e,
+    0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85,
+    0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x4a, 0x78, 0x5a, 0x86, 0xce, 0x88, 0xb1, 0xe1, 0x69, 0xc1, 0x6a,
+    0x5b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b,
+    0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x78, 0x5a, 0x96, 0xcd,
+    0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa8, 0x6c, 0xde, 0x2c, 0xf2, 0x20, 0xb4, 0xf0, 0xb5, 0xf5, 0x8d,
+    0x9f, 0xce, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8e, 0x0b, 0x4f, 0x0b, 0x50,
+    0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9,
+    0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f,
+    0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x74, 0x45,
+    0x8f, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8e,
+    0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0x82,
+    0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x67, 0x44, 0x58, 0xf0, 0xb4,
+    0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0,
+    0xb5, 0x2d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x3c, 0x2d,
+    0x4b, 0x66, 0xf1, 0x67, 0x91, 0x04, 0xa7, 0x05, 0xaf, 0xac, 0x6c, 0xfe, 0x70, 0x8b, 0x1e, 0x12,
+    0x9c, 0x12, 0xa1, 0xb3, 0xa2, 0x2c, 0x78, 0x4a, 0x70, 0x4a, 0x96, 0xcd, 0xe2, 0xc7, 0x84, 0xa7,
+    0x04, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x4a, 0x78, 0x4a, 0x96, 0xce, 0x88, 0xb1, 0xc1, 0x29, 0xe1,
+    0x2a, 0x1b, 0x37, 0x8b, 0x1c, 0x12, 0x9e, 0x12, 0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x29, 0xe1, 0x2a,
+    0x1b, 0x3a, 0x22, 0xc7, 0x04, 0xa7, 0x84, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x4a, 0x78, 0x4a, 0x96,
+    0xcd, 0xe2, 0xc7, 0x84, 0xa7, 0x04, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x4a, 0x70, 0x4a, 0x96, 0xce,
+    0x88, 0xb1, 0xe1, 0x29, 0xc1, 0x2a, 0x1b, 0x37, 0x8b, 0x1e, 0x12, 0x9c, 0x12, 0xa5, 0xb3, 0x78,
+    0xb1, 0xe1, 0x69, 0xe1, 0x2a, 0x1b, 0x3a, 0x22, 0xc7, 0x04, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c,
+    0x70, 0x4a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x04, 0xa7, 0x84, 0xa9, 0x6c, 0xe8, 0x8b, 0x1c,
+    0x12, 0x9e, 0x12, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x29, 0xc1, 0x2a, 0x5b, 0x37, 0x8b, 0x3c, 0x88,
+    0x2d, 0x3c, 0x2d, 0x7d, 0x5b, 0x67, 0xf3, 0x84, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5,
+    0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x66, 0xf1, 0x63,
+    0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x67, 0x44, 0x58, 0xf0,
+    0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0xb4,
+    0xf0, 0xb5, 0x2d, 0x9d, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c,
+    0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0x36, 0x74, 0x45, 0x8f, 0x0b, 0x4e, 0x0b,
+    0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x52,
+    0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0xc2, 0xd4, 0x36,
+    0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74,
+    0x45, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x59, 0xe4, 0x41, 0x29, 0xe1, 0x2b, 0xea, 0xdb,
+    0x3f, 0x9c, 0x22, 0xc7, 0x04, 0xa7, 0x84, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x4a, 0x78, 0x4a, 0x86,
+    0xce, 0x88, 0xb1, 0xc1, 0x29, 0xe1, 0x2a, 0x5b, 0x37, 0x8b, 0x1c, 0x12, 0x9e, 0x12, 0xa1, 0xb3,
+    0x78, 0xb1, 0xc1, 0x29, 0xe1, 0x2a, 0x5b, 0x3a, 0x22, 0xc7, 0x84, 0xa7, 0x04, 0xa8, 0x6c, 0xde,
+    0x2c, 0x78, 0x4a, 0x70, 0x4a, 0x96, 0xcd, 0xe2, 0xc7, 0x84, 0xa7, 0x04, 0xa8, 0x6c, 0xe8, 0x8b,
+    0x1e, 0x12, 0x9c, 0x12, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x29, 0xe1, 0x2a, 0x5b, 0x37, 0x8b, 0x1c,
+    0x12, 0x9e, 0x12, 0xa1, 0xb3, 0xa2, 0x2c, 0x70, 0x4a, 0x78, 0x4a, 0x96, 0xcd, 0xe2, 0xc7, 0x04,
+    0xa7, 0x84, 0xa8, 0x6c, 0xde, 0x2c, 0x70, 0x4a, 0x78, 0x4a, 0x96, 0xcd, 0xe2, 0xc7, 0x04, 0xa7,
+    0x84, 0xa8, 0x6c, 0xe8, 0x8b, 0x1e, 0x12, 0x9c, 0x12, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x29, 0xc1,
+    0x2a, 0x1b, 0x37, 0x8b, 0x1e, 0x12, 0x9c, 0x12, 0xa5, 0xb3, 0xa2, 0x2c, 0x78, 0x4a, 0x70, 0x4a,
+    0x86, 0xcd, 0xe2, 0xcf, 0x23, 0x0b, 0x4e, 0x0b, 0x5f, 0x58, 0xd9, 0xfc, 0xe1, 0x16, 0x3c, 0x2d,
+    0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x74, 0x45, 0x8f, 0x0b, 0x4e,
+    0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b,
+    0x52, 0xd9, 0xd1, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4,
+    0xb6, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x67, 0x44, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d,
+    0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9d,
+    0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1,
+    0x63, 0xc2, 0xd3, 0xc2, 0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x67, 0x44, 0x58,
+    0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0,
+    0xb4, 0xe0, 0xb5, 0x2d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16, 0x79, 0x10,
+    0x4a, 0x78, 0x4a, 0xfa, 0xc6, 0xcf, 0xe7, 0x08, 0xb1, 0xc1, 0x69, 0xe1, 0x2a, 0x1b, 0x37, 0x8b,
+    0x1e, 0x12, 0x9c, 0x12, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x29, 0xc1, 0x2a, 0x1b, 0x3a, 0x22, 0xc7,
+    0x84, 0xa7, 0x04, 0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x4a, 0x70, 0x4a, 0x96, 0xcd, 0xe2, 0xc7, 0x84,
+    0xa7, 0x84, 0xa8, 0x6c, 0xe8, 0x8b, 0x1c, 0x12, 0x9e, 0x12, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x29,
+    0xe1, 0x2a, 0x5b, 0x37, 0x8b, 0x1c, 0x12, 0x9e, 0x12, 0xa5, 0xb3, 0xa2, 0x2c, 0x70, 0x4a, 0x78,
+    0x4a, 0x86, 0xcd, 0xe2, 0xc7, 0x04, 0xa7, 0x84, 0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x4a, 0x70, 0x5a,
+    0x86, 0xce, 0x88, 0xb1, 0xe1, 0x29, 0xc1, 0x2a, 0x5b, 0x37, 0x8b, 0x1e, 0x12, 0x9c, 0x12, 0xa1,
+    0xb3, 0x78, 0xb1, 0xe1, 0x29, 0xc1, 0x2a, 0x5b, 0x3a, 0x22, 0xc7, 0x84, 0xa7, 0x84, 0xa8, 0x6c,
+    0xde, 0x2c, 0x70, 0x4a, 0x78, 0x4a, 0x96, 0xcd, 0xe2, 0xc7, 0x04, 0xa7, 0x85, 0xa8, 0x6c, 0xde,
+    0x2c, 0x70, 0x4a, 0x78, 0x4a, 0x96, 0xce, 0x88, 0xb3, 0xc8, 0x82, 0xd3, 0xc2, 0xd7, 0xd6, 0x36,
+    0x7f, 0x38, 0x45, 0x8e, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d,
+    0x9d, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x66,
+    0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x67, 0x44,
+    0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc, 0x58,
+    0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38,
+    0x2d, 0x3c, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8e, 0x0b,
+    0x4f, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f,
+    0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82,
+    0xd4, 0xb6, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x67, 0x44, 0x58, 0xf0, 0xb4, 0xe0, 0xb5,
+    0x2d, 0x9b, 0xc5, 0x9e, 0x46, 0x16, 0x9c, 0x16, 0xbe, 0xad, 0xb3, 0xf9, 0xc2, 0x2c, 0x78, 0x5a,
+    0x70, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x78,
+    0x5a, 0x96, 0xce, 0x88, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16,
+    0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x29, 0xe1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x05, 0xa8,
+    0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c,
+    0xe8, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x37,
+    0x8b, 0x1e, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x3a, 0x22,
+    0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7,
+    0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xe8, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1,
+    0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x12, 0x9c, 0x16, 0xa1, 0xb3, 0xa2, 0x2c, 0xf2, 0x20,
+    0xb4, 0xf0, 0xb5, 0xf5, 0x8d, 0x9f, 0xce, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16,
+    0x38, 0x2d, 0x3c, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8f,
+    0x0b, 0x4e, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b,
+    0x4e, 0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3,
+    0xc2, 0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x67, 0x44, 0x58, 0xe0, 0xb4, 0xf0,
+    0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5,
+    0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b,
+    0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x67,
+    0x44, 0x58, 0xf0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc,
+    0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9d, 0x11, 0x67, 0x91, 0x05, 0xa7, 0x85, 0xaf, 0xac, 0x6c,
+    0xfe, 0x70, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b,
+    0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x3a,
+    0x22, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2,
+    0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xe8, 0x8b, 0x1e, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1,
+    0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x70,
+    0x5a, 0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a,
+    0x70, 0x5a, 0x96, 0xce, 0x88, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x37, 0x8b, 0x1e, 0x16, 0x9c,
+    0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x05,
+    0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa9,
+    0x6c, 0xe8, 0x8b, 0x3c, 0x88, 0x2d, 0x38, 0x2d, 0x7d, 0x63, 0x67, 0xf3, 0x84, 0x58, 0xf0, 0xb4,
+    0xe0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0,
+    0xb5, 0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x38, 0x2d, 0x3c, 0x2d,
+    0x43, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43,
+    0x67, 0x44, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9,
+    0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x6f,
+    0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x74, 0x45,
+    0x8f, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8e,
+    0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82,
+    0xd3, 0xc2, 0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x67, 0x44, 0x59, 0xe4, 0x61,
+    0x69, 0xc1, 0x6b, 0xea, 0xdb, 0x3f, 0x9b, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xe8, 0x8b,
+    0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e,
+    0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7, 0x05,
+    0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7,
+    0x85, 0xa9, 0x6c, 0xe8, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1,
+    0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70, 0x5a,
+    0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x85, 0xa8, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x96,
+    0xce, 0x88, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3,
+    0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x3a, 0x22, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xde,
+    0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86, 0xcd, 0xe2, 0xcf, 0x22, 0x0b, 0x4e, 0x0b, 0x5f, 0x58, 0xd9,
+    0xfc, 0xe1, 0x16, 0x3c, 0x2d, 0x3c, 0x2d, 0x4b, 0x67, 0x44, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d,
+    0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9d,
+    0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x43, 0x66, 0xf1,
+    0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x74, 0x45, 0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc, 0x58,
+    0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0,
+    0xb4, 0xf0, 0xb5, 0x0d, 0x9d, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x2d,
+    0x3c, 0x2d, 0x43, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8e, 0x0b, 0x4f,
+    0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b,
+    0x50, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4,
+    0x36, 0x6f, 0x16, 0x79, 0x18, 0x5a, 0x70, 0x5a, 0xfa, 0xc6, 0xcf, 0xe7, 0x08, 0xb1, 0xe1, 0x69,
+    0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x70, 0x5a, 0x78,
+    0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a,
+    0x96, 0xce, 0x88, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5,
+    0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c,
+    0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x85, 0xa9, 0x6c, 0xe8,
+    0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x37, 0x8b,
+    0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0xa2, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7,
+    0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85,
+    0xa7, 0x05, 0xa8, 0x6c, 0xe8, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb3, 0xc8, 0x82,
+    0xd3, 0xc2, 0xd7, 0xd6, 0x36, 0x7f, 0x38, 0x45, 0x8e, 0x09, 0x4f, 0x0b, 0x50, 0xd9, 0xd1, 0x16,
+    0x3c, 0x2d, 0x38, 0x25, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16, 0x3c,
+    0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x74, 0x45, 0x8f, 0x0b,
+    0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x09, 0x4f,
+    0x0b, 0x52, 0xd9, 0xd1, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2,
+    0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x67, 0x44, 0x58, 0xf0, 0xb4, 0xe0, 0xb5,
+    0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x0d,
+    0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0xb6, 0x6f, 0x16, 0x3c, 0x2d, 0x3c, 0x2d, 0x43, 0x66,
+    0xf1, 0x63, 0x82, 0x53, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8e, 0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc,
+    0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x9e, 0x44, 0x16, 0x9e, 0x16, 0xbe, 0xad, 0xb3,
+    0xf9, 0xc2, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa8, 0x6c,
+    0xe8, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37,
+    0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2,
+    0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7,
+    0x05, 0xa7, 0x85, 0xa8, 0x6c, 0xe8, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xc1,
+    0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x78, 0x5a,
+    0x70, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70,
+    0x5a, 0x86, 0xce, 0x88, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16,
+    0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xe1, 0x6a, 0x1b, 0x3a, 0x22, 0xc7, 0x05, 0xa7, 0x85, 0xa9,
+    0x6c, 0xde, 0x2c, 0xf2, 0x20, 0x94, 0xe0, 0x95, 0xf5, 0x6d, 0x9f, 0xce, 0x11, 0x63, 0xc2, 0x53,
+    0x82, 0x54, 0xb6, 0x6f, 0x16, 0x3c, 0x25, 0x38, 0x25, 0x43, 0x67, 0x44, 0x58, 0xf0, 0x94, 0xf0,
+    0x95, 0x2d, 0x9b, 0xc5, 0x8e, 0x09, 0x4f, 0x09, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0x94, 0xf0, 0x95,
+    0x2d, 0x9b, 0xc5, 0x8e, 0x09, 0x4f, 0x09, 0x52, 0xd9, 0xd1, 0x16, 0x3c, 0x25, 0x38, 0x25, 0x43,
+    0x66, 0xf1, 0x63, 0xc2, 0x53, 0x82, 0x54, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x25, 0x4b, 0x67,
+    0x44, 0x58, 0xf0, 0x94, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x09, 0x4e, 0x0b, 0x50, 0xd9, 0xbc,
+    0x58, 0xf0, 0x94, 0xf0, 0x95, 0x2d, 0x9d, 0x11, 0x63, 0x82, 0x53, 0xc2, 0x54, 0x36, 0x6f, 0x16,
+    0x38, 0x25, 0x3c, 0x25, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0x53, 0xc2, 0x54, 0x36, 0x74, 0x45, 0x8e,
+    0x09, 0x4f, 0x09, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0x94, 0xe0, 0x95, 0x0d, 0x9b, 0xc5, 0x8f, 0x09,
+    0x4e, 0x09, 0x52, 0xd9, 0xd1, 0x16, 0x3c, 0x25, 0x38, 0x25, 0x43, 0x66, 0xf1, 0x67, 0x91, 0x85,
+    0xa7, 0x05, 0xaf, 0xac, 0x6c, 0xfe, 0x70, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1,
+    0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x78,
+    0x5a, 0x70, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a,
+    0x78, 0x5a, 0x86, 0xce, 0x88, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x37, 0x8b, 0x1c, 0x16, 0x9e,
+    0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x05,
+    0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8,
+    0x6c, 0xe8, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xe1, 0x6a, 0x1b,
+    0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd,
+    0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x96, 0xce, 0x88,
+    0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x3c, 0x88, 0x25, 0x3c, 0x25, 0x7d, 0x63, 0x67,
+    0xf3, 0x84, 0x58, 0xe0, 0x94, 0xf0, 0x95, 0x0d, 0x9b, 0xc5, 0x8e, 0x09, 0x4f, 0x09, 0x52, 0xd9,
+    0xbc, 0x58, 0xe0, 0x94, 0xf0, 0x95, 0x0d, 0x9d, 0x11, 0x63, 0xc2, 0x53, 0x82, 0x54, 0xb6, 0x6f,
+    0x16, 0x3c, 0x25, 0x38, 0x25, 0x43, 0x66, 0xf1, 0x63, 0xc2, 0x53, 0x82, 0x54, 0xb6, 0x74, 0x45,
+    0x8f, 0x09, 0x4e, 0x09, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0x94, 0xf0, 0x95, 0x0d, 0x9b, 0xc5, 0x8e,
+    0x09, 0x4f, 0x09, 0x52, 0xd9, 0xd1, 0x16, 0x38, 0x25, 0x3c, 0x25, 0x43, 0x66, 0xf1, 0x63, 0x82,
+    0x53, 0xc2, 0x54, 0xb6, 0x6f, 0x16, 0x38, 0x25, 0x3c, 0x25, 0x43, 0x67, 0x44, 0x58, 0xe0, 0x94,
+    0xf0, 0x95, 0x2d, 0x9b, 0xc5, 0x8f, 0x09, 0x4e, 0x09, 0x50, 0xd9, 0xbc, 0x58, 0xf0, 0x94, 0xe0,
+    0x95, 0x2d, 0x9b, 0xc5, 0x8f, 0x09, 0x4e, 0x09, 0x50, 0xd9, 0xd1, 0x16, 0x3c, 0x25, 0x38, 0x25,
+    0x4b, 0x66, 0xf1, 0x63, 0xc2, 0x53, 0xc2, 0x54, 0x36, 0x6f, 0x16, 0x38, 0x25, 0x3c, 0x25, 0x4b,
+    0x67, 0x44, 0x59, 0xe4, 0x41, 0x69, 0xc1, 0x6b, 0xeb, 0x1b, 0x3f, 0x9c, 0x22, 0xc7, 0x85, 0xa7,
+    0x05, 0xa8, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85,
+    0xa8, 0x6c, 0xe8, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a,
+    0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86,
+    0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86, 0xce,
+    0x88, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78,
+    0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c,
+    0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xe8, 0x8b, 0x1c,
+    0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x16,
+    0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x3a, 0x22, 0xcf, 0x23, 0x0b,
+    0x4e, 0x09, 0x5f, 0x56, 0xd9, 0xfc, 0xe1, 0x16, 0x3c, 0x25, 0x38, 0x25, 0x4b, 0x66, 0xf1, 0x63,
+    0xc2, 0x53, 0x82, 0x54, 0x36, 0x6f, 0x16, 0x3c, 0x25, 0x38, 0x25, 0x4b, 0x67, 0x44, 0x58, 0xf0,
+    0x94, 0xf0, 0x95, 0x0d, 0x9b, 0xc5, 0x8e, 0x09, 0x4f, 0x09, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0x94,
+    0xf0, 0x95, 0x0d, 0x9d, 0x11, 0x63, 0x82, 0x53, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x25, 0x3c,
+    0x25, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0x53, 0xc2, 0x54, 0x36, 0x6f, 0x16, 0x3c, 0x25, 0x38, 0x25,
+    0x4b, 0x67, 0x44, 0x58, 0xf0, 0x94, 0xe0, 0x95, 0x0d, 0x9b, 0xc5, 0x8f, 0x09, 0x4e, 0x09, 0x52,
+    0xd9, 0xbc, 0x58, 0xf0, 0x94, 0xe0, 0xb5, 0x0d, 0x9d, 0x11, 0x63, 0xc2, 0x53, 0xc2, 0x54, 0xb6,
+    0x6f, 0x16, 0x38, 0x25, 0x3c, 0x25, 0x43, 0x66, 0xf1, 0x63, 0x82, 0x53, 0xc2, 0x54, 0xb6, 0x74,
+    0x45, 0x8e, 0x09, 0x4f, 0x09, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0x94, 0xf0, 0x95, 0x2d, 0x9b, 0xc5,
+    0x8f, 0x09, 0x4e, 0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x79, 0x10, 0x5a, 0x78, 0x5a, 0xfa, 0xc6, 0xcf,
+    0xe7, 0x08, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3,
+    0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0xa2,
+    0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xde, 0x2c,
+    0x78, 0x5a, 0x70, 0x5a, 0x96, 0xce, 0x88, 0xb1, 0xe1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c,
+    0x16, 0x9e, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x3a, 0x22, 0xc7, 0x05,
+    0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7,
+    0x85, 0xa9, 0x6c, 0xe8, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1,
+    0x6a, 0x1b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70, 0x5a,
+    0x86, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86,
+    0xce, 0x88, 0xb3, 0xc8, 0x82, 0xd3, 0xc2, 0xd7, 0xd6, 0x36, 0x7f, 0x37, 0xc5, 0x8e, 0x09, 0x4f,
+    0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2,
+    0xd4, 0x36, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x4b, 0x67, 0x44, 0x58, 0xe0, 0xb4, 0xf0, 0xb5,
+    0x0d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d,
+    0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66,
+    0xf1, 0x63, 0xc2, 0xd3, 0xc2, 0xd4, 0x36, 0x74, 0x45, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc,
+    0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58,
+    0xe0, 0x94, 0xf0, 0xb5, 0x0d, 0x9d, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x3c,
+    0x2d, 0x38, 0x25, 0x43, 0x67, 0x44, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b,
+    0x4e, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x9e, 0x44, 0x16,
+    0x9e, 0x16, 0xbe, 0xb1, 0xb3, 0xf9, 0xc2, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86, 0xce, 0x88, 0xb1,
+    0xe1, 0x69, 0xc1, 0x6a, 0x5b, 0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1,
+    0x69, 0xc1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7, 0x85, 0xa7, 0x85, 0xa8, 0x6c, 0xde, 0x2c, 0x70, 0x5a,
+    0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85, 0xa8, 0x6c, 0xe8, 0x8b, 0x1c, 0x16, 0x9e,
+    0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16,
+    0xa5, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8,
+    0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c,
+    0xe8, 0x8b, 0x1e, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xc1, 0x69, 0xe1, 0x6a, 0x1b, 0x37,
+    0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2,
+    0xc7, 0x05, 0xa7, 0x85, 0xa9, 0x6c, 0xde, 0x2c, 0xf2, 0x20, 0xb4, 0xf0, 0xb5, 0xf5, 0x6d, 0x9f,
+    0xce, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8f, 0x0b, 0x4e, 0x0b, 0x50, 0xd9,
+    0xbc, 0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b, 0x4e, 0x0b, 0x52, 0xd9, 0xbc,
+    0x58, 0xf0, 0xb4, 0xe0, 0xb5, 0x0d, 0x9d, 0x11, 0x63, 0xc2, 0xd3, 0x82, 0xd4, 0x36, 0x6f, 0x16,
+    0x3c, 0x2d, 0x3c, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x74, 0x45, 0x8e,
+    0x0b, 0x4f, 0x0b, 0x50, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5, 0x2d, 0x9b, 0xc5, 0x8f, 0x0b,
+    0x4e, 0x0b, 0x50, 0xd9, 0xd1, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x66, 0xf1, 0x63, 0xc2, 0xd3,
+    0x82, 0xd4, 0x36, 0x6f, 0x16, 0x3c, 0x2d, 0x38, 0x2d, 0x4b, 0x67, 0x44, 0x58, 0xf0, 0xb4, 0xf0,
+    0xb5, 0x0d, 0x9b, 0xc5, 0x8e, 0x0b, 0x4f, 0x0b, 0x52, 0xd9, 0xbc, 0x58, 0xe0, 0xb4, 0xf0, 0xb5,
+    0x0d, 0x9d, 0x11, 0x63, 0x82, 0xd3, 0xc2, 0xd4, 0xb6, 0x6f, 0x16, 0x38, 0x2d, 0x3c, 0x2d, 0x43,
+    0x66, 0xf1, 0x67, 0x91, 0x05, 0xa7, 0x05, 0xaf, 0xac, 0x6c, 0xfe, 0x70, 0x8b, 0x1e, 0x16, 0x9c,
+    0x16, 0xa5, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x78, 0x5a, 0x86, 0xcd, 0xe2, 0xc7, 0x05, 0xa7, 0x85,
+    0xa9, 0x6c, 0xde, 0x2c, 0x70, 0x5a, 0x78, 0x5a, 0x86, 0xce, 0x88, 0xb1, 0xc1, 0x69, 0xe1, 0x6a,
+    0x5b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x5b,
+    0x37, 0x8b, 0x1e, 0x16, 0x9c, 0x16, 0xa1, 0xb3, 0xa2, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x96, 0xcd,
+    0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa9, 0x6c, 0xde, 0x2c, 0x78, 0x5a, 0x70, 0x5a, 0x86, 0xce, 0x88,
+    0xb1, 0xe1, 0x69, 0xe1, 0x6a, 0x5b, 0x37, 0x8b, 0x1c, 0x16, 0x9e, 0x16, 0xa1, 0xb3, 0x78, 0xb1,
+    0xc1, 0x69, 0xe1, 0x6a, 0x5b, 0x3a, 0x22, 0xc7, 0x05, 0xa7, 0x85, 0xa8, 0x6c, 0xde, 0x2c, 0x70,
+    0x5a, 0x78, 0x5a, 0x96, 0xcd, 0xe2, 0xc7, 0x85, 0xa7, 0x05, 0xa8, 0x6c, 0xe8, 0x8b, 0x1e, 0x16,
+    0x9c, 0x16, 0xa5, 0xb3, 0x78, 0xb1, 0xe1, 0x69, 0xc1, 0x6a, 0x1b, 0x37, 0x8b, 0x3f, 0xff, 0xd9,
+};
+
+static const unsigned int fixture_qvga_gradient_len = sizeof(fixture_qvga_gradient);
@@ -0,0 +1,270 @@
+/*
+ * Host-side tests for the JPEG decode + resize preprocessing stage.
+ *
+ * The fixture is a synthetic gradient whose exact pixel values are known,
+ * so decoded output is checked against the generating formula rather than
+ * against another decoder.
+ *
+ * Run with: pio test -e native -f test_preprocess
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jpeg_decoder.h"
+#include "image_preprocess.h"
+#include "phase_arena.h"
+#include "fixture_qvga_gradient.h"
+
+static const int kSrcW = 320;
+static const int kSrcH = 240;
+
+struct Capture {
+    uint8_t* pixels;
+    int width;
+    int rowsSeen;
+    int bpp;
+};
+
+static bool capture_band(void* ctx, int y, int width, int rows, const uint8_t* pixels) {
+    Capture& c = *(Capture*)ctx;
+    c.width = width;
+    memcpy(c.pixels + (size_t)y * width * c.bpp, pixels, (size_t)rows * width * c.bpp);
+    c.rowsSeen += rows;
+    return true;
+}
+
+static bool abort_band(void*, int, int, int, const uint8_t*) {
+    return false;
+}
+
+void test_pick_scale() {
+    TEST_ASSERT_EQUAL(2, preprocess_pick_scale(320, 240, 96, 96));  // QVGA -> 160x120
+    TEST_ASSERT_EQUAL(1, preprocess_pick_scale(160, 120, 96, 96));  // QQVGA
+    TEST_ASSERT_EQUAL(4, preprocess_pick_scale(640, 480, 96, 96));  // VGA -> 160x120
+    TEST_ASSERT_EQUAL(8, preprocess_pick_scale(800, 800, 96, 96));
+}
+
+void test_read_info() {
+    JpegInfo info;
+    TEST_ASSERT_TRUE(jpeg_read_info(fixture_qvga_gradient, fixture_qvga_gradient_len, &info));
+    TEST_ASSERT_EQUAL(kSrcW, info.width);
+    TEST_ASSERT_EQUAL(kSrcH, info.height);
+    TEST_ASSERT_EQUAL(3, info.components);
+}
+
+void test_scaled_decode_matches_reference() {
+    const int scales[] = {1, 2, 4, 8};
+    for (int scale : scales) {
+        int w = kSrcW / scale;
+        int h = kSrcH / scale;
+        Capture c = {(uint8_t*)calloc(w * h * 3, 1), 0, 0, 3};
+        TEST_ASSERT_TRUE_MESSAGE(
+            jpeg_decode_scaled(fixture_qvga_gradient, fixture_qvga_gradient_len, scale,
+                               JpegPixelFormat::Rgb888, capture_band, &c),
+            jpeg_last_error());
+        TEST_ASSERT_EQUAL(w, c.width);
+        TEST_ASSERT_EQUAL(h, c.rowsSeen);
+
+        // Each output pixel approximates the mean of its scale x scale source block.
+        int worst = 0;
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                float sx = (x + 0.5f) * scale - 0.5f;
+                float sy = (y + 0.5f) * scale - 0.5f;
+                int expected[3] = {(int)(sx * 255 / 319 + 0.5f), (int)(sy * 255 / 239 + 0.5f), 128};
+                for (int ch = 0; ch < 3; ch++) {
+                    int diff = abs(c.pixels[(y * w + x) * 3 + ch] - expected[ch]);
+                    if (diff > worst) worst = diff;
+                }
+            }
+        }
+        free(c.pixels);
+        char msg[48];
+        snprintf(msg, sizeof(msg), "scale 1/%d max error %d", scale, worst);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(8, worst, msg);
+    }
+}
+
+void test_gray_decode() {
+    int w = kSrcW / 2;
+    int h = kSrcH / 2;
+    Capture c = {(uint8_t*)calloc(w * h, 1), 0, 0, 1};
+    TEST_ASSERT_TRUE(jpeg_decode_scaled(fixture_qvga_gradient, fixture_qvga_gradient_len, 2,
+                                        JpegPixelFormat::Gray8, capture_band, &c));
+    TEST_ASSERT_EQUAL(h, c.rowsSeen);
+    // Luma rises left-to-right (red) and top-to-bottom (green).
+    TEST_ASSERT_TRUE(c.pixels[(h / 2) * w + w - 1] > c.pixels[(h / 2) * w]);
+    TEST_ASSERT_TRUE(c.pixels[(h - 1) * w + w / 2] > c.pixels[w / 2]);
+    free(c.pixels);
+}
+
+void test_preprocess_to_model_input() {
+    static uint8_t dst[96 * 96 * 3];
+    PreprocessStats stats;
+    TEST_ASSERT_TRUE(preprocess_jpeg_to_rgb(fixture_qvga_gradient, fixture_qvga_gradient_len,
+                                            dst, 96, 96, &stats));
+    TEST_ASSERT_EQUAL(2, stats.scaleDenom);
+    TEST_ASSERT_EQUAL(kSrcW, stats.srcWidth);
+
+    int worst = 0;
+    for (int y = 0; y < 96; y++) {
+        for (int x = 0; x < 96; x++) {
+            float sx = (x + 0.5f) * kSrcW / 96 - 0.5f;
+            float sy = (y + 0.5f) * kSrcH / 96 - 0.5f;
+            int expected[3] = {(int)(sx * 255 / 319 + 0.5f), (int)(sy * 255 / 239 + 0.5f), 128};
+            for (int ch = 0; ch < 3; ch++) {
+                int diff = abs(dst[(y * 96 + x) * 3 + ch] - expected[ch]);
+                if (diff > worst) worst = diff;
+            }
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(8, worst);
+}
+
+void test_preprocess_in_phase_arena() {
+    static uint8_t block[48 * 1024];
+    static uint8_t heapDst[96 * 96 * 3];
+    static uint8_t arenaDst[96 * 96 * 3];
+    PhaseArena arena;
+    phase_arena_init(&arena, block, sizeof(block));
+    TEST_ASSERT_TRUE(preprocess_jpeg_to_rgb(fixture_qvga_gradient, fixture_qvga_gradient_len,
+                                            heapDst, 96, 96, nullptr));
+
+    phase_arena_checkout(&arena);
+    ArenaMark mark = phase_arena_begin(&arena, ArenaPhase::Preprocess);
+    TEST_ASSERT_TRUE(preprocess_jpeg_to_rgb(fixture_qvga_gradient, fixture_qvga_gradient_len,
+                                            arenaDst, 96, 96, nullptr));
+    phase_arena_end(&arena, mark);
+    phase_arena_checkin();
+
+    TEST_ASSERT_EQUAL_MEMORY(heapDst, arenaDst, sizeof(heapDst));
+    TEST_ASSERT_EQUAL_UINT32(0, arena.stats.fallbacks);
+    TEST_ASSERT_GREATER_THAN(0, arena.stats.phaseHighWater[(int)ArenaPhase::Preprocess]);
+    char msg[64];
+    snprintf(msg, sizeof(msg), "QVGA -> 96x96 scratch: %u bytes",
+             (unsigned)arena.stats.phaseHighWater[(int)ArenaPhase::Preprocess]);
+    TEST_MESSAGE(msg);
+}
+
+void test_raw_rgb565_to_model_input() {
+    // Same gradient as the JPEG fixture, packed big-endian RGB565
+    static uint8_t frame[kSrcW * kSrcH * 2];
+    for (int y = 0; y < kSrcH; y++) {
+        for (int x = 0; x < kSrcW; x++) {
+            uint16_t r = x * 255 / 319, g = y * 255 / 239, b = 128;
+            uint16_t px = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+            frame[(y * kSrcW + x) * 2] = px >> 8;
+            frame[(y * kSrcW + x) * 2 + 1] = px & 0xFF;
+        }
+    }
+    static uint8_t dst[96 * 96 * 3];
+    PreprocessStats stats;
+    TEST_ASSERT_TRUE(preprocess_raw_to_rgb(frame, kSrcW, kSrcH, RawPixelFormat::Rgb565,
+                                           dst, 96, 96, &stats));
+    TEST_ASSERT_EQUAL(1, stats.scaleDenom);
+
+    int worst = 0;
+    for (int y = 0; y < 96; y++) {
+        for (int x = 0; x < 96; x++) {
+            float sx = (x + 0.5f) * kSrcW / 96 - 0.5f;
+            float sy = (y + 0.5f) * kSrcH / 96 - 0.5f;
+            int expected[3] = {(int)(sx * 255 / 319 + 0.5f), (int)(sy * 255 / 239 + 0.5f), 128};
+            for (int ch = 0; ch < 3; ch++) {
+                int diff = abs(dst[(y * 96 + x) * 3 + ch] - expected[ch]);
+                if (diff > worst) worst = diff;
+            }
+        }
+    }
+    // RGB565 quantization alone costs up to 7 levels in red/blue
+    TEST_ASSERT_LESS_OR_EQUAL(9, worst);
+}
+
+void test_rejects_invalid_input() {
+    static uint8_t dst[96 * 96 * 3];
+    const uint8_t garbage[] = {0x00, 0x11, 0x22, 0x33, 0x44};
+    TEST_ASSERT_FALSE(preprocess_jpeg_to_rgb(garbage, sizeof(garbage), dst, 96, 96, nullptr));
+    TEST_ASSERT_FALSE(preprocess_jpeg_to_rgb(fixture_qvga_gradient, 200, dst, 96, 96, nullptr));
+    // Upscaling is not supported
+    TEST_ASSERT_FALSE(preprocess_jpeg_to_rgb(fixture_qvga_gradient, fixture_qvga_gradient_len,
+                                             dst, 400, 96, nullptr));
+    TEST_ASSERT_FALSE(jpeg_decode_scaled(fixture_qvga_gradient, fixture_qvga_gradient_len, 3,
+                                         JpegPixelFormat::Rgb888, abort_band, nullptr));
+    TEST_ASSERT_FALSE(jpeg_decode_scaled(fixture_qvga_gradient, fixture_qvga_gradient_len, 2,
+                                         JpegPixelFormat::Rgb888, abort_band, nullptr));
+}
+
+void test_rejects_empty_sos_segment() {
+    // The fixture's headers, then an SOS segment with no room for its
+    // component count, ending the buffer
+    size_t sos = 2;
+    while (sos + 1 < fixture_qvga_gradient_len &&
+           !(fixture_qvga_gradient[sos] == 0xFF && fixture_qvga_gradient[sos + 1] == 0xDA)) {
+        sos++;
+    }
+    TEST_ASSERT_TRUE(sos + 1 < fixture_qvga_gradient_len);
+    uint8_t* jpeg = (uint8_t*)malloc(sos + 4);
+    memcpy(jpeg, fixture_qvga_gradient, sos + 2);
+    jpeg[sos + 2] = 0x00;
+    jpeg[sos + 3] = 0x02;
+    TEST_ASSERT_FALSE(jpeg_decode_scaled(jpeg, sos + 4, 1, JpegPixelFormat::Rgb888, abort_band, nullptr));
+    free(jpeg);
+}
+
+void test_rejects_oversubscribed_huffman_table() {
+    // Move every code of the first DHT table to length 1: same value count,
+    // but more codes than one bit can hold
+    uint8_t* jpeg = (uint8_t*)malloc(fixture_qvga_gradient_len);
+    memcpy(jpeg, fixture_qvga_gradient, fixture_qvga_gradient_len);
+    size_t dht = 2;
+    while (dht + 1 < fixture_qvga_gradient_len && !(jpeg[dht] == 0xFF && jpeg[dht + 1] == 0xC4)) dht++;
+    TEST_ASSERT_TRUE(dht + 21 < fixture_qvga_gradient_len);
+    uint8_t* counts = jpeg + dht + 5;
+    for (int i = 1; i < 16; i++) {
+        counts[0] += counts[i];
+        counts[i] = 0;
+    }
+    TEST_ASSERT_GREATER_THAN(2, counts[0]);
+    TEST_ASSERT_FALSE(jpeg_decode_scaled(jpeg, fixture_qvga_gradient_len, 1, JpegPixelFormat::Rgb888,
+                                         abort_band, nullptr));
+    free(jpeg);
+}
+
+// Not a pass/fail check: reports host decode+resize time per frame so
+// changes to the decoder can be compared. On-device numbers are logged by
+// detection_run().
+void test_benchmark_decode_resize() {
+    static uint8_t dst[96 * 96 * 3];
+    const int iterations = 50;
+    uint64_t totalUs = 0;
+    PreprocessStats stats;
+    for (int i = 0; i < iterations; i++) {
+        TEST_ASSERT_TRUE(preprocess_jpeg_to_rgb(fixture_qvga_gradient, fixture_qvga_gradient_len,
+                                                dst, 96, 96, &stats));
+        totalUs += stats.totalUs;
+    }
+    char msg[64];
+    snprintf(msg, sizeof(msg), "QVGA -> 96x96 decode+resize: %u us/frame",
+             (unsigned)(totalUs / iterations));
+    TEST_MESSAGE(msg);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pick_scale);
+    RUN_TEST(test_read_info);
+    RUN_TEST(test_scaled_decode_matches_reference);
+    RUN_TEST(test_gray_decode);
+    RUN_TEST(test_preprocess_to_model_input);
+    RUN_TEST(test_preprocess_in_phase_arena);
+    RUN_TEST(test_raw_rgb565_to_model_input);
+    RUN_TEST(test_rejects_invalid_input);
+    RUN_TEST(test_rejects_empty_sos_segment);
+    RUN_TEST(test_rejects_oversubscribed_huffman_table);
+    RUN_TEST(test_benchmark_decode_resize);
+
+    return UNITY_END();
+}
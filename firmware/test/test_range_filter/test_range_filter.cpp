@@ -0,0 +1,84 @@
+/*
+ * Host-side tests for the ultrasonic range filter.
+ *
+ * Run with: pio test -e native -f test_range_filter
+ */
+
+#include <unity.h>
+
+#include "range_filter.h"
+
+static RangeFilter filter;
+
+void setUp(void) {
+    range_filter_init(&filter, 15.0f, 400, 3);
+}
+
+void tearDown(void) {}
+
+void test_no_samples_is_invalid(void) {
+    RangeEstimate est = range_filter_estimate(&filter, 1000);
+    TEST_ASSERT_FALSE(est.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -1.0f, est.distanceCm);
+}
+
+void test_steady_target_reports_median(void) {
+    const float cm[] = {40.2f, 39.8f, 40.0f, 40.4f, 39.6f};
+    for (int i = 0; i < 5; i++) range_filter_push(&filter, 1000 + i * 60, cm[i]);
+    RangeEstimate est = range_filter_estimate(&filter, 1240);
+    TEST_ASSERT_TRUE(est.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, est.distanceCm);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 0.0f, est.velocityCmS);
+}
+
+void test_single_bad_echo_is_rejected(void) {
+    // A stray close reflection in a clear scene must not look like an animal
+    const float cm[] = {180.0f, 181.0f, 12.0f, 179.0f, 180.5f};
+    for (int i = 0; i < 5; i++) range_filter_push(&filter, 1000 + i * 60, cm[i]);
+    RangeEstimate est = range_filter_estimate(&filter, 1240);
+    TEST_ASSERT_TRUE(est.valid);
+    TEST_ASSERT_EQUAL_UINT8(4, est.samplesUsed);
+    TEST_ASSERT_TRUE(est.distanceCm > 170.0f);
+}
+
+void test_approach_velocity(void) {
+    // 50 cm/s towards the sensor
+    for (int i = 0; i < 6; i++) range_filter_push(&filter, 1000 + i * 60, 100.0f - 3.0f * i);
+    RangeEstimate est = range_filter_estimate(&filter, 1300);
+    TEST_ASSERT_TRUE(est.valid);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, -50.0f, est.velocityCmS);
+}
+
+void test_missing_echoes_and_stale_samples_are_ignored(void) {
+    range_filter_push(&filter, 0, 30.0f);  // long gone
+    range_filter_push(&filter, 0, 30.0f);
+    range_filter_push(&filter, 1000, -1.0f);
+    range_filter_push(&filter, 1060, 60.0f);
+    range_filter_push(&filter, 1120, -1.0f);
+    range_filter_push(&filter, 1180, 61.0f);
+    TEST_ASSERT_FALSE(range_filter_estimate(&filter, 1200).valid);
+
+    range_filter_push(&filter, 1240, 60.5f);
+    RangeEstimate est = range_filter_estimate(&filter, 1250);
+    TEST_ASSERT_TRUE(est.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 60.5f, est.distanceCm);
+}
+
+void test_ring_keeps_only_latest_samples(void) {
+    for (int i = 0; i < RANGE_FILTER_CAPACITY; i++) range_filter_push(&filter, 1000, 200.0f);
+    for (int i = 0; i < RANGE_FILTER_CAPACITY; i++) range_filter_push(&filter, 1100, 50.0f);
+    RangeEstimate est = range_filter_estimate(&filter, 1100);
+    TEST_ASSERT_EQUAL_UINT8(RANGE_FILTER_CAPACITY, est.samplesUsed);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, est.distanceCm);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_samples_is_invalid);
+    RUN_TEST(test_steady_target_reports_median);
+    RUN_TEST(test_single_bad_echo_is_rejected);
+    RUN_TEST(test_approach_velocity);
+    RUN_TEST(test_missing_echoes_and_stale_samples_are_ignored);
+    RUN_TEST(test_ring_keeps_only_latest_samples);
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+/*
+ * Host-side tests for the offline queue's ring log, on a RAM backend.
+ *
+ * Run with: pio test -e native -f test_ring_log
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ring_log.h"
+
+static const uint32_t kCapacity = 4;
+static const uint32_t kSlot = 32;
+
+static uint8_t region[2 * RING_LOG_HEADER_BYTES + kCapacity * kSlot];
+static int writesUntilFailure;  // < 0: never fail
+
+static bool ram_read(void*, uint32_t offset, void* buf, size_t len) {
+    if (offset + len > sizeof(region)) return false;
+    memcpy(buf, region + offset, len);
+    return true;
+}
+
+static bool ram_write(void*, uint32_t offset, const void* buf, size_t len) {
+    if (offset + len > sizeof(region)) return false;
+    if (writesUntilFailure == 0) return false;
+    if (writesUntilFailure > 0) writesUntilFailure--;
+    memcpy(region + offset, buf, len);
+    return true;
+}
+
+static const RingLogIo io = {ram_read, ram_write, nullptr, nullptr};
+
+static void push_str(RingLog* log, const char* s) {
+    TEST_ASSERT_TRUE(ring_log_push(log, s, strlen(s)));
+}
+
+static void assert_peek(RingLog* log, uint32_t index, const char* expected) {
+    char buf[kSlot];
+    int len = ring_log_peek(log, index, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT((int)strlen(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, len);
+}
+
+void setUp(void) {
+    memset(region, 0xFF, sizeof(region));  // erased flash
+    writesUntilFailure = -1;
+}
+
+void tearDown(void) {}
+
+void test_region_size(void) {
+    TEST_ASSERT_EQUAL_UINT32(sizeof(region), ring_log_region_size(kCapacity, kSlot));
+}
+
+void test_push_peek_pop_in_order(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+    TEST_ASSERT_EQUAL_UINT32(0, ring_log_size(&log));
+
+    push_str(&log, "one");
+    push_str(&log, "two");
+    push_str(&log, "three");
+    TEST_ASSERT_EQUAL_UINT32(3, ring_log_size(&log));
+    assert_peek(&log, 0, "one");
+    assert_peek(&log, 2, "three");
+
+    TEST_ASSERT_TRUE(ring_log_pop(&log, 2));
+    TEST_ASSERT_EQUAL_UINT32(1, ring_log_size(&log));
+    assert_peek(&log, 0, "three");
+}
+
+void test_rejects_oversized_record_and_bad_index(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+
+    char big[kSlot] = {};
+    TEST_ASSERT_FALSE(ring_log_push(&log, big, kSlot - RING_LOG_RECORD_OVERHEAD + 1));
+    TEST_ASSERT_TRUE(ring_log_push(&log, big, kSlot - RING_LOG_RECORD_OVERHEAD));
+
+    char small[4];
+    TEST_ASSERT_EQUAL_INT(-2, ring_log_peek(&log, 0, small, sizeof(small)));
+    TEST_ASSERT_EQUAL_INT(-2, ring_log_peek(&log, 1, big, sizeof(big)));
+}
+
+void test_full_log_overwrites_oldest(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+
+    char s[8];
+    for (int i = 0; i < 10; i++) {
+        snprintf(s, sizeof(s), "e%d", i);
+        push_str(&log, s);
+    }
+    TEST_ASSERT_EQUAL_UINT32(kCapacity, ring_log_size(&log));
+    TEST_ASSERT_EQUAL_UINT32(6, log.dropped);
+    assert_peek(&log, 0, "e6");
+    assert_peek(&log, 3, "e9");
+}
+
+void test_reopen_restores_pointers(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+    const char* events[] = {"a", "b", "c", "d", "e", "f"};
+    for (const char* s : events) push_str(&log, s);
+    TEST_ASSERT_TRUE(ring_log_pop(&log, 1));
+
+    RingLog reopened;
+    TEST_ASSERT_TRUE(ring_log_open(&reopened, io, kCapacity, kSlot));
+    TEST_ASSERT_EQUAL_UINT32(3, ring_log_size(&reopened));
+    assert_peek(&reopened, 0, "d");
+    assert_peek(&reopened, 2, "f");
+}
+
+void test_torn_header_falls_back_to_previous_commit(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+    push_str(&log, "kept");
+    push_str(&log, "lost");
+
+    // Corrupt the copy holding the latest commit, as a torn write would
+    uint32_t latest = (log.generation % 2) * RING_LOG_HEADER_BYTES;
+    region[latest + 12] ^= 0x5A;
+
+    RingLog reopened;
+    TEST_ASSERT_TRUE(ring_log_open(&reopened, io, kCapacity, kSlot));
+    TEST_ASSERT_EQUAL_UINT32(1, ring_log_size(&reopened));
+    assert_peek(&reopened, 0, "kept");
+}
+
+void test_corrupt_record_is_reported(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+    push_str(&log, "good");
+    push_str(&log, "flip");
+
+    region[2 * RING_LOG_HEADER_BYTES + kSlot + RING_LOG_RECORD_OVERHEAD] ^= 0x01;
+    char buf[kSlot];
+    TEST_ASSERT_EQUAL_INT(-1, ring_log_peek(&log, 1, buf, sizeof(buf)));
+    assert_peek(&log, 0, "good");
+}
+
+void test_interrupted_push_is_not_visible(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+    push_str(&log, "first");
+
+    // Record written, power lost before the header commit
+    writesUntilFailure = 2;
+    TEST_ASSERT_FALSE(ring_log_push(&log, "second", 6));
+    writesUntilFailure = -1;
+
+    RingLog reopened;
+    TEST_ASSERT_TRUE(ring_log_open(&reopened, io, kCapacity, kSlot));
+    TEST_ASSERT_EQUAL_UINT32(1, ring_log_size(&reopened));
+    assert_peek(&reopened, 0, "first");
+}
+
+void test_geometry_change_reformats(void) {
+    RingLog log;
+    TEST_ASSERT_TRUE(ring_log_open(&log, io, kCapacity, kSlot));
+    push_str(&log, "old");
+
+    RingLog resized;
+    TEST_ASSERT_TRUE(ring_log_open(&resized, io, kCapacity / 2, kSlot));
+    TEST_ASSERT_EQUAL_UINT32(0, ring_log_size(&resized));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_region_size);
+    RUN_TEST(test_push_peek_pop_in_order);
+    RUN_TEST(test_rejects_oversized_record_and_bad_index);
+    RUN_TEST(test_full_log_overwrites_oldest);
+    RUN_TEST(test_reopen_restores_pointers);
+    RUN_TEST(test_torn_header_falls_back_to_previous_commit);
+    RUN_TEST(test_corrupt_record_is_reported);
+    RUN_TEST(test_interrupted_push_is_not_visible);
+    RUN_TEST(test_geometry_change_reformats);
+    return UNITY_END();
+}
@@ -77,7 +77,7 @@ public class DoorsControllerTests
         mockFile.Setup(f => f.OpenReadStream()).Returns(stream);
 
         var response = new AccessResponseDto(true, 1, "Buddy", 0.85, null, null);
-        _mockService.Setup(s => s.ProcessAccessRequestAsync(It.IsAny<Stream>(), null, null))
+        _mockService.Setup(s => s.ProcessAccessRequestAsync(It.IsAny<Stream>(), null, null, null, null, null))
             .ReturnsAsync(response);
 
         var result = await _controller.AccessRequest(mockFile.Object, null, null);
@@ -98,7 +98,7 @@ public class DoorsControllerTests
         mockFile.Setup(f => f.OpenReadStream()).Returns(stream);
 
         var response = new AccessResponseDto(true, 1, "Buddy", 0.85, null, "Exiting");
-        _mockService.Setup(s => s.ProcessAccessRequestAsync(It.IsAny<Stream>(), null, "inside"))
+        _mockService.Setup(s => s.ProcessAccessRequestAsync(It.IsAny<Stream>(), null, "inside", null, null, null))
             .ReturnsAsync(response);
 
         var result = await _controller.AccessRequest(mockFile.Object, null, "inside");
@@ -108,6 +108,43 @@ public class DoorsControllerTests
         Assert.Equal("Exiting", returned.Direction);
     }
 
+    [Fact]
+    public async Task AccessRequest_Combined_PassesDetectionToService()
+    {
+        var content = new byte[] { 0xFF, 0xD8, 0xFF, 0xE0 };
+        var mockFile = new Mock<IFormFile>();
+        mockFile.Setup(f => f.Length).Returns(content.Length);
+        mockFile.Setup(f => f.OpenReadStream()).Returns(new MemoryStream(content));
+
+        var expected = new DetectionMetadataDto(true, false, 0.12, 9, 48);
+        _mockService.Setup(s => s.ProcessAccessRequestAsync(It.IsAny<Stream>(), "key", "outside", "full", expected, null))
+            .ReturnsAsync(new AccessResponseDto(false, null, null, null, "Not a dog", "Entering"));
+
+        var result = await _controller.AccessRequest(mockFile.Object, "key", "outside", "full",
+            logApproach: true, dog: false, dogScore: 0.12, motionChangedBlocks: 9, motionTotalBlocks: 48);
+
+        var okResult = Assert.IsType<OkObjectResult>(result.Result);
+        Assert.Equal("Not a dog", Assert.IsType<AccessResponseDto>(okResult.Value).Reason);
+    }
+
+    [Fact]
+    public async Task AccessRequest_Thumbnail_PassesImageHashToService()
+    {
+        var content = new byte[] { 0xFF, 0xD8, 0xFF, 0xE0 };
+        var mockFile = new Mock<IFormFile>();
+        mockFile.Setup(f => f.Length).Returns(content.Length);
+        mockFile.Setup(f => f.OpenReadStream()).Returns(new MemoryStream(content));
+
+        _mockService.Setup(s => s.ProcessAccessRequestAsync(It.IsAny<Stream>(), "key", "outside", "thumbnail", null, "00FF00FF00FF00FF"))
+            .ReturnsAsync(new AccessResponseDto(true, 1, "Buddy", 0.95, null, "Entering"));
+
+        var result = await _controller.AccessRequest(mockFile.Object, "key", "outside", "thumbnail",
+            imageHash: "00FF00FF00FF00FF");
+
+        var okResult = Assert.IsType<OkObjectResult>(result.Result);
+        Assert.True(Assert.IsType<AccessResponseDto>(okResult.Value).Allowed);
+    }
+
     [Fact]
     public async Task FirmwareEvent_ValidEventType_ReturnsNoContent()
     {
@@ -129,4 +166,72 @@ public class DoorsControllerTests
 
         Assert.IsType<BadRequestObjectResult>(result);
     }
+
+    [Fact]
+    public async Task FirmwareEventBatch_Empty_ReturnsBadRequest()
+    {
+        var result = await _controller.FirmwareEventBatch(new FirmwareEventBatchDto(new List<FirmwareEventDto>()));
+
+        Assert.IsType<BadRequestObjectResult>(result.Result);
+    }
+
+    [Fact]
+    public async Task FirmwareEventBatch_ReturnsOkWithCounts()
+    {
+        var events = new List<FirmwareEventDto>
+        {
+            new("test-api-key", "PowerLost", null, 3.9, "k1"),
+            new("test-api-key", "PowerRestored", null, 4.1, "k2")
+        };
+        _mockService.Setup(s => s.RecordFirmwareEventBatchAsync(events))
+            .ReturnsAsync(new FirmwareEventBatchResultDto(1, 1, 0));
+
+        var result = await _controller.FirmwareEventBatch(new FirmwareEventBatchDto(events));
+
+        var okResult = Assert.IsType<OkObjectResult>(result.Result);
+        var returned = Assert.IsType<FirmwareEventBatchResultDto>(okResult.Value);
+        Assert.Equal(1, returned.Duplicates);
+    }
+
+    [Fact]
+    public async Task HashTable_ValidKey_ReturnsTable()
+    {
+        var table = new HashTableDto("0123456789ABCDEF", true, 19, null, null, 3600,
+            new List<HashTableEntryDto> { new(1, "Buddy", "786868C848C8C8C8", true) });
+        _mockService.Setup(s => s.GetHashTableAsync("test-api-key", null)).ReturnsAsync(table);
+
+        var result = await _controller.HashTable(new HashTableRequestDto("test-api-key", null));
+
+        var okResult = Assert.IsType<OkObjectResult>(result.Result);
+        Assert.Same(table, okResult.Value);
+    }
+
+    [Fact]
+    public async Task HashTable_UnknownKey_ReturnsUnauthorized()
+    {
+        _mockService.Setup(s => s.GetHashTableAsync("bad-key", "v1")).ReturnsAsync((HashTableDto?)null);
+
+        var result = await _controller.HashTable(new HashTableRequestDto("bad-key", "v1"));
+
+        Assert.IsType<UnauthorizedResult>(result.Result);
+    }
+
+    [Fact]
+    public async Task ApproachPhoto_WithCapturedAge_BackdatesEvent()
+    {
+        var content = new byte[] { 0xFF, 0xD8, 0xFF, 0xE0 };
+        var mockFile = new Mock<IFormFile>();
+        mockFile.Setup(f => f.Length).Returns(content.Length);
+        mockFile.Setup(f => f.OpenReadStream()).Returns(new MemoryStream(content));
+        DateTime? capturedAt = null;
+        _mockService.Setup(s => s.RecordApproachPhotoAsync(It.IsAny<Stream>(), "k", "outside", It.IsAny<DateTime?>()))
+            .Callback<Stream, string?, string?, DateTime?>((_, _, _, at) => capturedAt = at)
+            .Returns(Task.CompletedTask);
+
+        var result = await _controller.ApproachPhoto(mockFile.Object, "k", "outside", 60_000);
+
+        Assert.IsType<NoContentResult>(result);
+        Assert.NotNull(capturedAt);
+        Assert.InRange(DateTime.UtcNow - capturedAt!.Value, TimeSpan.FromSeconds(59), TimeSpan.FromSeconds(70));
+    }
 }
@@ -105,6 +105,28 @@ public class AnimalRecognitionServiceTests : IDisposable
         Assert.Equal(1.0, result.Confidence);
     }
 
+    [Fact]
+    public async Task IdentifyHashAsync_MatchesStoredHash()
+    {
+        var animal = new Animal { Name = "Buddy", UserId = UserId };
+        _db.Animals.Add(animal);
+        await _db.SaveChangesAsync();
+
+        _db.AnimalPhotos.Add(new AnimalPhoto
+        {
+            AnimalId = animal.Id,
+            FilePath = "/test/photo.jpg",
+            PHash = "ABCDEF1234567890"
+        });
+        await _db.SaveChangesAsync();
+
+        // One bit off, as from the door's own thumbnail
+        var result = await _service.IdentifyHashAsync("ABCDEF1234567891", UserId);
+
+        Assert.Equal(animal.Id, result.AnimalId);
+        Assert.Equal(1.0 - 1.0 / 64, result.Confidence);
+    }
+
     [Fact]
     public async Task IdentifyAsync_OtherUserPhotos_NotConsidered()
     {
@@ -133,4 +155,36 @@ public class AnimalRecognitionServiceTests : IDisposable
 
         Assert.Null(result.AnimalId);
     }
+
+    // Same pattern and expected value as the firmware's test_image_hash
+    // test_matches_api_test_vector, so the door's local matching and the API
+    // hash photos identically
+    [Fact]
+    public void ComputeDHash_MatchesFirmwareTestVector()
+    {
+        using var bitmap = new SKBitmap(40, 30);
+        for (int y = 0; y < 30; y++)
+        {
+            for (int x = 0; x < 40; x++)
+            {
+                bitmap.SetPixel(x, y, new SKColor(
+                    (byte)(x * 7 + y * 3),
+                    (byte)(x * x + y),
+                    (byte)((x ^ y) * 5)));
+            }
+        }
+        using var image = SKImage.FromBitmap(bitmap);
+        using var data = image.Encode(SKEncodedImageFormat.Png, 100);
+        using var stream = new MemoryStream(data.ToArray());
+
+        Assert.Equal("786868C848C8C8C8", AnimalRecognitionService.ComputeDHash(stream));
+    }
+
+    [Fact]
+    public void ComputeDHash_Undecodable_ReturnsZeroHash()
+    {
+        using var stream = new MemoryStream(new byte[] { 1, 2, 3, 4 });
+
+        Assert.Equal("0000000000000000", AnimalRecognitionService.ComputeDHash(stream));
+    }
 }
@@ -311,6 +311,101 @@ public class DoorServiceTests : IDisposable
         Assert.Null(logged.Direction);
     }
 
+    [Fact]
+    public async Task ProcessAccessRequestAsync_PayloadClass_RecordedWithEvent()
+    {
+        _db.DoorConfigurations.Add(CreateConfig());
+        await _db.SaveChangesAsync();
+
+        _mockRecognition.Setup(r => r.IdentifyAsync(It.IsAny<Stream>(), UserId))
+            .ReturnsAsync(new RecognitionResult(null, null, 0.3));
+
+        await _service.ProcessAccessRequestAsync(new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", "Thumbnail");
+        await _service.ProcessAccessRequestAsync(new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", "bogus");
+
+        var logged = await _db.DoorEvents.OrderBy(e => e.Id).ToListAsync();
+        Assert.Equal("thumbnail", logged[0].PayloadClass);
+        Assert.Null(logged[1].PayloadClass);
+    }
+
+    [Fact]
+    public async Task ProcessAccessRequestAsync_ThumbnailWithHash_MatchesOnHash()
+    {
+        var animal = new Animal { Name = "Buddy", IsAllowed = true, UserId = UserId };
+        _db.Animals.Add(animal);
+        _db.DoorConfigurations.Add(CreateConfig());
+        await _db.SaveChangesAsync();
+
+        _mockRecognition.Setup(r => r.IdentifyHashAsync("00FF00FF00FF00FF", UserId))
+            .ReturnsAsync(new RecognitionResult(animal.Id, "Buddy", 0.95));
+
+        var result = await _service.ProcessAccessRequestAsync(
+            new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", "thumbnail", null, "00FF00FF00FF00FF");
+
+        Assert.True(result.Allowed);
+        _mockRecognition.Verify(r => r.IdentifyAsync(It.IsAny<Stream>(), It.IsAny<int>()), Times.Never);
+    }
+
+    [Fact]
+    public async Task ProcessAccessRequestAsync_HashIgnoredUnlessThumbnailAndWellFormed()
+    {
+        _db.DoorConfigurations.Add(CreateConfig());
+        await _db.SaveChangesAsync();
+
+        _mockRecognition.Setup(r => r.IdentifyAsync(It.IsAny<Stream>(), UserId))
+            .ReturnsAsync(new RecognitionResult(null, null, 0.3));
+
+        await _service.ProcessAccessRequestAsync(new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", "full", null, "00FF00FF00FF00FF");
+        await _service.ProcessAccessRequestAsync(new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", "thumbnail", null, "not-a-hash");
+
+        _mockRecognition.Verify(r => r.IdentifyAsync(It.IsAny<Stream>(), UserId), Times.Exactly(2));
+        _mockRecognition.Verify(r => r.IdentifyHashAsync(It.IsAny<string>(), It.IsAny<int>()), Times.Never);
+    }
+
+    [Fact]
+    public async Task ProcessAccessRequestAsync_CombinedNotADog_LogsApproachOnly()
+    {
+        _db.DoorConfigurations.Add(CreateConfig());
+        await _db.SaveChangesAsync();
+
+        var detection = new DetectionMetadataDto(true, false, 0.12, 9, 48);
+        var result = await _service.ProcessAccessRequestAsync(
+            new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", "full", detection);
+
+        Assert.False(result.Allowed);
+        Assert.Equal("Not a dog", result.Reason);
+        var logged = Assert.Single(await _db.DoorEvents.ToListAsync());
+        Assert.Equal(DoorEventType.AnimalApproach, logged.EventType);
+        Assert.Equal("Dog score 0.12, motion 9/48 blocks", logged.Notes);
+        Assert.NotNull(logged.ImagePath);
+        _mockRecognition.Verify(r => r.IdentifyAsync(It.IsAny<Stream>(), It.IsAny<int>()), Times.Never);
+    }
+
+    [Fact]
+    public async Task ProcessAccessRequestAsync_CombinedDog_LogsApproachAndDecisionFromOneImage()
+    {
+        var animal = new Animal { Name = "Buddy", IsAllowed = true, UserId = UserId };
+        _db.Animals.Add(animal);
+        _db.DoorConfigurations.Add(CreateConfig());
+        await _db.SaveChangesAsync();
+
+        _mockRecognition.Setup(r => r.IdentifyAsync(It.IsAny<Stream>(), UserId))
+            .ReturnsAsync(new RecognitionResult(animal.Id, "Buddy", 0.85));
+
+        var detection = new DetectionMetadataDto(true, true, 0.91, null, null);
+        var result = await _service.ProcessAccessRequestAsync(
+            new MemoryStream(new byte[] { 0xFF, 0xD8 }), null, "outside", null, detection);
+
+        Assert.True(result.Allowed);
+        var logged = await _db.DoorEvents.OrderBy(e => e.Id).ToListAsync();
+        Assert.Equal(2, logged.Count);
+        Assert.Equal(DoorEventType.AnimalApproach, logged[0].EventType);
+        Assert.Equal("Dog score 0.91", logged[0].Notes);
+        Assert.Equal(DoorEventType.EntryGranted, logged[1].EventType);
+        Assert.Equal(logged[0].ImagePath, logged[1].ImagePath);
+        _mockRecognition.Verify(r => r.IdentifyAsync(It.IsAny<Stream>(), UserId), Times.Once);
+    }
+
     [Fact]
     public async Task GetAccessLogsAsync_WithDirectionFilter_FiltersEvents()
     {
@@ -326,4 +421,150 @@ public class DoorServiceTests : IDisposable
         Assert.Equal(2, entering.Count());
         Assert.Single(exiting);
     }
+
+    [Fact]
+    public async Task RecordFirmwareEventBatchAsync_RecordsAllValidEvents()
+    {
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+
+        var result = await _service.RecordFirmwareEventBatchAsync(new[]
+        {
+            new FirmwareEventDto("door-key", "PowerLost", "on battery", 3.9, "a1"),
+            new FirmwareEventDto("door-key", "DoorObstructed", null, null, "a2")
+        });
+
+        Assert.Equal(new FirmwareEventBatchResultDto(2, 0, 0), result);
+        Assert.Equal(2, await _db.DoorEvents.CountAsync(e => e.UserId == UserId));
+    }
+
+    [Fact]
+    public async Task RecordFirmwareEventBatchAsync_RetriedBatch_SkipsRecordedKeys()
+    {
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+        var batch = new[]
+        {
+            new FirmwareEventDto("door-key", "PowerLost", null, 3.9, "k1"),
+            new FirmwareEventDto("door-key", "PowerRestored", null, 4.1, "k2")
+        };
+
+        await _service.RecordFirmwareEventBatchAsync(batch.Take(1).ToList());
+        var result = await _service.RecordFirmwareEventBatchAsync(batch);
+
+        Assert.Equal(new FirmwareEventBatchResultDto(1, 1, 0), result);
+        Assert.Equal(2, await _db.DoorEvents.CountAsync());
+    }
+
+    [Fact]
+    public async Task RecordFirmwareEventBatchAsync_RepeatedKeyInBatch_RecordsOnce()
+    {
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+
+        var result = await _service.RecordFirmwareEventBatchAsync(new[]
+        {
+            new FirmwareEventDto("door-key", "BatteryLow", null, 3.4, "same"),
+            new FirmwareEventDto("door-key", "BatteryLow", null, 3.4, "same"),
+            new FirmwareEventDto("door-key", "BatteryLow", null, 3.3)
+        });
+
+        Assert.Equal(new FirmwareEventBatchResultDto(2, 1, 0), result);
+    }
+
+    [Fact]
+    public async Task RecordFirmwareEventBatchAsync_RejectsUnknownTypeAndApiKey()
+    {
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+
+        var result = await _service.RecordFirmwareEventBatchAsync(new[]
+        {
+            new FirmwareEventDto("door-key", "NotARealEvent", null, null, "x1"),
+            new FirmwareEventDto("wrong-key", "PowerLost", null, null, "x2"),
+            new FirmwareEventDto("door-key", "PowerLost", null, null, "x3")
+        });
+
+        Assert.Equal(new FirmwareEventBatchResultDto(1, 0, 2), result);
+    }
+
+    [Fact]
+    public async Task GetHashTableAsync_ReturnsPhotoHashesAndThresholds()
+    {
+        var buddy = new Animal { Name = "Buddy", IsAllowed = true, UserId = UserId };
+        var rex = new Animal { Name = "Rex", IsAllowed = false, UserId = UserId };
+        var other = new Animal { Name = "Other", IsAllowed = true, UserId = 99 };
+        _db.Animals.AddRange(buddy, rex, other);
+        var config = CreateConfig(apiKey: "door-key");
+        config.NightModeEnabled = true;
+        config.NightModeStart = new TimeOnly(22, 0);
+        config.NightModeEnd = new TimeOnly(6, 30);
+        _db.DoorConfigurations.Add(config);
+        await _db.SaveChangesAsync();
+        _db.AnimalPhotos.AddRange(
+            new AnimalPhoto { AnimalId = buddy.Id, FilePath = "a.jpg", PHash = "786868C848C8C8C8", PHashVersion = AnimalRecognitionService.DHashVersion },
+            new AnimalPhoto { AnimalId = rex.Id, FilePath = "b.jpg", PHash = "0000FFFF0000FFFF", PHashVersion = AnimalRecognitionService.DHashVersion },
+            new AnimalPhoto { AnimalId = buddy.Id, FilePath = "c.jpg", PHash = "1111111111111111", PHashVersion = 0 },
+            new AnimalPhoto { AnimalId = other.Id, FilePath = "d.jpg", PHash = "2222222222222222", PHashVersion = AnimalRecognitionService.DHashVersion });
+        await _db.SaveChangesAsync();
+
+        var table = await _service.GetHashTableAsync("door-key", null);
+
+        Assert.NotNull(table);
+        Assert.True(table.Enabled);
+        Assert.Equal(19, table.MaxDistance);  // confidence 0.7: 64 * 0.3 = 19.2 bits
+        Assert.Equal(22 * 3600, table.NightStartSec);
+        Assert.Equal(6 * 3600 + 1800, table.NightEndSec);
+        Assert.NotNull(table.Entries);
+        Assert.Equal(new[] { "Buddy", "Rex" }, table.Entries.Select(e => e.Name));
+        Assert.False(table.Entries[1].Allowed);
+    }
+
+    [Fact]
+    public async Task GetHashTableAsync_CurrentVersion_OmitsEntries()
+    {
+        var animal = new Animal { Name = "Buddy", IsAllowed = true, UserId = UserId };
+        _db.Animals.Add(animal);
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+        _db.AnimalPhotos.Add(new AnimalPhoto { AnimalId = animal.Id, FilePath = "a.jpg", PHash = "786868C848C8C8C8", PHashVersion = AnimalRecognitionService.DHashVersion });
+        await _db.SaveChangesAsync();
+
+        var first = await _service.GetHashTableAsync("door-key", null);
+        var second = await _service.GetHashTableAsync("door-key", first!.Version);
+
+        Assert.Equal(first.Version, second!.Version);
+        Assert.Null(second.Entries);
+
+        animal.IsAllowed = false;
+        await _db.SaveChangesAsync();
+        var third = await _service.GetHashTableAsync("door-key", first.Version);
+
+        Assert.NotEqual(first.Version, third!.Version);
+        Assert.NotNull(third.Entries);
+    }
+
+    [Fact]
+    public async Task GetHashTableAsync_InvalidApiKey_ReturnsNull()
+    {
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+
+        Assert.Null(await _service.GetHashTableAsync("wrong-key", null));
+    }
+
+    [Fact]
+    public async Task RecordApproachPhotoAsync_WithCapturedAt_UsesCaptureTime()
+    {
+        _db.DoorConfigurations.Add(CreateConfig(apiKey: "door-key"));
+        await _db.SaveChangesAsync();
+        var capturedAt = DateTime.UtcNow.AddMinutes(-30);
+
+        using var image = new MemoryStream(new byte[] { 0xFF, 0xD8, 0xFF, 0xE0 });
+        await _service.RecordApproachPhotoAsync(image, "door-key", "outside", capturedAt);
+
+        var doorEvent = await _db.DoorEvents.SingleAsync();
+        Assert.Equal(DoorEventType.AnimalApproach, doorEvent.EventType);
+        Assert.Equal(capturedAt, doorEvent.Timestamp);
+    }
 }
@@ -13,6 +13,8 @@ namespace DogDoor.Api.Controllers;
 [Route("api/v{version:apiVersion}/doors")]
 public class DoorsController : ControllerBase
 {
+    private const int MaxFirmwareEventBatchSize = 100;
+
     private readonly IDoorService _doorService;
 
     public DoorsController(IDoorService doorService)
@@ -22,18 +24,34 @@ public class DoorsController : ControllerBase
 
     private int CurrentUserId => int.Parse(User.FindFirstValue(ClaimTypes.NameIdentifier)!);
 
-    // No auth — ESP32 identifies via API key
+    // No auth — ESP32 identifies via API key. payloadClass reports which
+    // image derivative (full/reduced/thumbnail) the firmware sent for its link;
+    // a thumbnail also carries its dHash (imageHash), which is matched instead.
+    // A combined request also logs the approach (logApproach) and carries the
+    // on-device detector result and motion prefilter counts; a frame the
+    // detector rejected (dog=false) is only logged, not identified.
     [HttpPost("access-request")]
     public async Task<ActionResult<AccessResponseDto>> AccessRequest(
         IFormFile image,
         [FromForm] string? apiKey,
-        [FromForm] string? side)
+        [FromForm] string? side,
+        [FromForm] string? payloadClass = null,
+        [FromForm] bool logApproach = false,
+        [FromForm] bool? dog = null,
+        [FromForm] double? dogScore = null,
+        [FromForm] int? motionChangedBlocks = null,
+        [FromForm] int? motionTotalBlocks = null,
+        [FromForm] string? imageHash = null)
     {
         if (image.Length == 0)
             return BadRequest("Image is required");
 
+        DetectionMetadataDto? detection = logApproach || dog.HasValue || dogScore.HasValue
+            ? new DetectionMetadataDto(logApproach, dog, dogScore, motionChangedBlocks, motionTotalBlocks)
+            : null;
+
         using var stream = image.OpenReadStream();
-        var result = await _doorService.ProcessAccessRequestAsync(stream, apiKey, side);
+        var result = await _doorService.ProcessAccessRequestAsync(stream, apiKey, side, payloadClass, detection, imageHash);
         return Ok(result);
     }
 
@@ -54,21 +72,40 @@ public class DoorsController : ControllerBase
         return Ok(config);
     }
 
-    // No auth — ESP32 identifies via API key in form body
+    // No auth — ESP32 identifies via API key in form body. Photos spooled
+    // while the door was offline carry capturedAgeMs so the event is dated
+    // to the capture rather than the upload.
     [HttpPost("approach-photo")]
     public async Task<IActionResult> ApproachPhoto(
         IFormFile image,
         [FromForm] string? apiKey,
-        [FromForm] string? side)
+        [FromForm] string? side,
+        [FromForm] long? capturedAgeMs)
     {
         if (image.Length == 0)
             return BadRequest("Image is required");
 
+        DateTime? capturedAt = capturedAgeMs > 0
+            ? DateTime.UtcNow.AddMilliseconds(-capturedAgeMs.Value)
+            : null;
+
         using var stream = image.OpenReadStream();
-        await _doorService.RecordApproachPhotoAsync(stream, apiKey, side);
+        await _doorService.RecordApproachPhotoAsync(stream, apiKey, side, capturedAt);
         return NoContent();
     }
 
+    // No auth — ESP32 identifies via API key. Serves the enrolled photo hashes
+    // the firmware matches locally; entries are left out while the version the
+    // firmware sends is still current.
+    [HttpPost("hash-table")]
+    public async Task<ActionResult<HashTableDto>> HashTable([FromBody] HashTableRequestDto dto)
+    {
+        var table = await _doorService.GetHashTableAsync(dto.ApiKey, dto.Version);
+        if (table is null)
+            return Unauthorized();
+        return Ok(table);
+    }
+
     // No auth — ESP32 identifies via API key
     [HttpPost("firmware-event")]
     public async Task<IActionResult> FirmwareEvent([FromBody] FirmwareEventDto dto)
@@ -79,4 +116,20 @@ public class DoorsController : ControllerBase
         await _doorService.RecordFirmwareEventAsync(dto.ApiKey, eventType, dto.Notes, dto.BatteryVoltage);
         return NoContent();
     }
+
+    // No auth — each event carries the ESP32's API key. Used to drain the
+    // firmware's offline queue; events with an IdempotencyKey that was
+    // already recorded are skipped, so a retried batch is safe.
+    [HttpPost("firmware-events/batch")]
+    public async Task<ActionResult<FirmwareEventBatchResultDto>> FirmwareEventBatch(
+        [FromBody] FirmwareEventBatchDto dto)
+    {
+        if (dto.Events is null || dto.Events.Count == 0)
+            return BadRequest("At least one event is required");
+        if (dto.Events.Count > MaxFirmwareEventBatchSize)
+            return BadRequest($"A batch may contain at most {MaxFirmwareEventBatchSize} events");
+
+        var result = await _doorService.RecordFirmwareEventBatchAsync(dto.Events);
+        return Ok(result);
+    }
 }
@@ -5,11 +5,31 @@ public record AccessRequestDto(
     string? Side
 );
 
+// What the firmware already knows about a frame, sent with a combined access
+// request: one upload that also logs the approach (LogApproach), and that
+// the server doesn't try to identify when the detector saw no dog.
+public record DetectionMetadataDto(
+    bool LogApproach,
+    bool? Dog,
+    double? DogScore,
+    int? MotionChangedBlocks,
+    int? MotionTotalBlocks
+);
+
 public record FirmwareEventDto(
     string? ApiKey,
     string EventType,
     string? Notes,
-    double? BatteryVoltage);
+    double? BatteryVoltage,
+    string? IdempotencyKey = null);
+
+public record FirmwareEventBatchDto(List<FirmwareEventDto> Events);
+
+public record FirmwareEventBatchResultDto(
+    int Recorded,
+    int Duplicates,
+    int Rejected
+);
 
 public record AccessResponseDto(
     bool Allowed,
@@ -19,3 +39,27 @@ public record AccessResponseDto(
     string? Reason,
     string? Direction
 );
+
+public record HashTableRequestDto(
+    string? ApiKey,
+    string? Version
+);
+
+public record HashTableEntryDto(
+    int AnimalId,
+    string Name,
+    string Hash,
+    bool Allowed
+);
+
+// Entries is null when the firmware already holds Version. Night-mode times
+// are UTC seconds of day, null when night mode is off.
+public record HashTableDto(
+    string Version,
+    bool Enabled,
+    int MaxDistance,
+    int? NightStartSec,
+    int? NightEndSec,
+    int ServerTimeSec,
+    IReadOnlyList<HashTableEntryDto>? Entries
+);
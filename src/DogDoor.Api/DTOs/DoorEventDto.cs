@@ -12,5 +12,6 @@ public record DoorEventDto(
     DateTime Timestamp,
     string? Side,
     string? Direction,
-    string? ImageUrl
+    string? ImageUrl,
+    string? PayloadClass = null
 );
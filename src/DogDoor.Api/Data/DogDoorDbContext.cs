@@ -105,6 +105,7 @@ public class DogDoorDbContext : DbContext
             entity.HasIndex(e => e.Timestamp);
             entity.HasIndex(e => e.EventType);
             entity.HasIndex(e => e.Direction);
+            entity.HasIndex(e => new { e.UserId, e.IdempotencyKey }).IsUnique();
 
             entity.HasOne(e => e.User)
                 .WithMany()
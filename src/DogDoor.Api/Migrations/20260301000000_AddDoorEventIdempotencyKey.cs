@@ -0,0 +1,40 @@
+using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace DogDoor.Api.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddDoorEventIdempotencyKey : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            // Firmware-generated key so replayed offline events are recorded once
+            migrationBuilder.AddColumn<string>(
+                name: "IdempotencyKey",
+                table: "DoorEvents",
+                type: "character varying(64)",
+                maxLength: 64,
+                nullable: true);
+
+            migrationBuilder.CreateIndex(
+                name: "IX_DoorEvents_UserId_IdempotencyKey",
+                table: "DoorEvents",
+                columns: new[] { "UserId", "IdempotencyKey" },
+                unique: true);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropIndex(
+                name: "IX_DoorEvents_UserId_IdempotencyKey",
+                table: "DoorEvents");
+
+            migrationBuilder.DropColumn(
+                name: "IdempotencyKey",
+                table: "DoorEvents");
+        }
+    }
+}
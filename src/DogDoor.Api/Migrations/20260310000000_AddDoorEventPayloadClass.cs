@@ -0,0 +1,30 @@
+using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace DogDoor.Api.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddDoorEventPayloadClass : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            // Which image derivative (full/reduced/thumbnail) an access decision was made on
+            migrationBuilder.AddColumn<string>(
+                name: "PayloadClass",
+                table: "DoorEvents",
+                type: "character varying(16)",
+                maxLength: 16,
+                nullable: true);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropColumn(
+                name: "PayloadClass",
+                table: "DoorEvents");
+        }
+    }
+}
@@ -0,0 +1,31 @@
+using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace DogDoor.Api.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddAnimalPhotoPHashVersion : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            // dHash definition each photo's PHash was computed with; existing rows
+            // get 0 and are recomputed at startup
+            migrationBuilder.AddColumn<int>(
+                name: "PHashVersion",
+                table: "AnimalPhotos",
+                type: "integer",
+                nullable: false,
+                defaultValue: 0);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropColumn(
+                name: "PHashVersion",
+                table: "AnimalPhotos");
+        }
+    }
+}
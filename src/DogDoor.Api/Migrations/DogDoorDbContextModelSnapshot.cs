@@ -87,6 +87,9 @@ namespace DogDoor.Api.Migrations
                         .HasMaxLength(64)
                         .HasColumnType("character varying(64)");
 
+                    b.Property<int>("PHashVersion")
+                        .HasColumnType("integer");
+
                     b.Property<DateTime>("UploadedAt")
                         .HasColumnType("timestamp with time zone");
 
@@ -165,6 +168,10 @@ namespace DogDoor.Api.Migrations
                     b.Property<int>("EventType")
                         .HasColumnType("integer");
 
+                    b.Property<string>("IdempotencyKey")
+                        .HasMaxLength(64)
+                        .HasColumnType("character varying(64)");
+
                     b.Property<string>("ImagePath")
                         .HasMaxLength(500)
                         .HasColumnType("character varying(500)");
@@ -173,6 +180,10 @@ namespace DogDoor.Api.Migrations
                         .HasMaxLength(500)
                         .HasColumnType("character varying(500)");
 
+                    b.Property<string>("PayloadClass")
+                        .HasMaxLength(16)
+                        .HasColumnType("character varying(16)");
+
                     b.Property<int?>("Side")
                         .HasColumnType("integer");
 
@@ -194,6 +205,9 @@ namespace DogDoor.Api.Migrations
 
                     b.HasIndex("UserId");
 
+                    b.HasIndex("UserId", "IdempotencyKey")
+                        .IsUnique();
+
                     b.ToTable("DoorEvents");
                 });
 
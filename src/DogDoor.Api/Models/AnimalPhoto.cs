@@ -18,6 +18,9 @@ public class AnimalPhoto
     [MaxLength(64)]
     public string? PHash { get; set; }
 
+    // AnimalRecognitionService.DHashVersion the PHash was computed with
+    public int PHashVersion { get; set; }
+
     public long FileSize { get; set; }
 
     public DateTime UploadedAt { get; set; } = DateTime.UtcNow;
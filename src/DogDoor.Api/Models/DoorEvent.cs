@@ -59,6 +59,15 @@ public class DoorEvent
 
     public TransitDirection? Direction { get; set; }
 
+    // Set by firmware on queued events so a retried upload is recorded once
+    [MaxLength(64)]
+    public string? IdempotencyKey { get; set; }
+
+    // Image derivative the firmware chose for a slow link: "full", "reduced"
+    // or "thumbnail"; null for requests from older firmware
+    [MaxLength(16)]
+    public string? PayloadClass { get; set; }
+
     public User? User { get; set; }
     public Animal? Animal { get; set; }
 }
@@ -218,6 +218,12 @@ using (var scope = app.Services.CreateScope())
     }
     else
         await db.Database.EnsureCreatedAsync();
+
+    // Photos hashed under an older dHash definition can't be matched against
+    // new frames or the door's local hash table until they're recomputed
+    var rehashed = await scope.ServiceProvider.GetRequiredService<IPhotoService>().RehashOutdatedPhotosAsync();
+    if (rehashed > 0)
+        app.Logger.LogInformation("Recomputed the dHash of {Count} photos", rehashed);
 }
 
 app.Run();
@@ -13,10 +13,13 @@ public class AnimalRecognitionService : IAnimalRecognitionService
         _db = db;
     }
 
-    public async Task<RecognitionResult> IdentifyAsync(Stream imageStream, int userId)
+    public Task<RecognitionResult> IdentifyAsync(Stream imageStream, int userId)
     {
-        var imageHash = ComputeDHash(imageStream);
+        return IdentifyHashAsync(ComputeDHash(imageStream), userId);
+    }
 
+    public async Task<RecognitionResult> IdentifyHashAsync(string imageHash, int userId)
+    {
         var photos = await _db.AnimalPhotos
             .Include(p => p.Animal)
             .Where(p => p.PHash != null && p.Animal.UserId == userId)
@@ -48,34 +51,85 @@ public class AnimalRecognitionService : IAnimalRecognitionService
     }
 
     /// <summary>
-    /// Compute a difference hash (dHash): resize to 9x8 grayscale, compare adjacent
-    /// horizontal pixels to produce a 64-bit hash. Robust to scaling, compression,
-    /// and minor color/brightness changes.
+    /// Version of the <see cref="ComputeDHash"/> definition. Photo hashes stored
+    /// under an older version are recomputed at startup.
+    /// </summary>
+    public const int DHashVersion = 1;
+
+    /// <summary>
+    /// Compute a difference hash (dHash): average the luma over a 9x8 grid of cells,
+    /// then compare horizontally adjacent cells to produce a 64-bit hash. Robust to
+    /// scaling, compression, and minor color/brightness changes.
+    ///
+    /// This is the same definition as the firmware's image_hash.h, so the door can
+    /// match its own frames against the hashes stored here: luma is
+    /// (77R + 150G + 29B) >> 8, cell edges are floor(i * size / cells), each cell is
+    /// the rounded mean of its pixels, and bit y*8+x is set when cell (x, y) is
+    /// brighter than cell (x+1, y).
     /// </summary>
     public static string ComputeDHash(Stream stream)
     {
-        using var bitmap = SKBitmap.Decode(stream);
-        if (bitmap is null) return new string('0', 16);
+        using var codec = SKCodec.Create(stream);
+        if (codec is null) return new string('0', 16);
+
+        var info = new SKImageInfo(codec.Info.Width, codec.Info.Height, SKColorType.Rgba8888, SKAlphaType.Unpremul);
+        using var bitmap = SKBitmap.Decode(codec, info);
+        if (bitmap is null || bitmap.Width < 9 || bitmap.Height < 8) return new string('0', 16);
+
+        return ComputeDHash(bitmap).ToString("X16");
+    }
+
+    private static ulong ComputeDHash(SKBitmap rgba)
+    {
+        const int cellsW = 9, cellsH = 8;
+        int width = rgba.Width, height = rgba.Height;
+        static int Edge(int i, int size, int cells) => (int)((long)i * size / cells);
+
+        var cellOfColumn = new int[width];
+        for (int cx = 0; cx < cellsW; cx++)
+            for (int x = Edge(cx, width, cellsW); x < Edge(cx + 1, width, cellsW); x++)
+                cellOfColumn[x] = cx;
+
+        var sums = new long[cellsH, cellsW];
+        var pixels = rgba.GetPixelSpan();
+        int rowBytes = rgba.RowBytes;
+        for (int cy = 0; cy < cellsH; cy++)
+        {
+            for (int y = Edge(cy, height, cellsH); y < Edge(cy + 1, height, cellsH); y++)
+            {
+                var row = pixels.Slice(y * rowBytes, width * 4);
+                for (int x = 0; x < width; x++)
+                {
+                    int luma = (77 * row[4 * x] + 150 * row[4 * x + 1] + 29 * row[4 * x + 2]) >> 8;
+                    sums[cy, cellOfColumn[x]] += luma;
+                }
+            }
+        }
 
-        // Resize to 9x8 (9 wide so we get 8 horizontal differences per row)
-        using var resized = bitmap.Resize(new SKImageInfo(9, 8, SKColorType.Gray8), SKFilterQuality.Low);
-        if (resized is null) return new string('0', 16);
+        var cells = new long[cellsH, cellsW];
+        for (int cy = 0; cy < cellsH; cy++)
+        {
+            int rows = Edge(cy + 1, height, cellsH) - Edge(cy, height, cellsH);
+            for (int cx = 0; cx < cellsW; cx++)
+            {
+                long n = (long)rows * (Edge(cx + 1, width, cellsW) - Edge(cx, width, cellsW));
+                cells[cy, cx] = (sums[cy, cx] + n / 2) / n;
+            }
+        }
 
         ulong hash = 0;
         int bit = 0;
-        for (int y = 0; y < 8; y++)
+        for (int y = 0; y < cellsH; y++)
         {
-            for (int x = 0; x < 8; x++)
+            for (int x = 0; x < cellsW - 1; x++)
             {
-                var left = resized.GetPixel(x, y).Red;
-                var right = resized.GetPixel(x + 1, y).Red;
-                if (left > right)
+                if (cells[y, x] > cells[y, x + 1])
                     hash |= 1UL << bit;
                 bit++;
             }
         }
 
-        return hash.ToString("X16");
+        return hash;
     }
 
     /// <summary>
@@ -1,3 +1,5 @@
+using System.Security.Cryptography;
+using System.Text;
 using AutoMapper;
 using DogDoor.Api.Data;
 using DogDoor.Api.DTOs;
@@ -31,8 +33,22 @@ public class DoorService : IDoorService
         _notificationService = notificationService;
     }
 
-    public async Task<AccessResponseDto> ProcessAccessRequestAsync(Stream imageStream, string? apiKey, string? side = null)
+    public async Task<AccessResponseDto> ProcessAccessRequestAsync(Stream imageStream, string? apiKey, string? side = null, string? payloadClass = null, DetectionMetadataDto? detection = null, string? imageHash = null)
     {
+        // On slow links the firmware sends a reduced JPEG or a grayscale
+        // thumbnail instead of the full frame; the dHash below works on any
+        // of them, so only the class is recorded with the event
+        string? payload = payloadClass?.ToLowerInvariant();
+        if (payload is not ("full" or "reduced" or "thumbnail"))
+            payload = null;
+
+        // A thumbnail comes with the dHash of the grayscale image it was
+        // encoded from, which survives better than one recomputed from the
+        // small, low-quality JPEG; it is used for the match when well formed
+        if (payload != "thumbnail" || imageHash is not { Length: 16 } ||
+            !ulong.TryParse(imageHash, System.Globalization.NumberStyles.HexNumber, null, out _))
+            imageHash = null;
+
         // Determine side and direction from the requesting camera
         DoorSide? doorSide = side?.ToLowerInvariant() switch
         {
@@ -68,6 +84,22 @@ public class DoorService : IDoorService
 
         int userId = doorConfig.UserId;
 
+        // A combined request stands in for the approach-photo upload: the one
+        // image is logged as the approach, then identified unless the
+        // firmware's detector rejected it
+        string? imagePath = null;
+        string? imageRelativePath = null;
+        if (detection is { LogApproach: true })
+        {
+            (imagePath, imageRelativePath) = await SaveEventImageAsync(imageStream);
+            await LogEventAsync(userId, null, DoorEventType.AnimalApproach, imageRelativePath, null, DescribeDetection(detection), doorSide, null, payloadClass: payload);
+            await _notificationService.NotifyAsync(userId, DoorEventType.AnimalApproach, null, doorSide, null);
+        }
+        if (detection is { Dog: false })
+        {
+            return new AccessResponseDto(false, null, null, null, "Not a dog", directionString);
+        }
+
         // Check if door is enabled
         if (!doorConfig.IsEnabled)
         {
@@ -92,22 +124,20 @@ public class DoorService : IDoorService
             }
         }
 
-        // Save incoming image (relative path stored in DB; served via authenticated endpoint)
-        var basePath = _config.GetValue<string>("PhotoStorage:BasePath") ?? "uploads";
-        var eventImagesDir = Path.Combine(_env.ContentRootPath, basePath, "events");
-        Directory.CreateDirectory(eventImagesDir);
-        var fileName = $"{Guid.NewGuid()}.jpg";
-        var imagePath = Path.Combine(eventImagesDir, fileName);
-        var imageRelativePath = $"events/{fileName}";
+        if (imagePath is null)
+            (imagePath, imageRelativePath) = await SaveEventImageAsync(imageStream);
 
-        using (var fs = new FileStream(imagePath, FileMode.Create))
+        RecognitionResult result;
+        if (imageHash is not null)
         {
-            await imageStream.CopyToAsync(fs);
+            result = await _recognition.IdentifyHashAsync(imageHash, userId);
+        }
+        else
+        {
+            // Reset stream for recognition
+            using var recognitionStream = new FileStream(imagePath, FileMode.Open, FileAccess.Read);
+            result = await _recognition.IdentifyAsync(recognitionStream, userId);
         }
-
-        // Reset stream for recognition
-        using var recognitionStream = new FileStream(imagePath, FileMode.Open, FileAccess.Read);
-        var result = await _recognition.IdentifyAsync(recognitionStream, userId);
 
         var threshold = doorConfig.MinConfidenceThreshold;
 
@@ -122,7 +152,7 @@ public class DoorService : IDoorService
                     TransitDirection.Entering => DoorEventType.EntryGranted,
                     _ => DoorEventType.AccessGranted
                 };
-                await LogEventAsync(userId, animal.Id, grantedType, imageRelativePath, result.Confidence, null, doorSide, direction);
+                await LogEventAsync(userId, animal.Id, grantedType, imageRelativePath, result.Confidence, null, doorSide, direction, payloadClass: payload);
                 await _notificationService.NotifyAsync(userId, grantedType, animal.Name, doorSide, null);
                 return new AccessResponseDto(true, animal.Id, animal.Name, result.Confidence, null, directionString);
             }
@@ -133,12 +163,12 @@ public class DoorService : IDoorService
                 TransitDirection.Entering => DoorEventType.EntryDenied,
                 _ => DoorEventType.AccessDenied
             };
-            await LogEventAsync(userId, result.AnimalId, deniedType, imageRelativePath, result.Confidence, "Animal not allowed", doorSide, direction);
+            await LogEventAsync(userId, result.AnimalId, deniedType, imageRelativePath, result.Confidence, "Animal not allowed", doorSide, direction, payloadClass: payload);
             await _notificationService.NotifyAsync(userId, deniedType, result.AnimalName, doorSide, "Animal not allowed");
             return new AccessResponseDto(false, result.AnimalId, result.AnimalName, result.Confidence, "Animal not allowed", directionString);
         }
 
-        await LogEventAsync(userId, null, DoorEventType.UnknownAnimal, imageRelativePath, result.Confidence, "Animal not recognized", doorSide, direction);
+        await LogEventAsync(userId, null, DoorEventType.UnknownAnimal, imageRelativePath, result.Confidence, "Animal not recognized", doorSide, direction, payloadClass: payload);
         await _notificationService.NotifyAsync(userId, DoorEventType.UnknownAnimal, null, doorSide, "Animal not recognized");
         return new AccessResponseDto(false, null, null, result.Confidence, "Animal not recognized", directionString);
     }
@@ -214,7 +244,7 @@ public class DoorService : IDoorService
         return doorEvent is null ? null : _mapper.Map<DoorEventDto>(doorEvent);
     }
 
-    public async Task RecordApproachPhotoAsync(Stream imageStream, string? apiKey, string? side)
+    public async Task RecordApproachPhotoAsync(Stream imageStream, string? apiKey, string? side, DateTime? capturedAt = null)
     {
         DoorConfiguration? doorConfig = apiKey != null
             ? await _db.DoorConfigurations.FirstOrDefaultAsync(c => c.ApiKey == apiKey)
@@ -241,15 +271,13 @@ public class DoorService : IDoorService
             await imageStream.CopyToAsync(fs);
         }
 
-        await LogEventAsync(doorConfig.UserId, null, DoorEventType.AnimalApproach, relativePath, null, null, doorSide, null);
+        await LogEventAsync(doorConfig.UserId, null, DoorEventType.AnimalApproach, relativePath, null, null, doorSide, null, capturedAt);
         await _notificationService.NotifyAsync(doorConfig.UserId, DoorEventType.AnimalApproach, null, doorSide, null);
     }
 
     public async Task RecordFirmwareEventAsync(string? apiKey, DoorEventType eventType, string? notes, double? batteryVoltage)
     {
-        DoorConfiguration? doorConfig = apiKey != null
-            ? await _db.DoorConfigurations.FirstOrDefaultAsync(c => c.ApiKey == apiKey)
-            : await _db.DoorConfigurations.FirstOrDefaultAsync(c => c.ApiKey == null);
+        DoorConfiguration? doorConfig = await FindFirmwareConfigAsync(apiKey);
 
         if (doorConfig is null) return;
 
@@ -258,6 +286,162 @@ public class DoorService : IDoorService
         await _notificationService.NotifyAsync(userId, eventType, null, null, notes);
     }
 
+    public async Task<FirmwareEventBatchResultDto> RecordFirmwareEventBatchAsync(IReadOnlyList<FirmwareEventDto> events)
+    {
+        int duplicates = 0, rejected = 0;
+        var configs = new Dictionary<string, DoorConfiguration?>();
+        var accepted = new List<DoorEvent>();
+
+        foreach (var dto in events)
+        {
+            if (!Enum.TryParse<DoorEventType>(dto.EventType, true, out var eventType))
+            {
+                rejected++;
+                continue;
+            }
+
+            var configKey = dto.ApiKey ?? string.Empty;
+            if (!configs.TryGetValue(configKey, out var doorConfig))
+            {
+                doorConfig = await FindFirmwareConfigAsync(dto.ApiKey);
+                configs[configKey] = doorConfig;
+            }
+            if (doorConfig is null)
+            {
+                rejected++;
+                continue;
+            }
+
+            accepted.Add(new DoorEvent
+            {
+                UserId = doorConfig.UserId,
+                EventType = eventType,
+                ConfidenceScore = dto.BatteryVoltage,
+                Notes = dto.Notes,
+                IdempotencyKey = dto.IdempotencyKey
+            });
+        }
+
+        // Drop events whose key was already recorded (a retried batch) or
+        // repeats within this batch
+        var keysByUser = accepted
+            .Where(e => e.IdempotencyKey != null)
+            .GroupBy(e => e.UserId);
+        var seen = new HashSet<(int, string)>();
+        foreach (var group in keysByUser)
+        {
+            var keys = group.Select(e => e.IdempotencyKey!).Distinct().ToList();
+            var existing = await _db.DoorEvents
+                .Where(e => e.UserId == group.Key && e.IdempotencyKey != null && keys.Contains(e.IdempotencyKey))
+                .Select(e => e.IdempotencyKey!)
+                .ToListAsync();
+            foreach (var key in existing)
+                seen.Add((group.Key, key));
+        }
+
+        var recorded = new List<DoorEvent>();
+        foreach (var doorEvent in accepted)
+        {
+            if (doorEvent.IdempotencyKey != null && !seen.Add((doorEvent.UserId, doorEvent.IdempotencyKey)))
+            {
+                duplicates++;
+                continue;
+            }
+            recorded.Add(doorEvent);
+        }
+
+        _db.DoorEvents.AddRange(recorded);
+        await _db.SaveChangesAsync();
+
+        foreach (var doorEvent in recorded)
+            await _notificationService.NotifyAsync(doorEvent.UserId, doorEvent.EventType, null, null, doorEvent.Notes);
+
+        return new FirmwareEventBatchResultDto(recorded.Count, duplicates, rejected);
+    }
+
+    // Save an access-request image (relative path stored in DB; served via authenticated endpoint)
+    private async Task<(string FullPath, string RelativePath)> SaveEventImageAsync(Stream imageStream)
+    {
+        var basePath = _config.GetValue<string>("PhotoStorage:BasePath") ?? "uploads";
+        var eventImagesDir = Path.Combine(_env.ContentRootPath, basePath, "events");
+        Directory.CreateDirectory(eventImagesDir);
+        var fileName = $"{Guid.NewGuid()}.jpg";
+        var fullPath = Path.Combine(eventImagesDir, fileName);
+
+        using (var fs = new FileStream(fullPath, FileMode.Create))
+        {
+            await imageStream.CopyToAsync(fs);
+        }
+        return (fullPath, $"events/{fileName}");
+    }
+
+    private static string? DescribeDetection(DetectionMetadataDto detection)
+    {
+        var parts = new List<string>();
+        if (detection.DogScore is { } score)
+            parts.Add(FormattableString.Invariant($"Dog score {score:0.00}"));
+        if (detection.MotionChangedBlocks is { } changed && detection.MotionTotalBlocks is { } total)
+            parts.Add($"motion {changed}/{total} blocks");
+        return parts.Count > 0 ? string.Join(", ", parts) : null;
+    }
+
+    /// <summary>
+    /// The enrolled photo hashes the firmware matches frames against locally,
+    /// with everything else ProcessAccessRequestAsync would check first: the
+    /// enabled flag, night mode, and the thresholds, folded into a maximum
+    /// Hamming distance. Returns null for an unknown API key.
+    /// </summary>
+    public async Task<HashTableDto?> GetHashTableAsync(string? apiKey, string? version)
+    {
+        DoorConfiguration? doorConfig = await FindFirmwareConfigAsync(apiKey);
+        if (doorConfig is null) return null;
+
+        var entries = await _db.AnimalPhotos
+            .Where(p => p.PHash != null
+                && p.PHashVersion == AnimalRecognitionService.DHashVersion
+                && p.Animal.UserId == doorConfig.UserId)
+            .OrderBy(p => p.Id)
+            .Select(p => new HashTableEntryDto(p.AnimalId, p.Animal.Name, p.PHash!, p.Animal.IsAllowed))
+            .ToListAsync();
+
+        // IdentifyAsync needs a similarity of 0.6 and access needs the confidence
+        // threshold on top; similarity is 1 - distance / 64
+        var minSimilarity = Math.Max(0.6, doorConfig.MinConfidenceThreshold);
+        var maxDistance = (int)Math.Floor((1 - minSimilarity) * 64 + 1e-9);
+        var enabled = doorConfig.IsEnabled && maxDistance >= 0;
+        maxDistance = Math.Max(0, maxDistance);
+
+        int? nightStart = null, nightEnd = null;
+        if (doorConfig is { NightModeEnabled: true, NightModeStart: not null, NightModeEnd: not null })
+        {
+            nightStart = (int)doorConfig.NightModeStart.Value.ToTimeSpan().TotalSeconds;
+            nightEnd = (int)doorConfig.NightModeEnd.Value.ToTimeSpan().TotalSeconds;
+        }
+
+        var canonical = new StringBuilder()
+            .Append($"{enabled}|{maxDistance}|{nightStart}|{nightEnd}");
+        foreach (var e in entries)
+            canonical.Append($"\n{e.AnimalId}|{e.Hash}|{e.Allowed}|{e.Name}");
+        var digest = SHA256.HashData(Encoding.UTF8.GetBytes(canonical.ToString()));
+        var currentVersion = Convert.ToHexString(digest, 0, 8);
+
+        return new HashTableDto(
+            currentVersion,
+            enabled,
+            maxDistance,
+            nightStart,
+            nightEnd,
+            (int)DateTime.UtcNow.TimeOfDay.TotalSeconds,
+            version == currentVersion ? null : entries);
+    }
+
+    private Task<DoorConfiguration?> FindFirmwareConfigAsync(string? apiKey)
+    {
+        return apiKey != null
+            ? _db.DoorConfigurations.FirstOrDefaultAsync(c => c.ApiKey == apiKey)
+            : _db.DoorConfigurations.FirstOrDefaultAsync(c => c.ApiKey == null);
+    }
+
     public async Task<(Stream Stream, string ContentType)?> GetEventImageAsync(int eventId, int userId)
     {
         var doorEvent = await _db.DoorEvents
@@ -279,7 +463,7 @@ public class DoorService : IDoorService
         return (stream, contentType);
     }
 
-    private async Task LogEventAsync(int userId, int? animalId, DoorEventType eventType, string? imagePath, double? confidence, string? notes, DoorSide? side = null, TransitDirection? direction = null)
+    private async Task LogEventAsync(int userId, int? animalId, DoorEventType eventType, string? imagePath, double? confidence, string? notes, DoorSide? side = null, TransitDirection? direction = null, DateTime? timestamp = null, string? payloadClass = null)
     {
         var doorEvent = new DoorEvent
         {
@@ -290,7 +474,9 @@ public class DoorService : IDoorService
             ConfidenceScore = confidence,
             Notes = notes,
             Side = side,
-            Direction = direction
+            Direction = direction,
+            Timestamp = timestamp ?? DateTime.UtcNow,
+            PayloadClass = payloadClass
         };
 
         _db.DoorEvents.Add(doorEvent);
@@ -5,4 +5,8 @@ public record RecognitionResult(int? AnimalId, string? AnimalName, double Confid
 public interface IAnimalRecognitionService
 {
     Task<RecognitionResult> IdentifyAsync(Stream imageStream, int userId);
+
+    // Same, from a dHash already computed (16 hex digits), such as the one
+    // the firmware sends with a thumbnail
+    Task<RecognitionResult> IdentifyHashAsync(string imageHash, int userId);
 }
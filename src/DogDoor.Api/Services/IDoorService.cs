@@ -5,12 +5,14 @@ namespace DogDoor.Api.Services;
 
 public interface IDoorService
 {
-    Task<AccessResponseDto> ProcessAccessRequestAsync(Stream imageStream, string? apiKey, string? side = null);
+    Task<AccessResponseDto> ProcessAccessRequestAsync(Stream imageStream, string? apiKey, string? side = null, string? payloadClass = null, DetectionMetadataDto? detection = null, string? imageHash = null);
     Task<DoorConfigurationDto> GetConfigurationAsync(int userId);
     Task<DoorConfigurationDto> UpdateConfigurationAsync(UpdateDoorConfigurationDto dto, int userId);
     Task<IEnumerable<DoorEventDto>> GetAccessLogsAsync(int page, int pageSize, string? eventType, string? direction, int userId);
     Task<DoorEventDto?> GetAccessLogAsync(int id, int userId);
     Task RecordFirmwareEventAsync(string? apiKey, DoorEventType eventType, string? notes, double? batteryVoltage);
-    Task RecordApproachPhotoAsync(Stream imageStream, string? apiKey, string? side);
+    Task<FirmwareEventBatchResultDto> RecordFirmwareEventBatchAsync(IReadOnlyList<FirmwareEventDto> events);
+    Task RecordApproachPhotoAsync(Stream imageStream, string? apiKey, string? side, DateTime? capturedAt = null);
+    Task<HashTableDto?> GetHashTableAsync(string? apiKey, string? version);
     Task<(Stream Stream, string ContentType)?> GetEventImageAsync(int eventId, int userId);
 }
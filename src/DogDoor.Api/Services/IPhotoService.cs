@@ -8,4 +8,5 @@ public interface IPhotoService
     Task<PhotoDto?> UploadAsync(int animalId, Stream fileStream, string fileName, int userId);
     Task<(Stream? Stream, string? ContentType)?> GetFileAsync(int photoId, int userId);
     Task<bool> DeleteAsync(int photoId, int userId);
+    Task<int> RehashOutdatedPhotosAsync();
 }
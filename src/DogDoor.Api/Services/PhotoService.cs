@@ -65,6 +65,7 @@ public class PhotoService : IPhotoService
             FilePath = relativePath,
             FileName = fileName,
             PHash = pHash,
+            PHashVersion = AnimalRecognitionService.DHashVersion,
             FileSize = fileInfo.Length
         };
 
@@ -116,6 +117,30 @@ public class PhotoService : IPhotoService
         return true;
     }
 
+    /// <summary>
+    /// Recompute the PHash of photos hashed under an older dHash definition, so
+    /// they can be compared with new frames (and with the door's local hashes).
+    /// A photo whose file is gone loses its hash rather than keeping a stale one.
+    /// Returns the number of photos updated.
+    /// </summary>
+    public async Task<int> RehashOutdatedPhotosAsync()
+    {
+        var photos = await _db.AnimalPhotos
+            .Where(p => p.PHashVersion < AnimalRecognitionService.DHashVersion)
+            .ToListAsync();
+
+        foreach (var photo in photos)
+        {
+            var fullPath = ResolveFullPath(photo.FilePath);
+            photo.PHash = File.Exists(fullPath) ? ComputePHash(fullPath) : null;
+            photo.PHashVersion = AnimalRecognitionService.DHashVersion;
+        }
+
+        if (photos.Count > 0)
+            await _db.SaveChangesAsync();
+        return photos.Count;
+    }
+
     private string ResolveFullPath(string storedPath)
     {
         // If the stored path is already absolute (legacy data), return as-is
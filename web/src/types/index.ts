@@ -39,6 +39,7 @@ export interface DoorEvent {
   side: string | null;
   direction: string | null;
   imageUrl: string | null;
+  payloadClass?: string | null;
 }
 
 export interface DoorConfiguration {